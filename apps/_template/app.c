@@ -12,6 +12,9 @@
 /* App state structure */
 typedef struct {
     bool running;
+    FuriMessageQueue* event_queue;
+    volatile bool repeat_queued;    /* A Repeat event is waiting in event_queue */
+    volatile uint32_t input_dropped; /* Events lost to a full queue */
     // TODO: Add your state variables here
 } AppState;
 
@@ -30,10 +33,23 @@ static void draw_callback(Canvas* canvas, void* ctx) {
     canvas_draw_str_aligned(canvas, 64, 32, AlignCenter, AlignCenter, "Press Back to exit");
 }
 
-/* Input callback - called when buttons are pressed */
+/* Input callback - called when buttons are pressed
+ * Runs on the input thread, so it must never block: a held key's Repeat
+ * events are merged while one is still queued, and a full queue drops the
+ * event (counted) instead of stalling the whole UI. */
 static void input_callback(InputEvent* input_event, void* ctx) {
-    FuriMessageQueue* event_queue = ctx;
-    furi_message_queue_put(event_queue, input_event, FuriWaitForever);
+    AppState* state = ctx;
+    bool repeat = (input_event->type == InputTypeRepeat);
+
+    if(repeat) {
+        if(state->repeat_queued) return;
+        state->repeat_queued = true;
+    }
+
+    if(furi_message_queue_put(state->event_queue, input_event, 0) != FuriStatusOk) {
+        state->input_dropped++;
+        if(repeat) state->repeat_queued = false;
+    }
 }
 
 /* Main app entry point */
@@ -43,14 +59,17 @@ int32_t app_template_main(void* p) {  // TODO: Rename to match entry_point in ap
     /* Allocate state */
     AppState* state = malloc(sizeof(AppState));
     state->running = true;
+    state->repeat_queued = false;
+    state->input_dropped = 0;
 
     /* Create message queue for input events */
-    FuriMessageQueue* event_queue = furi_message_queue_alloc(8, sizeof(InputEvent));
+    FuriMessageQueue* event_queue = furi_message_queue_alloc(16, sizeof(InputEvent));
+    state->event_queue = event_queue;
 
     /* Configure view port */
     ViewPort* view_port = view_port_alloc();
     view_port_draw_callback_set(view_port, draw_callback, state);
-    view_port_input_callback_set(view_port, input_callback, event_queue);
+    view_port_input_callback_set(view_port, input_callback, state);
 
     /* Register view port in GUI */
     Gui* gui = furi_record_open(RECORD_GUI);
@@ -60,6 +79,7 @@ int32_t app_template_main(void* p) {  // TODO: Rename to match entry_point in ap
     InputEvent event;
     while(state->running) {
         if(furi_message_queue_get(event_queue, &event, 100) == FuriStatusOk) {
+            if(event.type == InputTypeRepeat) state->repeat_queued = false;
             if(event.type == InputTypePress || event.type == InputTypeRepeat) {
                 switch(event.key) {
                 case InputKeyBack:
@@ -90,6 +110,14 @@ int32_t app_template_main(void* p) {  // TODO: Rename to match entry_point in ap
         view_port_update(view_port);
     }
 
+    /* Stack headroom: size stack_size in application.fam from this */
+    FURI_LOG_I(
+        "AppTemplate",  // TODO: Rename to your app's log tag
+        "Stack never used: %lu bytes, heap free: %lu (min %lu)",
+        (unsigned long)furi_thread_get_stack_space(furi_thread_get_current_id()),
+        (unsigned long)memmgr_get_free_heap(),
+        (unsigned long)memmgr_get_minimum_free_heap());
+
     /* Cleanup */
     gui_remove_view_port(gui, view_port);
     view_port_free(view_port);
@@ -6,6 +6,7 @@
  * - Large 24x48 pixel custom digits
  * - Adjustable brightness (0-100% in 10% steps)
  * - Always-on backlight with manual brightness control
+ * - Daily alarms from apps_data/big_clock/alarms.txt
  *
  * @author Eris Margeta (@Eris-Margeta)
  * @license MIT
@@ -14,12 +15,23 @@
  * SPDX-License-Identifier: MIT
  */
 
+/* ============================================================================
+ * DEBUG OPTIONS
+ * Uncomment DEBUG_INPUT_RECORD to record every input event to SD in the
+ * session format replayed by tools/host/replay.c.
+ * Uncomment DEBUG_MEMORY to show free heap and stack headroom under the clock.
+ * ============================================================================ */
+/* #define DEBUG_INPUT_RECORD 1 */
+/* #define DEBUG_MEMORY 1 */
+
 #include <furi.h>
 #include <furi_hal.h>
 #include <gui/gui.h>
 #include <input/input.h>
 #include <notification/notification.h>
 #include <notification/notification_messages.h>
+#include <storage/storage.h>
+#include <flipper_format/flipper_format.h>
 
 /* ============================================================================
  * INTERNAL NOTIFICATION STRUCTURES
@@ -63,7 +75,6 @@ typedef struct {
 /** Digit bitmap dimensions */
 #define DIGIT_WIDTH          24
 #define DIGIT_HEIGHT         48
-#define DIGIT_BYTES_PER_ROW  3
 
 /** Colon dimensions */
 #define COLON_WIDTH          8
@@ -86,10 +97,40 @@ typedef struct {
 #define CLOCK_TOTAL_WIDTH    (4 * DIGIT_WIDTH + COLON_WIDTH)  /* 104 pixels */
 #define CLOCK_START_X        ((SCREEN_WIDTH - CLOCK_TOTAL_WIDTH) / 2)
 
+/** Frame cache: the whole HH:MM screen as one XBM bitmap (LSB first) */
+#define FRAME_BYTES_PER_ROW  (SCREEN_WIDTH / 8)
+#define FRAME_CACHE_SIZE     (FRAME_BYTES_PER_ROW * SCREEN_HEIGHT)  /* 1024 bytes */
+#define FRAME_CACHE_INVALID  0xFF  /* cached_hour value before the first render */
+
 /** Input handling */
-#define INPUT_QUEUE_SIZE     8
+#define INPUT_QUEUE_SIZE     16
+#define INPUT_PRESS_RESERVE  4      /* last queue slots kept for Press events */
 #define UPDATE_INTERVAL_MS   60000  /* 60 seconds - power efficient since we only show HH:MM */
 
+/** Persistent settings (FlipperFormat), written back once input goes quiet */
+#define SETTINGS_DIR           EXT_PATH("apps_data/big_clock")
+#define SETTINGS_PATH          EXT_PATH("apps_data/big_clock/settings.txt")
+#define SETTINGS_FILETYPE      "Big Clock Settings"
+#define SETTINGS_VERSION       1
+#define SETTINGS_SAVE_DELAY_MS 5000  /* quiet time after the last change before writing */
+
+/** Alarms, read once at startup from a file only the user writes */
+#define ALARMS_PATH          EXT_PATH("apps_data/big_clock/alarms.txt")
+#define ALARMS_FILETYPE      "Big Clock Alarms"
+#define ALARMS_VERSION       1
+#define ALARM_MAX            8
+#define ALARM_NONE           0xFFFF  /* alarm_next with no alarms, alarm_seen before the first update */
+#define ALARM_RING_MINUTES   5       /* the alert repeats at each rollover for this long, or until a key */
+#define ALARM_LATE_MINUTES   5       /* a longer jump forward is the clock being set: nothing fires */
+#define ALARM_WAKE_SLACK_MS  500     /* lands the alarm wake just past the rollover */
+#define MINUTES_PER_DAY      1440
+
+#ifdef DEBUG_INPUT_RECORD
+/** Input session recording */
+#define INPUT_RECORD_DIR     EXT_PATH("apps_data/big_clock")
+#define INPUT_RECORD_PATH    EXT_PATH("apps_data/big_clock/input_session.txt")
+#endif
+
 /* ============================================================================
  * TYPES
  * ============================================================================ */
@@ -107,227 +148,152 @@ typedef struct {
     bool is_running;                 /**< Application run state */
     NotificationAppInternal* notification; /**< Notification service handle (internal cast) */
     float original_brightness;       /**< Saved brightness to restore on exit */
+    uint8_t saved_brightness;        /**< Brightness as last read from or written to SD */
+    bool settings_save_pending;      /**< A settings write-back is scheduled */
+    uint32_t settings_save_due;      /**< Tick of the scheduled write-back */
+    FuriMessageQueue* event_queue;   /**< Input events for the main loop */
+    volatile bool input_repeat_queued;   /**< A Repeat event is waiting in event_queue */
+    volatile uint32_t input_coalesced;   /**< Repeats merged into the one already queued */
+    volatile uint32_t input_dropped;     /**< Events lost to a full queue */
+    volatile uint32_t input_queue_peak;  /**< Deepest event_queue seen */
+    uint8_t frame_cache[FRAME_CACHE_SIZE]; /**< Rendered HH:MM frame, touched only by render_callback */
+    uint8_t cached_hour;             /**< Hour in frame_cache, FRAME_CACHE_INVALID if none */
+    uint8_t cached_minute;           /**< Minute in frame_cache */
+    uint32_t heap_free;              /**< Free heap (whole system) at the last update */
+    uint32_t heap_min_free;          /**< Lowest free heap since boot */
+    uint32_t heap_free_start;        /**< Free heap when the main loop started */
+    uint32_t stack_free;             /**< App thread stack never used so far (high-water mark) */
+    uint8_t second;                  /**< RTC second at the last update_time() */
+    uint16_t alarms[ALARM_MAX];      /**< Minutes after midnight, ascending */
+    uint8_t alarm_count;
+    uint16_t alarm_next;             /**< First alarm after alarm_seen, ALARM_NONE if none */
+    uint16_t alarm_seen;             /**< Minute of day update_time() last saw */
+    uint16_t alarm_ringing_at;       /**< Alarm shown in the banner */
+    uint8_t alarm_ringing;           /**< Rollovers left to repeat the alert, 0 when quiet */
+    uint32_t alarms_fired;
+#ifdef DEBUG_INPUT_RECORD
+    Storage* record_storage;         /**< Storage record for the input recorder */
+    File* record_file;               /**< Open session file, NULL if unavailable */
+    uint32_t record_last_tick;       /**< Tick of the previous recorded event */
+#endif
 } BigClockState;
 
 /* ============================================================================
  * DIGIT BITMAP DATA
  * ============================================================================
  *
- * Each digit is a 24x48 pixel bitmap stored as 3 bytes per row (24 bits).
- * Total size per digit: 48 rows * 3 bytes = 144 bytes.
- *
- * Bit ordering: MSB first (bit 7 = leftmost pixel)
- * 1 = pixel on (white), 0 = pixel off (black)
- */
-
-static const uint8_t digit_bitmap_0[] = {
-    0x07, 0xFF, 0xE0, 0x1F, 0xFF, 0xF8, 0x3F, 0xFF, 0xFC, 0x7F, 0xFF, 0xFE,
-    0x7E, 0x00, 0x7E, 0xFC, 0x00, 0x3F, 0xF8, 0x00, 0x1F, 0xF8, 0x00, 0x1F,
-    0xF8, 0x00, 0x1F, 0xF8, 0x00, 0x1F, 0xF8, 0x00, 0x1F, 0xF8, 0x00, 0x1F,
-    0xF8, 0x00, 0x1F, 0xF8, 0x00, 0x1F, 0xF8, 0x00, 0x1F, 0xF8, 0x00, 0x1F,
-    0xF8, 0x00, 0x1F, 0xF8, 0x00, 0x1F, 0xF8, 0x00, 0x1F, 0xF8, 0x00, 0x1F,
-    0xF8, 0x00, 0x1F, 0xF8, 0x00, 0x1F, 0xF8, 0x00, 0x1F, 0xF8, 0x00, 0x1F,
-    0xF8, 0x00, 0x1F, 0xF8, 0x00, 0x1F, 0xF8, 0x00, 0x1F, 0xF8, 0x00, 0x1F,
-    0xF8, 0x00, 0x1F, 0xF8, 0x00, 0x1F, 0xF8, 0x00, 0x1F, 0xF8, 0x00, 0x1F,
-    0xF8, 0x00, 0x1F, 0xF8, 0x00, 0x1F, 0xF8, 0x00, 0x1F, 0xF8, 0x00, 0x1F,
-    0xF8, 0x00, 0x1F, 0xF8, 0x00, 0x1F, 0xF8, 0x00, 0x1F, 0xFC, 0x00, 0x3F,
-    0x7E, 0x00, 0x7E, 0x7F, 0xFF, 0xFE, 0x3F, 0xFF, 0xFC, 0x1F, 0xFF, 0xF8,
-    0x07, 0xFF, 0xE0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-};
-
-static const uint8_t digit_bitmap_1[] = {
-    0x00, 0x1F, 0x00, 0x00, 0x3F, 0x00, 0x00, 0xFF, 0x00, 0x03, 0xFF, 0x00,
-    0x0F, 0xFF, 0x00, 0x1F, 0xFF, 0x00, 0x1F, 0x1F, 0x00, 0x1C, 0x1F, 0x00,
-    0x00, 0x1F, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x1F, 0x00,
-    0x00, 0x1F, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x1F, 0x00,
-    0x00, 0x1F, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x1F, 0x00,
-    0x00, 0x1F, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x1F, 0x00,
-    0x00, 0x1F, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x1F, 0x00,
-    0x00, 0x1F, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x1F, 0x00,
-    0x00, 0x1F, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x1F, 0x00,
-    0x00, 0x1F, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x1F, 0x00,
-    0x00, 0x1F, 0x00, 0x0F, 0xFF, 0xF0, 0x0F, 0xFF, 0xF0, 0x0F, 0xFF, 0xF0,
-    0x0F, 0xFF, 0xF0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-};
-
-static const uint8_t digit_bitmap_2[] = {
-    0x07, 0xFF, 0xE0, 0x1F, 0xFF, 0xF8, 0x3F, 0xFF, 0xFC, 0x7F, 0xFF, 0xFE,
-    0x7E, 0x00, 0x7E, 0xFC, 0x00, 0x3F, 0xF8, 0x00, 0x1F, 0xF8, 0x00, 0x1F,
-    0x00, 0x00, 0x1F, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x1F,
-    0x00, 0x00, 0x3F, 0x00, 0x00, 0x7E, 0x00, 0x00, 0xFC, 0x00, 0x01, 0xF8,
-    0x00, 0x03, 0xF0, 0x00, 0x07, 0xE0, 0x00, 0x0F, 0xC0, 0x00, 0x1F, 0x80,
-    0x00, 0x3F, 0x00, 0x00, 0x7E, 0x00, 0x00, 0xFC, 0x00, 0x01, 0xF8, 0x00,
-    0x03, 0xF0, 0x00, 0x07, 0xE0, 0x00, 0x0F, 0xC0, 0x00, 0x1F, 0x80, 0x00,
-    0x3F, 0x00, 0x00, 0x7E, 0x00, 0x00, 0xFC, 0x00, 0x00, 0xF8, 0x00, 0x00,
-    0xF8, 0x00, 0x00, 0xF8, 0x00, 0x00, 0xF8, 0x00, 0x00, 0xF8, 0x00, 0x00,
-    0xF8, 0x00, 0x00, 0xF8, 0x00, 0x00, 0xFC, 0x00, 0x00, 0xFF, 0xFF, 0xFF,
-    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
-    0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-};
-
-static const uint8_t digit_bitmap_3[] = {
-    0x07, 0xFF, 0xE0, 0x1F, 0xFF, 0xF8, 0x3F, 0xFF, 0xFC, 0x7F, 0xFF, 0xFE,
-    0x7E, 0x00, 0x7E, 0xFC, 0x00, 0x3F, 0xF8, 0x00, 0x1F, 0xF8, 0x00, 0x1F,
-    0x00, 0x00, 0x1F, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x1F,
-    0x00, 0x00, 0x1F, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x3F, 0x00, 0x00, 0x7E,
-    0x00, 0x00, 0xFC, 0x00, 0xFF, 0xF8, 0x00, 0xFF, 0xF0, 0x00, 0xFF, 0xF8,
-    0x00, 0x00, 0xFC, 0x00, 0x00, 0x7E, 0x00, 0x00, 0x3F, 0x00, 0x00, 0x1F,
-    0x00, 0x00, 0x1F, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x1F,
-    0x00, 0x00, 0x1F, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x1F,
-    0x00, 0x00, 0x1F, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x1F, 0xF8, 0x00, 0x1F,
-    0xF8, 0x00, 0x1F, 0xFC, 0x00, 0x3F, 0x7E, 0x00, 0x7E, 0x7F, 0xFF, 0xFE,
-    0x3F, 0xFF, 0xFC, 0x1F, 0xFF, 0xF8, 0x07, 0xFF, 0xE0, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-};
-
-static const uint8_t digit_bitmap_4[] = {
-    0x00, 0x01, 0xF8, 0x00, 0x03, 0xF8, 0x00, 0x07, 0xF8, 0x00, 0x0F, 0xF8,
-    0x00, 0x1F, 0xF8, 0x00, 0x3E, 0xF8, 0x00, 0x7C, 0xF8, 0x00, 0xF8, 0xF8,
-    0x01, 0xF0, 0xF8, 0x03, 0xE0, 0xF8, 0x07, 0xC0, 0xF8, 0x0F, 0x80, 0xF8,
-    0x1F, 0x00, 0xF8, 0x3E, 0x00, 0xF8, 0x7C, 0x00, 0xF8, 0xF8, 0x00, 0xF8,
-    0xF8, 0x00, 0xF8, 0xF8, 0x00, 0xF8, 0xF8, 0x00, 0xF8, 0xF8, 0x00, 0xF8,
-    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
-    0x00, 0x00, 0xF8, 0x00, 0x00, 0xF8, 0x00, 0x00, 0xF8, 0x00, 0x00, 0xF8,
-    0x00, 0x00, 0xF8, 0x00, 0x00, 0xF8, 0x00, 0x00, 0xF8, 0x00, 0x00, 0xF8,
-    0x00, 0x00, 0xF8, 0x00, 0x00, 0xF8, 0x00, 0x00, 0xF8, 0x00, 0x00, 0xF8,
-    0x00, 0x00, 0xF8, 0x00, 0x00, 0xF8, 0x00, 0x00, 0xF8, 0x00, 0x00, 0xF8,
-    0x00, 0x00, 0xF8, 0x00, 0x00, 0xF8, 0x00, 0x00, 0xF8, 0x00, 0x00, 0xF8,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-};
-
-static const uint8_t digit_bitmap_5[] = {
-    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
-    0xF8, 0x00, 0x00, 0xF8, 0x00, 0x00, 0xF8, 0x00, 0x00, 0xF8, 0x00, 0x00,
-    0xF8, 0x00, 0x00, 0xF8, 0x00, 0x00, 0xF8, 0x00, 0x00, 0xF8, 0x00, 0x00,
-    0xF8, 0x00, 0x00, 0xF8, 0x00, 0x00, 0xF8, 0x00, 0x00, 0xF8, 0x00, 0x00,
-    0xFF, 0xFF, 0xE0, 0xFF, 0xFF, 0xF8, 0xFF, 0xFF, 0xFC, 0x00, 0x00, 0xFE,
-    0x00, 0x00, 0x7E, 0x00, 0x00, 0x3F, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x1F,
-    0x00, 0x00, 0x1F, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x1F,
-    0x00, 0x00, 0x1F, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x1F,
-    0x00, 0x00, 0x1F, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x1F, 0xF8, 0x00, 0x1F,
-    0xF8, 0x00, 0x1F, 0xFC, 0x00, 0x3F, 0x7E, 0x00, 0x7E, 0x7F, 0xFF, 0xFE,
-    0x3F, 0xFF, 0xFC, 0x1F, 0xFF, 0xF8, 0x07, 0xFF, 0xE0, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-};
-
-static const uint8_t digit_bitmap_6[] = {
-    0x07, 0xFF, 0xE0, 0x1F, 0xFF, 0xF8, 0x3F, 0xFF, 0xFC, 0x7F, 0xFF, 0xFE,
-    0x7E, 0x00, 0x7E, 0xFC, 0x00, 0x3F, 0xF8, 0x00, 0x1F, 0xF8, 0x00, 0x1F,
-    0xF8, 0x00, 0x00, 0xF8, 0x00, 0x00, 0xF8, 0x00, 0x00, 0xF8, 0x00, 0x00,
-    0xF8, 0x00, 0x00, 0xF8, 0x00, 0x00, 0xF8, 0x00, 0x00, 0xF8, 0x00, 0x00,
-    0xF8, 0x00, 0x00, 0xF9, 0xFF, 0xE0, 0xFB, 0xFF, 0xF8, 0xFF, 0xFF, 0xFC,
-    0xFF, 0xFF, 0xFE, 0xFE, 0x00, 0x7E, 0xFC, 0x00, 0x3F, 0xF8, 0x00, 0x1F,
-    0xF8, 0x00, 0x1F, 0xF8, 0x00, 0x1F, 0xF8, 0x00, 0x1F, 0xF8, 0x00, 0x1F,
-    0xF8, 0x00, 0x1F, 0xF8, 0x00, 0x1F, 0xF8, 0x00, 0x1F, 0xF8, 0x00, 0x1F,
-    0xF8, 0x00, 0x1F, 0xF8, 0x00, 0x1F, 0xF8, 0x00, 0x1F, 0xF8, 0x00, 0x1F,
-    0xF8, 0x00, 0x1F, 0xFC, 0x00, 0x3F, 0x7E, 0x00, 0x7E, 0x7F, 0xFF, 0xFE,
-    0x3F, 0xFF, 0xFC, 0x1F, 0xFF, 0xF8, 0x07, 0xFF, 0xE0, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-};
-
-static const uint8_t digit_bitmap_7[] = {
-    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
-    0x00, 0x00, 0x1F, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x3F, 0x00, 0x00, 0x3E,
-    0x00, 0x00, 0x7E, 0x00, 0x00, 0x7C, 0x00, 0x00, 0xFC, 0x00, 0x00, 0xF8,
-    0x00, 0x01, 0xF8, 0x00, 0x01, 0xF0, 0x00, 0x03, 0xF0, 0x00, 0x03, 0xE0,
-    0x00, 0x07, 0xE0, 0x00, 0x07, 0xC0, 0x00, 0x0F, 0xC0, 0x00, 0x0F, 0x80,
-    0x00, 0x1F, 0x80, 0x00, 0x1F, 0x00, 0x00, 0x3F, 0x00, 0x00, 0x3E, 0x00,
-    0x00, 0x7E, 0x00, 0x00, 0x7C, 0x00, 0x00, 0xFC, 0x00, 0x00, 0xF8, 0x00,
-    0x00, 0xF8, 0x00, 0x00, 0xF8, 0x00, 0x00, 0xF8, 0x00, 0x00, 0xF8, 0x00,
-    0x00, 0xF8, 0x00, 0x00, 0xF8, 0x00, 0x00, 0xF8, 0x00, 0x00, 0xF8, 0x00,
-    0x00, 0xF8, 0x00, 0x00, 0xF8, 0x00, 0x00, 0xF8, 0x00, 0x00, 0xF8, 0x00,
-    0x00, 0xF8, 0x00, 0x00, 0xF8, 0x00, 0x00, 0xF8, 0x00, 0x00, 0xF8, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-};
-
-static const uint8_t digit_bitmap_8[] = {
-    0x07, 0xFF, 0xE0, 0x1F, 0xFF, 0xF8, 0x3F, 0xFF, 0xFC, 0x7F, 0xFF, 0xFE,
-    0x7E, 0x00, 0x7E, 0xFC, 0x00, 0x3F, 0xF8, 0x00, 0x1F, 0xF8, 0x00, 0x1F,
-    0xF8, 0x00, 0x1F, 0xF8, 0x00, 0x1F, 0xF8, 0x00, 0x1F, 0xF8, 0x00, 0x1F,
-    0xF8, 0x00, 0x1F, 0xF8, 0x00, 0x1F, 0xFC, 0x00, 0x3F, 0x7E, 0x00, 0x7E,
-    0x3F, 0xFF, 0xFC, 0x1F, 0xFF, 0xF8, 0x1F, 0xFF, 0xF8, 0x3F, 0xFF, 0xFC,
-    0x7E, 0x00, 0x7E, 0xFC, 0x00, 0x3F, 0xF8, 0x00, 0x1F, 0xF8, 0x00, 0x1F,
-    0xF8, 0x00, 0x1F, 0xF8, 0x00, 0x1F, 0xF8, 0x00, 0x1F, 0xF8, 0x00, 0x1F,
-    0xF8, 0x00, 0x1F, 0xF8, 0x00, 0x1F, 0xF8, 0x00, 0x1F, 0xF8, 0x00, 0x1F,
-    0xF8, 0x00, 0x1F, 0xF8, 0x00, 0x1F, 0xF8, 0x00, 0x1F, 0xF8, 0x00, 0x1F,
-    0xF8, 0x00, 0x1F, 0xFC, 0x00, 0x3F, 0x7E, 0x00, 0x7E, 0x7F, 0xFF, 0xFE,
-    0x3F, 0xFF, 0xFC, 0x1F, 0xFF, 0xF8, 0x07, 0xFF, 0xE0, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-};
-
-static const uint8_t digit_bitmap_9[] = {
-    0x07, 0xFF, 0xE0, 0x1F, 0xFF, 0xF8, 0x3F, 0xFF, 0xFC, 0x7F, 0xFF, 0xFE,
-    0x7E, 0x00, 0x7E, 0xFC, 0x00, 0x3F, 0xF8, 0x00, 0x1F, 0xF8, 0x00, 0x1F,
-    0xF8, 0x00, 0x1F, 0xF8, 0x00, 0x1F, 0xF8, 0x00, 0x1F, 0xF8, 0x00, 0x1F,
-    0xF8, 0x00, 0x1F, 0xF8, 0x00, 0x1F, 0xF8, 0x00, 0x1F, 0xF8, 0x00, 0x1F,
-    0xF8, 0x00, 0x1F, 0xFC, 0x00, 0x3F, 0x7E, 0x00, 0x7F, 0x7F, 0xFF, 0xFF,
-    0x3F, 0xFF, 0xFF, 0x1F, 0xFF, 0xDF, 0x07, 0xFF, 0x9F, 0x00, 0x00, 0x1F,
-    0x00, 0x00, 0x1F, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x1F,
-    0x00, 0x00, 0x1F, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x1F,
-    0x00, 0x00, 0x1F, 0x00, 0x00, 0x1F, 0xF8, 0x00, 0x1F, 0xF8, 0x00, 0x1F,
-    0xF8, 0x00, 0x1F, 0xFC, 0x00, 0x3F, 0x7E, 0x00, 0x7E, 0x7F, 0xFF, 0xFE,
-    0x3F, 0xFF, 0xFC, 0x1F, 0xFF, 0xF8, 0x07, 0xFF, 0xE0, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-};
-
-/** Lookup table for digit bitmaps (0-9) */
-static const uint8_t* const digit_bitmaps[10] = {
-    digit_bitmap_0, digit_bitmap_1, digit_bitmap_2, digit_bitmap_3, digit_bitmap_4,
-    digit_bitmap_5, digit_bitmap_6, digit_bitmap_7, digit_bitmap_8, digit_bitmap_9
-};
+ * Generated from assets/digit_N.pbm by tools/assets/gen_assets.py. Each
+ * digit is stored in the frame's own XBM layout (LSB = leftmost pixel),
+ * shifted right by DIGIT_XBM_SHIFT bits, so frame_draw_digit() ORs whole
+ * bytes into the frame instead of testing every pixel.
+ */
+
+#include "big_clock_assets.h"
+
+_Static_assert(DIGIT_XBM_WIDTH == DIGIT_WIDTH && DIGIT_XBM_HEIGHT == DIGIT_HEIGHT,
+    "digit sources do not match DIGIT_WIDTH x DIGIT_HEIGHT");
+_Static_assert(CLOCK_START_X % 8 == DIGIT_XBM_SHIFT && DIGIT_WIDTH % 8 == 0 && COLON_WIDTH % 8 == 0,
+    "every digit must land DIGIT_XBM_SHIFT bits into a frame byte: regenerate the assets");
 
 /* ============================================================================
  * DRAWING FUNCTIONS
  * ============================================================================ */
 
 /**
- * @brief Draw a single digit at the specified position
+ * @brief Set one pixel in an XBM frame
+ *
+ * @param frame     Frame bitmap (FRAME_BYTES_PER_ROW bytes per row, LSB = leftmost)
+ * @param x         X coordinate
+ * @param y         Y coordinate
+ */
+static void frame_set_pixel(uint8_t* frame, int16_t x, int16_t y) {
+    frame[y * FRAME_BYTES_PER_ROW + x / 8] |= (uint8_t)(1 << (x % 8));
+}
+
+/**
+ * @brief Draw a single digit into a frame at the specified position
  *
- * Renders a 24x48 pixel digit bitmap to the canvas.
+ * ORs the digit's pre-shifted XBM rows into the frame, DIGIT_XBM_BYTES_PER_ROW
+ * bytes per row. Neighbouring digits share a frame byte, hence OR, not copy.
  *
- * @param canvas    Canvas to draw on
+ * @param frame     Frame bitmap to draw into
  * @param digit     Digit value (0-9)
- * @param x         X coordinate (left edge)
+ * @param x         X coordinate (left edge), DIGIT_XBM_SHIFT mod 8
  * @param y         Y coordinate (top edge)
  */
-static void draw_digit(Canvas* canvas, uint8_t digit, int16_t x, int16_t y) {
+static void frame_draw_digit(uint8_t* frame, uint8_t digit, int16_t x, int16_t y) {
     /* Validate digit range */
     if(digit > 9) {
         return;
     }
 
-    const uint8_t* bitmap = digit_bitmaps[digit];
+    const uint8_t* bitmap = digit_xbm[digit];
+    uint8_t* dst = frame + y * FRAME_BYTES_PER_ROW + x / 8;
 
-    /* Iterate through each pixel in the bitmap */
     for(int16_t row = 0; row < DIGIT_HEIGHT; row++) {
-        for(int16_t col = 0; col < DIGIT_WIDTH; col++) {
-            /* Calculate byte and bit position */
-            int16_t byte_index = row * DIGIT_BYTES_PER_ROW + col / 8;
-            int16_t bit_index = 7 - (col % 8);
-
-            /* Draw pixel if bit is set */
-            if(bitmap[byte_index] & (1 << bit_index)) {
-                canvas_draw_dot(canvas, x + col, y + row);
-            }
+        for(int16_t i = 0; i < DIGIT_XBM_BYTES_PER_ROW; i++) {
+            dst[i] |= bitmap[i];
         }
+        bitmap += DIGIT_XBM_BYTES_PER_ROW;
+        dst += FRAME_BYTES_PER_ROW;
     }
 }
 
 /**
- * @brief Draw the colon separator between hours and minutes
+ * @brief Draw the colon separator between hours and minutes into a frame
  *
  * Renders two square dots vertically centered.
  *
- * @param canvas    Canvas to draw on
+ * @param frame     Frame bitmap to draw into
  * @param x         X coordinate (left edge)
  * @param y         Y coordinate (top of digit area)
  */
-static void draw_colon(Canvas* canvas, int16_t x, int16_t y) {
-    int16_t top_dot_y = y + COLON_TOP_OFFSET;
-    int16_t bottom_dot_y = y + COLON_BOTTOM_OFFSET;
+static void frame_draw_colon(uint8_t* frame, int16_t x, int16_t y) {
+    const int16_t dot_y[2] = {y + COLON_TOP_OFFSET, y + COLON_BOTTOM_OFFSET};
 
-    canvas_draw_box(canvas, x + COLON_X_OFFSET, top_dot_y, COLON_DOT_SIZE, COLON_DOT_SIZE);
-    canvas_draw_box(canvas, x + COLON_X_OFFSET, bottom_dot_y, COLON_DOT_SIZE, COLON_DOT_SIZE);
+    for(int dot = 0; dot < 2; dot++) {
+        for(int16_t row = 0; row < COLON_DOT_SIZE; row++) {
+            for(int16_t col = 0; col < COLON_DOT_SIZE; col++) {
+                frame_set_pixel(frame, x + COLON_X_OFFSET + col, dot_y[dot] + row);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Render HH:MM into the frame cache
+ *
+ * Runs once per minute change; every redraw in between is a single blit.
+ *
+ * @param state   Application state holding the cache
+ * @param hour    Hour to render (0-23)
+ * @param minute  Minute to render (0-59)
+ */
+static void frame_cache_render(BigClockState* state, uint8_t hour, uint8_t minute) {
+    uint8_t* frame = state->frame_cache;
+    memset(frame, 0, FRAME_CACHE_SIZE);
+
+    /* Calculate vertical center position */
+    int16_t y = (SCREEN_HEIGHT - DIGIT_HEIGHT) / 2;
+    int16_t x = CLOCK_START_X;
+
+    /* Draw hours */
+    frame_draw_digit(frame, hour / 10, x, y);
+    x += DIGIT_WIDTH;
+    frame_draw_digit(frame, hour % 10, x, y);
+    x += DIGIT_WIDTH;
+
+    /* Draw colon separator */
+    frame_draw_colon(frame, x, y);
+    x += COLON_WIDTH;
+
+    /* Draw minutes */
+    frame_draw_digit(frame, minute / 10, x, y);
+    x += DIGIT_WIDTH;
+    frame_draw_digit(frame, minute % 10, x, y);
+
+    state->cached_hour = hour;
+    state->cached_minute = minute;
 }
 
 /**
@@ -364,6 +330,37 @@ static void draw_brightness_indicator(Canvas* canvas, uint8_t brightness) {
     }
 }
 
+/**
+ * @brief Draw the ringing alarm's banner above the digits
+ *
+ * @param canvas  Canvas to draw on
+ * @param alarm   Alarm time in minutes after midnight
+ */
+static void draw_alarm_banner(Canvas* canvas, uint16_t alarm) {
+    char text_buffer[24];
+    snprintf(text_buffer, sizeof(text_buffer), "ALARM %02u:%02u", alarm / 60, alarm % 60);
+    canvas_set_font(canvas, FontSecondary);
+    canvas_draw_str_aligned(canvas, SCREEN_WIDTH / 2, 0, AlignCenter, AlignTop, text_buffer);
+}
+
+#ifdef DEBUG_MEMORY
+/**
+ * @brief Draw memory telemetry along the bottom edge
+ *
+ * @param canvas  Canvas to draw on
+ * @param state   Application state
+ */
+static void draw_memory_overlay(Canvas* canvas, const BigClockState* state) {
+    char text_buffer[40];
+    snprintf(text_buffer, sizeof(text_buffer), "H %lu/%lu S %lu",
+        (unsigned long)state->heap_free,
+        (unsigned long)state->heap_min_free,
+        (unsigned long)state->stack_free);
+    canvas_set_font(canvas, FontSecondary);
+    canvas_draw_str_aligned(canvas, SCREEN_WIDTH / 2, SCREEN_HEIGHT, AlignCenter, AlignBottom, text_buffer);
+}
+#endif
+
 /* ============================================================================
  * CALLBACK FUNCTIONS
  * ============================================================================ */
@@ -379,45 +376,72 @@ static void draw_brightness_indicator(Canvas* canvas, uint8_t brightness) {
 static void render_callback(Canvas* canvas, void* ctx) {
     BigClockState* state = (BigClockState*)ctx;
 
-    canvas_clear(canvas);
-
-    /* Calculate vertical center position */
-    int16_t y = (SCREEN_HEIGHT - DIGIT_HEIGHT) / 2;
-    int16_t x = CLOCK_START_X;
-
-    /* Draw hours */
-    draw_digit(canvas, state->hour / 10, x, y);
-    x += DIGIT_WIDTH;
-    draw_digit(canvas, state->hour % 10, x, y);
-    x += DIGIT_WIDTH;
-
-    /* Draw colon separator */
-    draw_colon(canvas, x, y);
-    x += COLON_WIDTH;
+    /* Re-render the cached frame only when the displayed minute changed.
+     * Snapshot the time once: the main thread may update it concurrently. */
+    uint8_t hour = state->hour;
+    uint8_t minute = state->minute;
+    if(hour != state->cached_hour || minute != state->cached_minute) {
+        frame_cache_render(state, hour, minute);
+    }
 
-    /* Draw minutes */
-    draw_digit(canvas, state->minute / 10, x, y);
-    x += DIGIT_WIDTH;
-    draw_digit(canvas, state->minute % 10, x, y);
+    canvas_clear(canvas);
+    canvas_draw_xbm(canvas, 0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, state->frame_cache);
 
-    /* Show brightness indicator if recently changed (timestamp-based) */
-    if(furi_get_tick() < state->brightness_show_until) {
+    /* Show brightness indicator if recently changed (timestamp-based).
+     * Signed difference so the check survives the 32-bit tick wrap (~49.7 days);
+     * the main loop zeroes stale deadlines before they age past 2^31 ms. */
+    if(state->brightness_show_until != 0 &&
+       (int32_t)(state->brightness_show_until - furi_get_tick()) > 0) {
         draw_brightness_indicator(canvas, state->brightness);
+    } else if(state->alarm_ringing) {
+        draw_alarm_banner(canvas, state->alarm_ringing_at);
+    }
+#ifdef DEBUG_MEMORY
+    else {
+        draw_memory_overlay(canvas, state);
     }
+#endif
 }
 
 /**
  * @brief Input callback - handles button events
  *
  * Called by the GUI system when input events occur.
- * Events are forwarded to the main loop via message queue.
+ * Events are forwarded to the main loop via message queue without ever
+ * blocking the input thread: at most one Repeat is queued at a time (later
+ * ones are merged into it), the last INPUT_PRESS_RESERVE slots are kept for
+ * Press events, and anything that does not fit is dropped and counted.
  *
  * @param input_event  Input event data
- * @param ctx          Context pointer (FuriMessageQueue*)
+ * @param ctx          Context pointer (BigClockState*)
  */
 static void input_callback(InputEvent* input_event, void* ctx) {
-    FuriMessageQueue* event_queue = (FuriMessageQueue*)ctx;
-    furi_message_queue_put(event_queue, input_event, FuriWaitForever);
+    BigClockState* state = (BigClockState*)ctx;
+    bool repeat = (input_event->type == InputTypeRepeat);
+
+    /* Only Press and Repeat change anything; don't let the rest crowd them out */
+    if(input_event->type != InputTypePress &&
+       furi_message_queue_get_space(state->event_queue) <= INPUT_PRESS_RESERVE) {
+        state->input_dropped++;
+        return;
+    }
+
+    if(repeat) {
+        if(state->input_repeat_queued) {
+            state->input_coalesced++;
+            return;
+        }
+        state->input_repeat_queued = true;
+    }
+
+    if(furi_message_queue_put(state->event_queue, input_event, 0) != FuriStatusOk) {
+        state->input_dropped++;
+        if(repeat) state->input_repeat_queued = false;
+        return;
+    }
+
+    uint32_t depth = furi_message_queue_get_count(state->event_queue);
+    if(depth > state->input_queue_peak) state->input_queue_peak = depth;
 }
 
 /* ============================================================================
@@ -448,6 +472,69 @@ static void backlight_set_brightness(BigClockState* state, uint8_t brightness) {
     notification_message((NotificationApp*)state->notification, &sequence_display_backlight_on);
 }
 
+/* ============================================================================
+ * SETTINGS
+ * ============================================================================ */
+
+/**
+ * @brief Load the saved brightness, once at startup
+ *
+ * A missing file, another file type or version, or an out-of-range value
+ * leaves the brightness taken from the system setting.
+ *
+ * @param state  Application state
+ */
+static void settings_load(BigClockState* state) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FlipperFormat* file = flipper_format_file_alloc(storage);
+    FuriString* filetype = furi_string_alloc();
+    uint32_t version = 0;
+    uint32_t brightness = 0;
+
+    if(flipper_format_file_open_existing(file, SETTINGS_PATH) &&
+       flipper_format_read_header(file, filetype, &version) &&
+       furi_string_equal_str(filetype, SETTINGS_FILETYPE) && version == SETTINGS_VERSION &&
+       flipper_format_read_uint32(file, "Brightness", &brightness, 1) && brightness <= BRIGHTNESS_MAX) {
+        state->brightness = (uint8_t)(brightness / BRIGHTNESS_STEP * BRIGHTNESS_STEP);
+    }
+
+    furi_string_free(filetype);
+    flipper_format_free(file);
+    furi_record_close(RECORD_STORAGE);
+
+    state->saved_brightness = state->brightness;
+}
+
+/**
+ * @brief Write the brightness back if it differs from the file
+ *
+ * Keypresses only change RAM; this runs SETTINGS_SAVE_DELAY_MS after the
+ * last one and again on exit. On failure saved_brightness stays stale, so
+ * the exit save retries.
+ *
+ * @param state  Application state
+ */
+static void settings_save(BigClockState* state) {
+    state->settings_save_pending = false;
+    if(state->brightness == state->saved_brightness) return;
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    storage_common_mkdir(storage, SETTINGS_DIR);
+    FlipperFormat* file = flipper_format_file_alloc(storage);
+    uint32_t brightness = state->brightness;
+
+    if(flipper_format_file_open_always(file, SETTINGS_PATH) &&
+       flipper_format_write_header_cstr(file, SETTINGS_FILETYPE, SETTINGS_VERSION) &&
+       flipper_format_write_uint32(file, "Brightness", &brightness, 1)) {
+        state->saved_brightness = (uint8_t)brightness;
+    } else {
+        FURI_LOG_W("BigClock", "Cannot write %s", SETTINGS_PATH);
+    }
+
+    flipper_format_free(file);
+    furi_record_close(RECORD_STORAGE);
+}
+
 /* ============================================================================
  * INPUT HANDLING
  * ============================================================================ */
@@ -493,6 +580,12 @@ static void process_input(BigClockState* state, InputEvent* event) {
         return;
     }
 
+    /* Any key silences a ringing alarm; only BACK goes on to do its usual job */
+    if(state->alarm_ringing && event->key != InputKeyBack) {
+        if(event->type == InputTypePress) state->alarm_ringing = 0;
+        return;
+    }
+
     switch(event->key) {
         case InputKeyUp:
             brightness_increase(state);
@@ -512,6 +605,186 @@ static void process_input(BigClockState* state, InputEvent* event) {
     }
 }
 
+/* ============================================================================
+ * INPUT RECORDING (DEBUG_INPUT_RECORD only)
+ * ============================================================================ */
+
+#ifdef DEBUG_INPUT_RECORD
+/**
+ * @brief Open the input session file, replacing any previous recording
+ *
+ * @param state  Application state
+ */
+static void input_record_open(BigClockState* state) {
+    state->record_storage = furi_record_open(RECORD_STORAGE);
+    storage_common_mkdir(state->record_storage, INPUT_RECORD_DIR);
+
+    state->record_file = storage_file_alloc(state->record_storage);
+    if(!storage_file_open(state->record_file, INPUT_RECORD_PATH, FSAM_WRITE, FSOM_CREATE_ALWAYS)) {
+        storage_file_free(state->record_file);
+        state->record_file = NULL;
+    }
+    state->record_last_tick = furi_get_tick();
+}
+
+/**
+ * @brief Append one event as "+<delay_ms> <key> <type>"
+ *
+ * @param state  Application state
+ * @param event  Event as received by the main loop
+ */
+static void input_record_event(BigClockState* state, const InputEvent* event) {
+    static const char* const key_names[] = {"up", "down", "right", "left", "ok", "back"};
+    static const char* const type_names[] = {"press", "release", "short", "long", "repeat"};
+
+    if(state->record_file == NULL) return;
+    if(event->key >= InputKeyMAX || event->type >= InputTypeMAX) return;
+
+    uint32_t now = furi_get_tick();
+    char line[40];
+    int len = snprintf(line, sizeof(line), "+%lu %s %s\n",
+        (unsigned long)(now - state->record_last_tick),
+        key_names[event->key],
+        type_names[event->type]);
+    storage_file_write(state->record_file, line, len);
+    state->record_last_tick = now;
+}
+
+/**
+ * @brief Close the session file and release storage
+ *
+ * @param state  Application state
+ */
+static void input_record_close(BigClockState* state) {
+    if(state->record_file) {
+        storage_file_close(state->record_file);
+        storage_file_free(state->record_file);
+        state->record_file = NULL;
+    }
+    furi_record_close(RECORD_STORAGE);
+    state->record_storage = NULL;
+}
+#endif /* DEBUG_INPUT_RECORD */
+
+/* ============================================================================
+ * ALARMS
+ * ============================================================================
+ * Alarms are checked only when update_time() sees the minute change, which
+ * the main loop's wakes already cause: with none due that is one comparison
+ * per minute. alarm_next is kept ready, so the one wake an alarm moves (the
+ * last one before it, to land just past its rollover) comes straight from
+ * it and no timer is needed. Firing goes through the notification service.
+ */
+
+/**
+ * @brief Load the alarms, once at startup
+ *
+ * "Alarms" holds up to ALARM_MAX times as HHMM. A missing file, another
+ * file type or version leaves none; invalid times are skipped.
+ *
+ * @param state  Application state
+ */
+static void alarms_load(BigClockState* state) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FlipperFormat* file = flipper_format_file_alloc(storage);
+    FuriString* filetype = furi_string_alloc();
+    uint32_t version = 0;
+    uint32_t count = 0;
+    uint32_t hhmm[ALARM_MAX];
+
+    state->alarm_count = 0;
+    if(flipper_format_file_open_existing(file, ALARMS_PATH) &&
+       flipper_format_read_header(file, filetype, &version) &&
+       furi_string_equal_str(filetype, ALARMS_FILETYPE) && version == ALARMS_VERSION &&
+       flipper_format_get_value_count(file, "Alarms", &count) && count > 0) {
+        if(count > ALARM_MAX) count = ALARM_MAX;
+        if(flipper_format_read_uint32(file, "Alarms", hhmm, (uint16_t)count)) {
+            for(uint32_t i = 0; i < count; i++) {
+                if(hhmm[i] / 100 > 23 || hhmm[i] % 100 > 59) continue;
+                /* Insertion sort, dropping duplicates */
+                uint16_t alarm = (uint16_t)(hhmm[i] / 100 * 60 + hhmm[i] % 100);
+                uint8_t at = state->alarm_count;
+                while(at > 0 && state->alarms[at - 1] > alarm) at--;
+                if(at > 0 && state->alarms[at - 1] == alarm) continue;
+                memmove(&state->alarms[at + 1], &state->alarms[at], (state->alarm_count - at) * sizeof(uint16_t));
+                state->alarms[at] = alarm;
+                state->alarm_count++;
+            }
+        }
+    }
+
+    furi_string_free(filetype);
+    flipper_format_free(file);
+    furi_record_close(RECORD_STORAGE);
+}
+
+/**
+ * @brief First alarm after minute @p now, wrapping to tomorrow
+ *
+ * @param state  Application state
+ * @param now    Minutes after midnight
+ * @return       Alarm in minutes after midnight, ALARM_NONE if there are none
+ */
+static uint16_t alarm_after(const BigClockState* state, uint16_t now) {
+    if(state->alarm_count == 0) return ALARM_NONE;
+    for(uint8_t i = 0; i < state->alarm_count; i++) {
+        if(state->alarms[i] > now) return state->alarms[i];
+    }
+    return state->alarms[0];
+}
+
+/**
+ * @brief Handle the minute of day changing to @p now
+ *
+ * Fires alarm_next if the minutes since the last rollover include it, and
+ * repeats the alert of one still ringing.
+ *
+ * @param state  Application state
+ * @param now    Minutes after midnight
+ */
+static void alarm_rollover(BigClockState* state, uint16_t now) {
+    uint16_t seen = state->alarm_seen;
+    state->alarm_seen = now;
+    if(state->alarm_count == 0) return;
+
+    if(state->alarm_ringing && --state->alarm_ringing) {
+        notification_message((NotificationApp*)state->notification, &sequence_audiovisual_alert);
+    }
+    if(seen == ALARM_NONE) {
+        state->alarm_next = alarm_after(state, now);
+        return;
+    }
+
+    uint16_t elapsed = (uint16_t)((now + MINUTES_PER_DAY - seen) % MINUTES_PER_DAY);
+    uint16_t until = (uint16_t)((state->alarm_next + MINUTES_PER_DAY - seen) % MINUTES_PER_DAY);
+    if(until == 0) until = MINUTES_PER_DAY;
+
+    if(elapsed <= ALARM_LATE_MINUTES && until <= elapsed) {
+        state->alarm_ringing = ALARM_RING_MINUTES;
+        state->alarm_ringing_at = state->alarm_next;
+        state->alarms_fired++;
+        notification_message((NotificationApp*)state->notification, &sequence_audiovisual_alert);
+    }
+    if(elapsed > ALARM_LATE_MINUTES || until <= elapsed) {
+        state->alarm_next = alarm_after(state, now);
+    }
+}
+
+/**
+ * @brief Milliseconds until just past the next alarm's rollover
+ *
+ * Only ever shorter than UPDATE_INTERVAL_MS in the minute before an alarm.
+ *
+ * @param state  Application state, as update_time() last left it
+ * @return       Delay for the main loop's wait, UINT32_MAX if there are no alarms
+ */
+static uint32_t alarm_wake_ms(const BigClockState* state) {
+    if(state->alarm_next == ALARM_NONE) return UINT32_MAX;
+    uint32_t minutes = (state->alarm_next + MINUTES_PER_DAY - state->alarm_seen) % MINUTES_PER_DAY;
+    if(minutes == 0) minutes = MINUTES_PER_DAY;
+    return (minutes * 60 - state->second) * 1000 + ALARM_WAKE_SLACK_MS;
+}
+
 /* ============================================================================
  * TIME MANAGEMENT
  * ============================================================================ */
@@ -527,6 +800,28 @@ static void update_time(BigClockState* state) {
 
     state->hour = datetime.hour;
     state->minute = datetime.minute;
+    state->second = datetime.second;
+
+    uint16_t now = (uint16_t)(datetime.hour * 60 + datetime.minute);
+    if(now != state->alarm_seen) alarm_rollover(state, now);
+}
+
+/* ============================================================================
+ * MEMORY TELEMETRY
+ * ============================================================================ */
+
+/**
+ * @brief Sample free heap and the app thread's stack high-water mark
+ *
+ * stack_free only ever shrinks: stack_size in application.fam minus the
+ * smallest value seen over a long run is what the app really needs.
+ *
+ * @param state  Application state to update
+ */
+static void memory_telemetry_update(BigClockState* state) {
+    state->heap_free = (uint32_t)memmgr_get_free_heap();
+    state->heap_min_free = (uint32_t)memmgr_get_minimum_free_heap();
+    state->stack_free = furi_thread_get_stack_space(furi_thread_get_current_id());
 }
 
 /* ============================================================================
@@ -548,6 +843,27 @@ static BigClockState* state_alloc(void) {
     state->is_running = true;
     state->notification = NULL;
     state->original_brightness = 1.0f;
+    state->saved_brightness = BRIGHTNESS_MAX;
+    state->settings_save_pending = false;
+    state->settings_save_due = 0;
+    state->event_queue = NULL;
+    state->input_repeat_queued = false;
+    state->input_coalesced = 0;
+    state->input_dropped = 0;
+    state->input_queue_peak = 0;
+    state->cached_hour = FRAME_CACHE_INVALID;
+    state->cached_minute = FRAME_CACHE_INVALID;
+    state->heap_free = 0;
+    state->heap_min_free = 0;
+    state->heap_free_start = 0;
+    state->stack_free = 0;
+    state->second = 0;
+    state->alarm_count = 0;
+    state->alarm_next = ALARM_NONE;
+    state->alarm_seen = ALARM_NONE;
+    state->alarm_ringing_at = 0;
+    state->alarm_ringing = 0;
+    state->alarms_fired = 0;
 
     return state;
 }
@@ -575,11 +891,12 @@ int32_t big_clock_app(void* p) {
 
     /* Create input event queue */
     FuriMessageQueue* event_queue = furi_message_queue_alloc(INPUT_QUEUE_SIZE, sizeof(InputEvent));
+    state->event_queue = event_queue;
 
     /* Set up viewport */
     ViewPort* view_port = view_port_alloc();
     view_port_draw_callback_set(view_port, render_callback, state);
-    view_port_input_callback_set(view_port, input_callback, event_queue);
+    view_port_input_callback_set(view_port, input_callback, state);
 
     /* Register with GUI */
     Gui* gui = furi_record_open(RECORD_GUI);
@@ -596,22 +913,41 @@ int32_t big_clock_app(void* p) {
     state->brightness = (system_brightness_pct / BRIGHTNESS_STEP) * BRIGHTNESS_STEP;
     if(state->brightness > BRIGHTNESS_MAX) state->brightness = BRIGHTNESS_MAX;
 
+    /* A brightness saved by an earlier session takes precedence (applied by the main loop) */
+    settings_load(state);
+    alarms_load(state);
+
     /* Enable always-on backlight (keeps current brightness, just prevents auto-off) */
     notification_message((NotificationApp*)state->notification, &sequence_display_backlight_enforce_on);
 
     /* Get initial time */
     update_time(state);
 
+#ifdef DEBUG_INPUT_RECORD
+    input_record_open(state);
+#endif
+
     /* Briefly flash brightness indicator so user knows current level (2 seconds) */
     state->brightness_show_until = furi_get_tick() + 2000;
     view_port_update(view_port);
 
+    /* Everything is allocated now; later drops in free heap are leaks or other apps */
+    memory_telemetry_update(state);
+    state->heap_free_start = state->heap_free;
+
     /* Main loop */
     InputEvent event;
 
     while(state->is_running) {
         /* Update current time */
         update_time(state);
+        memory_telemetry_update(state);
+
+        /* Retire an expired brightness indicator deadline (see render_callback) */
+        if(state->brightness_show_until != 0 &&
+           (int32_t)(furi_get_tick() - state->brightness_show_until) >= 0) {
+            state->brightness_show_until = 0;
+        }
 
         /*
          * Reapply brightness every update cycle to prevent firmware from reverting it.
@@ -625,14 +961,62 @@ int32_t big_clock_app(void* p) {
         /* Request screen redraw */
         view_port_update(view_port);
 
+        /* Write back settings once input has been quiet for SETTINGS_SAVE_DELAY_MS */
+        uint32_t timeout = UPDATE_INTERVAL_MS;
+        if(state->settings_save_pending) {
+            int32_t until_save = (int32_t)(state->settings_save_due - furi_get_tick());
+            if(until_save <= 0) {
+                settings_save(state);
+            } else if((uint32_t)until_save < timeout) {
+                timeout = (uint32_t)until_save;
+            }
+        }
+
+        /* The last wake before an alarm moves to just past its rollover */
+        uint32_t until_alarm = alarm_wake_ms(state);
+        if(until_alarm < timeout) timeout = until_alarm;
+
         /* Process input events (with timeout for periodic updates) */
-        if(furi_message_queue_get(event_queue, &event, UPDATE_INTERVAL_MS) == FuriStatusOk) {
+        if(furi_message_queue_get(event_queue, &event, timeout) == FuriStatusOk) {
+            if(event.type == InputTypeRepeat) state->input_repeat_queued = false;
+#ifdef DEBUG_INPUT_RECORD
+            input_record_event(state, &event);
+#endif
             process_input(state, &event);
             /* Immediate redraw after input to show brightness indicator */
             view_port_update(view_port);
+
+            /* Every keypress restarts the write-back delay while the brightness differs */
+            if(state->brightness != state->saved_brightness) {
+                state->settings_save_pending = true;
+                state->settings_save_due = furi_get_tick() + SETTINGS_SAVE_DELAY_MS;
+            }
         }
     }
 
+    settings_save(state);
+
+#ifdef DEBUG_INPUT_RECORD
+    input_record_close(state);
+#endif
+
+    FURI_LOG_I(
+        "BigClock",
+        "Input: %lu dropped, %lu repeats coalesced, queue peak %lu/%d",
+        (unsigned long)state->input_dropped,
+        (unsigned long)state->input_coalesced,
+        (unsigned long)state->input_queue_peak,
+        INPUT_QUEUE_SIZE);
+    FURI_LOG_I("BigClock", "Alarms: %u set, %lu fired", state->alarm_count, (unsigned long)state->alarms_fired);
+    memory_telemetry_update(state);
+    FURI_LOG_I(
+        "BigClock",
+        "Memory: stack %lu bytes never used, heap free %lu (min %lu, %ld since start)",
+        (unsigned long)state->stack_free,
+        (unsigned long)state->heap_free,
+        (unsigned long)state->heap_min_free,
+        (long)state->heap_free - (long)state->heap_free_start);
+
     /* Cleanup: restore original brightness and default backlight behavior */
     state->notification->settings.display_brightness = state->original_brightness;
     notification_message((NotificationApp*)state->notification, &sequence_display_backlight_enforce_auto);
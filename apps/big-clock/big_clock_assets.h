@@ -0,0 +1,165 @@
+/**
+ * @file big_clock_assets.h
+ * @brief Bitmaps for big-clock, generated from apps/big-clock/assets/
+ *
+ * Generated by tools/assets/gen_assets.py - edit the sources and rerun it
+ * (just assets) rather than editing this file. Sizes are in bytes:
+ *
+ *   Asset      Source       Size       Layout          1-bpp  Flash
+ *   digit_xbm  digit_*.pbm  24x48 x10  XBM, shifted 4   1440   1920
+ *   Total                                               1440   1920
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#define DIGIT_XBM_WIDTH 24
+#define DIGIT_XBM_HEIGHT 48
+#define DIGIT_XBM_SHIFT 4
+#define DIGIT_XBM_BYTES_PER_ROW 4
+
+static const uint8_t digit_xbm[10][192] = {
+    { /* 0 */
+        0x00, 0xFE, 0x7F, 0x00, 0x80, 0xFF, 0xFF, 0x01, 0xC0, 0xFF, 0xFF, 0x03, 0xE0, 0xFF, 0xFF, 0x07,
+        0xE0, 0x07, 0xE0, 0x07, 0xF0, 0x03, 0xC0, 0x0F, 0xF0, 0x01, 0x80, 0x0F, 0xF0, 0x01, 0x80, 0x0F,
+        0xF0, 0x01, 0x80, 0x0F, 0xF0, 0x01, 0x80, 0x0F, 0xF0, 0x01, 0x80, 0x0F, 0xF0, 0x01, 0x80, 0x0F,
+        0xF0, 0x01, 0x80, 0x0F, 0xF0, 0x01, 0x80, 0x0F, 0xF0, 0x01, 0x80, 0x0F, 0xF0, 0x01, 0x80, 0x0F,
+        0xF0, 0x01, 0x80, 0x0F, 0xF0, 0x01, 0x80, 0x0F, 0xF0, 0x01, 0x80, 0x0F, 0xF0, 0x01, 0x80, 0x0F,
+        0xF0, 0x01, 0x80, 0x0F, 0xF0, 0x01, 0x80, 0x0F, 0xF0, 0x01, 0x80, 0x0F, 0xF0, 0x01, 0x80, 0x0F,
+        0xF0, 0x01, 0x80, 0x0F, 0xF0, 0x01, 0x80, 0x0F, 0xF0, 0x01, 0x80, 0x0F, 0xF0, 0x01, 0x80, 0x0F,
+        0xF0, 0x01, 0x80, 0x0F, 0xF0, 0x01, 0x80, 0x0F, 0xF0, 0x01, 0x80, 0x0F, 0xF0, 0x01, 0x80, 0x0F,
+        0xF0, 0x01, 0x80, 0x0F, 0xF0, 0x01, 0x80, 0x0F, 0xF0, 0x01, 0x80, 0x0F, 0xF0, 0x01, 0x80, 0x0F,
+        0xF0, 0x01, 0x80, 0x0F, 0xF0, 0x01, 0x80, 0x0F, 0xF0, 0x01, 0x80, 0x0F, 0xF0, 0x03, 0xC0, 0x0F,
+        0xE0, 0x07, 0xE0, 0x07, 0xE0, 0xFF, 0xFF, 0x07, 0xC0, 0xFF, 0xFF, 0x03, 0x80, 0xFF, 0xFF, 0x01,
+        0x00, 0xFE, 0x7F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    },
+    { /* 1 */
+        0x00, 0x80, 0x0F, 0x00, 0x00, 0xC0, 0x0F, 0x00, 0x00, 0xF0, 0x0F, 0x00, 0x00, 0xFC, 0x0F, 0x00,
+        0x00, 0xFF, 0x0F, 0x00, 0x80, 0xFF, 0x0F, 0x00, 0x80, 0x8F, 0x0F, 0x00, 0x80, 0x83, 0x0F, 0x00,
+        0x00, 0x80, 0x0F, 0x00, 0x00, 0x80, 0x0F, 0x00, 0x00, 0x80, 0x0F, 0x00, 0x00, 0x80, 0x0F, 0x00,
+        0x00, 0x80, 0x0F, 0x00, 0x00, 0x80, 0x0F, 0x00, 0x00, 0x80, 0x0F, 0x00, 0x00, 0x80, 0x0F, 0x00,
+        0x00, 0x80, 0x0F, 0x00, 0x00, 0x80, 0x0F, 0x00, 0x00, 0x80, 0x0F, 0x00, 0x00, 0x80, 0x0F, 0x00,
+        0x00, 0x80, 0x0F, 0x00, 0x00, 0x80, 0x0F, 0x00, 0x00, 0x80, 0x0F, 0x00, 0x00, 0x80, 0x0F, 0x00,
+        0x00, 0x80, 0x0F, 0x00, 0x00, 0x80, 0x0F, 0x00, 0x00, 0x80, 0x0F, 0x00, 0x00, 0x80, 0x0F, 0x00,
+        0x00, 0x80, 0x0F, 0x00, 0x00, 0x80, 0x0F, 0x00, 0x00, 0x80, 0x0F, 0x00, 0x00, 0x80, 0x0F, 0x00,
+        0x00, 0x80, 0x0F, 0x00, 0x00, 0x80, 0x0F, 0x00, 0x00, 0x80, 0x0F, 0x00, 0x00, 0x80, 0x0F, 0x00,
+        0x00, 0x80, 0x0F, 0x00, 0x00, 0x80, 0x0F, 0x00, 0x00, 0x80, 0x0F, 0x00, 0x00, 0x80, 0x0F, 0x00,
+        0x00, 0x80, 0x0F, 0x00, 0x00, 0xFF, 0xFF, 0x00, 0x00, 0xFF, 0xFF, 0x00, 0x00, 0xFF, 0xFF, 0x00,
+        0x00, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    },
+    { /* 2 */
+        0x00, 0xFE, 0x7F, 0x00, 0x80, 0xFF, 0xFF, 0x01, 0xC0, 0xFF, 0xFF, 0x03, 0xE0, 0xFF, 0xFF, 0x07,
+        0xE0, 0x07, 0xE0, 0x07, 0xF0, 0x03, 0xC0, 0x0F, 0xF0, 0x01, 0x80, 0x0F, 0xF0, 0x01, 0x80, 0x0F,
+        0x00, 0x00, 0x80, 0x0F, 0x00, 0x00, 0x80, 0x0F, 0x00, 0x00, 0x80, 0x0F, 0x00, 0x00, 0x80, 0x0F,
+        0x00, 0x00, 0xC0, 0x0F, 0x00, 0x00, 0xE0, 0x07, 0x00, 0x00, 0xF0, 0x03, 0x00, 0x00, 0xF8, 0x01,
+        0x00, 0x00, 0xFC, 0x00, 0x00, 0x00, 0x7E, 0x00, 0x00, 0x00, 0x3F, 0x00, 0x00, 0x80, 0x1F, 0x00,
+        0x00, 0xC0, 0x0F, 0x00, 0x00, 0xE0, 0x07, 0x00, 0x00, 0xF0, 0x03, 0x00, 0x00, 0xF8, 0x01, 0x00,
+        0x00, 0xFC, 0x00, 0x00, 0x00, 0x7E, 0x00, 0x00, 0x00, 0x3F, 0x00, 0x00, 0x80, 0x1F, 0x00, 0x00,
+        0xC0, 0x0F, 0x00, 0x00, 0xE0, 0x07, 0x00, 0x00, 0xF0, 0x03, 0x00, 0x00, 0xF0, 0x01, 0x00, 0x00,
+        0xF0, 0x01, 0x00, 0x00, 0xF0, 0x01, 0x00, 0x00, 0xF0, 0x01, 0x00, 0x00, 0xF0, 0x01, 0x00, 0x00,
+        0xF0, 0x01, 0x00, 0x00, 0xF0, 0x01, 0x00, 0x00, 0xF0, 0x03, 0x00, 0x00, 0xF0, 0xFF, 0xFF, 0x0F,
+        0xF0, 0xFF, 0xFF, 0x0F, 0xF0, 0xFF, 0xFF, 0x0F, 0xF0, 0xFF, 0xFF, 0x0F, 0xF0, 0xFF, 0xFF, 0x0F,
+        0xF0, 0xFF, 0xFF, 0x0F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    },
+    { /* 3 */
+        0x00, 0xFE, 0x7F, 0x00, 0x80, 0xFF, 0xFF, 0x01, 0xC0, 0xFF, 0xFF, 0x03, 0xE0, 0xFF, 0xFF, 0x07,
+        0xE0, 0x07, 0xE0, 0x07, 0xF0, 0x03, 0xC0, 0x0F, 0xF0, 0x01, 0x80, 0x0F, 0xF0, 0x01, 0x80, 0x0F,
+        0x00, 0x00, 0x80, 0x0F, 0x00, 0x00, 0x80, 0x0F, 0x00, 0x00, 0x80, 0x0F, 0x00, 0x00, 0x80, 0x0F,
+        0x00, 0x00, 0x80, 0x0F, 0x00, 0x00, 0x80, 0x0F, 0x00, 0x00, 0xC0, 0x0F, 0x00, 0x00, 0xE0, 0x07,
+        0x00, 0x00, 0xF0, 0x03, 0x00, 0xF0, 0xFF, 0x01, 0x00, 0xF0, 0xFF, 0x00, 0x00, 0xF0, 0xFF, 0x01,
+        0x00, 0x00, 0xF0, 0x03, 0x00, 0x00, 0xE0, 0x07, 0x00, 0x00, 0xC0, 0x0F, 0x00, 0x00, 0x80, 0x0F,
+        0x00, 0x00, 0x80, 0x0F, 0x00, 0x00, 0x80, 0x0F, 0x00, 0x00, 0x80, 0x0F, 0x00, 0x00, 0x80, 0x0F,
+        0x00, 0x00, 0x80, 0x0F, 0x00, 0x00, 0x80, 0x0F, 0x00, 0x00, 0x80, 0x0F, 0x00, 0x00, 0x80, 0x0F,
+        0x00, 0x00, 0x80, 0x0F, 0x00, 0x00, 0x80, 0x0F, 0x00, 0x00, 0x80, 0x0F, 0xF0, 0x01, 0x80, 0x0F,
+        0xF0, 0x01, 0x80, 0x0F, 0xF0, 0x03, 0xC0, 0x0F, 0xE0, 0x07, 0xE0, 0x07, 0xE0, 0xFF, 0xFF, 0x07,
+        0xC0, 0xFF, 0xFF, 0x03, 0x80, 0xFF, 0xFF, 0x01, 0x00, 0xFE, 0x7F, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    },
+    { /* 4 */
+        0x00, 0x00, 0xF8, 0x01, 0x00, 0x00, 0xFC, 0x01, 0x00, 0x00, 0xFE, 0x01, 0x00, 0x00, 0xFF, 0x01,
+        0x00, 0x80, 0xFF, 0x01, 0x00, 0xC0, 0xF7, 0x01, 0x00, 0xE0, 0xF3, 0x01, 0x00, 0xF0, 0xF1, 0x01,
+        0x00, 0xF8, 0xF0, 0x01, 0x00, 0x7C, 0xF0, 0x01, 0x00, 0x3E, 0xF0, 0x01, 0x00, 0x1F, 0xF0, 0x01,
+        0x80, 0x0F, 0xF0, 0x01, 0xC0, 0x07, 0xF0, 0x01, 0xE0, 0x03, 0xF0, 0x01, 0xF0, 0x01, 0xF0, 0x01,
+        0xF0, 0x01, 0xF0, 0x01, 0xF0, 0x01, 0xF0, 0x01, 0xF0, 0x01, 0xF0, 0x01, 0xF0, 0x01, 0xF0, 0x01,
+        0xF0, 0xFF, 0xFF, 0x0F, 0xF0, 0xFF, 0xFF, 0x0F, 0xF0, 0xFF, 0xFF, 0x0F, 0xF0, 0xFF, 0xFF, 0x0F,
+        0x00, 0x00, 0xF0, 0x01, 0x00, 0x00, 0xF0, 0x01, 0x00, 0x00, 0xF0, 0x01, 0x00, 0x00, 0xF0, 0x01,
+        0x00, 0x00, 0xF0, 0x01, 0x00, 0x00, 0xF0, 0x01, 0x00, 0x00, 0xF0, 0x01, 0x00, 0x00, 0xF0, 0x01,
+        0x00, 0x00, 0xF0, 0x01, 0x00, 0x00, 0xF0, 0x01, 0x00, 0x00, 0xF0, 0x01, 0x00, 0x00, 0xF0, 0x01,
+        0x00, 0x00, 0xF0, 0x01, 0x00, 0x00, 0xF0, 0x01, 0x00, 0x00, 0xF0, 0x01, 0x00, 0x00, 0xF0, 0x01,
+        0x00, 0x00, 0xF0, 0x01, 0x00, 0x00, 0xF0, 0x01, 0x00, 0x00, 0xF0, 0x01, 0x00, 0x00, 0xF0, 0x01,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    },
+    { /* 5 */
+        0xF0, 0xFF, 0xFF, 0x0F, 0xF0, 0xFF, 0xFF, 0x0F, 0xF0, 0xFF, 0xFF, 0x0F, 0xF0, 0xFF, 0xFF, 0x0F,
+        0xF0, 0x01, 0x00, 0x00, 0xF0, 0x01, 0x00, 0x00, 0xF0, 0x01, 0x00, 0x00, 0xF0, 0x01, 0x00, 0x00,
+        0xF0, 0x01, 0x00, 0x00, 0xF0, 0x01, 0x00, 0x00, 0xF0, 0x01, 0x00, 0x00, 0xF0, 0x01, 0x00, 0x00,
+        0xF0, 0x01, 0x00, 0x00, 0xF0, 0x01, 0x00, 0x00, 0xF0, 0x01, 0x00, 0x00, 0xF0, 0x01, 0x00, 0x00,
+        0xF0, 0xFF, 0x7F, 0x00, 0xF0, 0xFF, 0xFF, 0x01, 0xF0, 0xFF, 0xFF, 0x03, 0x00, 0x00, 0xF0, 0x07,
+        0x00, 0x00, 0xE0, 0x07, 0x00, 0x00, 0xC0, 0x0F, 0x00, 0x00, 0x80, 0x0F, 0x00, 0x00, 0x80, 0x0F,
+        0x00, 0x00, 0x80, 0x0F, 0x00, 0x00, 0x80, 0x0F, 0x00, 0x00, 0x80, 0x0F, 0x00, 0x00, 0x80, 0x0F,
+        0x00, 0x00, 0x80, 0x0F, 0x00, 0x00, 0x80, 0x0F, 0x00, 0x00, 0x80, 0x0F, 0x00, 0x00, 0x80, 0x0F,
+        0x00, 0x00, 0x80, 0x0F, 0x00, 0x00, 0x80, 0x0F, 0x00, 0x00, 0x80, 0x0F, 0xF0, 0x01, 0x80, 0x0F,
+        0xF0, 0x01, 0x80, 0x0F, 0xF0, 0x03, 0xC0, 0x0F, 0xE0, 0x07, 0xE0, 0x07, 0xE0, 0xFF, 0xFF, 0x07,
+        0xC0, 0xFF, 0xFF, 0x03, 0x80, 0xFF, 0xFF, 0x01, 0x00, 0xFE, 0x7F, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    },
+    { /* 6 */
+        0x00, 0xFE, 0x7F, 0x00, 0x80, 0xFF, 0xFF, 0x01, 0xC0, 0xFF, 0xFF, 0x03, 0xE0, 0xFF, 0xFF, 0x07,
+        0xE0, 0x07, 0xE0, 0x07, 0xF0, 0x03, 0xC0, 0x0F, 0xF0, 0x01, 0x80, 0x0F, 0xF0, 0x01, 0x80, 0x0F,
+        0xF0, 0x01, 0x00, 0x00, 0xF0, 0x01, 0x00, 0x00, 0xF0, 0x01, 0x00, 0x00, 0xF0, 0x01, 0x00, 0x00,
+        0xF0, 0x01, 0x00, 0x00, 0xF0, 0x01, 0x00, 0x00, 0xF0, 0x01, 0x00, 0x00, 0xF0, 0x01, 0x00, 0x00,
+        0xF0, 0x01, 0x00, 0x00, 0xF0, 0xF9, 0x7F, 0x00, 0xF0, 0xFD, 0xFF, 0x01, 0xF0, 0xFF, 0xFF, 0x03,
+        0xF0, 0xFF, 0xFF, 0x07, 0xF0, 0x07, 0xE0, 0x07, 0xF0, 0x03, 0xC0, 0x0F, 0xF0, 0x01, 0x80, 0x0F,
+        0xF0, 0x01, 0x80, 0x0F, 0xF0, 0x01, 0x80, 0x0F, 0xF0, 0x01, 0x80, 0x0F, 0xF0, 0x01, 0x80, 0x0F,
+        0xF0, 0x01, 0x80, 0x0F, 0xF0, 0x01, 0x80, 0x0F, 0xF0, 0x01, 0x80, 0x0F, 0xF0, 0x01, 0x80, 0x0F,
+        0xF0, 0x01, 0x80, 0x0F, 0xF0, 0x01, 0x80, 0x0F, 0xF0, 0x01, 0x80, 0x0F, 0xF0, 0x01, 0x80, 0x0F,
+        0xF0, 0x01, 0x80, 0x0F, 0xF0, 0x03, 0xC0, 0x0F, 0xE0, 0x07, 0xE0, 0x07, 0xE0, 0xFF, 0xFF, 0x07,
+        0xC0, 0xFF, 0xFF, 0x03, 0x80, 0xFF, 0xFF, 0x01, 0x00, 0xFE, 0x7F, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    },
+    { /* 7 */
+        0xF0, 0xFF, 0xFF, 0x0F, 0xF0, 0xFF, 0xFF, 0x0F, 0xF0, 0xFF, 0xFF, 0x0F, 0xF0, 0xFF, 0xFF, 0x0F,
+        0x00, 0x00, 0x80, 0x0F, 0x00, 0x00, 0x80, 0x0F, 0x00, 0x00, 0xC0, 0x0F, 0x00, 0x00, 0xC0, 0x07,
+        0x00, 0x00, 0xE0, 0x07, 0x00, 0x00, 0xE0, 0x03, 0x00, 0x00, 0xF0, 0x03, 0x00, 0x00, 0xF0, 0x01,
+        0x00, 0x00, 0xF8, 0x01, 0x00, 0x00, 0xF8, 0x00, 0x00, 0x00, 0xFC, 0x00, 0x00, 0x00, 0x7C, 0x00,
+        0x00, 0x00, 0x7E, 0x00, 0x00, 0x00, 0x3E, 0x00, 0x00, 0x00, 0x3F, 0x00, 0x00, 0x00, 0x1F, 0x00,
+        0x00, 0x80, 0x1F, 0x00, 0x00, 0x80, 0x0F, 0x00, 0x00, 0xC0, 0x0F, 0x00, 0x00, 0xC0, 0x07, 0x00,
+        0x00, 0xE0, 0x07, 0x00, 0x00, 0xE0, 0x03, 0x00, 0x00, 0xF0, 0x03, 0x00, 0x00, 0xF0, 0x01, 0x00,
+        0x00, 0xF0, 0x01, 0x00, 0x00, 0xF0, 0x01, 0x00, 0x00, 0xF0, 0x01, 0x00, 0x00, 0xF0, 0x01, 0x00,
+        0x00, 0xF0, 0x01, 0x00, 0x00, 0xF0, 0x01, 0x00, 0x00, 0xF0, 0x01, 0x00, 0x00, 0xF0, 0x01, 0x00,
+        0x00, 0xF0, 0x01, 0x00, 0x00, 0xF0, 0x01, 0x00, 0x00, 0xF0, 0x01, 0x00, 0x00, 0xF0, 0x01, 0x00,
+        0x00, 0xF0, 0x01, 0x00, 0x00, 0xF0, 0x01, 0x00, 0x00, 0xF0, 0x01, 0x00, 0x00, 0xF0, 0x01, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    },
+    { /* 8 */
+        0x00, 0xFE, 0x7F, 0x00, 0x80, 0xFF, 0xFF, 0x01, 0xC0, 0xFF, 0xFF, 0x03, 0xE0, 0xFF, 0xFF, 0x07,
+        0xE0, 0x07, 0xE0, 0x07, 0xF0, 0x03, 0xC0, 0x0F, 0xF0, 0x01, 0x80, 0x0F, 0xF0, 0x01, 0x80, 0x0F,
+        0xF0, 0x01, 0x80, 0x0F, 0xF0, 0x01, 0x80, 0x0F, 0xF0, 0x01, 0x80, 0x0F, 0xF0, 0x01, 0x80, 0x0F,
+        0xF0, 0x01, 0x80, 0x0F, 0xF0, 0x01, 0x80, 0x0F, 0xF0, 0x03, 0xC0, 0x0F, 0xE0, 0x07, 0xE0, 0x07,
+        0xC0, 0xFF, 0xFF, 0x03, 0x80, 0xFF, 0xFF, 0x01, 0x80, 0xFF, 0xFF, 0x01, 0xC0, 0xFF, 0xFF, 0x03,
+        0xE0, 0x07, 0xE0, 0x07, 0xF0, 0x03, 0xC0, 0x0F, 0xF0, 0x01, 0x80, 0x0F, 0xF0, 0x01, 0x80, 0x0F,
+        0xF0, 0x01, 0x80, 0x0F, 0xF0, 0x01, 0x80, 0x0F, 0xF0, 0x01, 0x80, 0x0F, 0xF0, 0x01, 0x80, 0x0F,
+        0xF0, 0x01, 0x80, 0x0F, 0xF0, 0x01, 0x80, 0x0F, 0xF0, 0x01, 0x80, 0x0F, 0xF0, 0x01, 0x80, 0x0F,
+        0xF0, 0x01, 0x80, 0x0F, 0xF0, 0x01, 0x80, 0x0F, 0xF0, 0x01, 0x80, 0x0F, 0xF0, 0x01, 0x80, 0x0F,
+        0xF0, 0x01, 0x80, 0x0F, 0xF0, 0x03, 0xC0, 0x0F, 0xE0, 0x07, 0xE0, 0x07, 0xE0, 0xFF, 0xFF, 0x07,
+        0xC0, 0xFF, 0xFF, 0x03, 0x80, 0xFF, 0xFF, 0x01, 0x00, 0xFE, 0x7F, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    },
+    { /* 9 */
+        0x00, 0xFE, 0x7F, 0x00, 0x80, 0xFF, 0xFF, 0x01, 0xC0, 0xFF, 0xFF, 0x03, 0xE0, 0xFF, 0xFF, 0x07,
+        0xE0, 0x07, 0xE0, 0x07, 0xF0, 0x03, 0xC0, 0x0F, 0xF0, 0x01, 0x80, 0x0F, 0xF0, 0x01, 0x80, 0x0F,
+        0xF0, 0x01, 0x80, 0x0F, 0xF0, 0x01, 0x80, 0x0F, 0xF0, 0x01, 0x80, 0x0F, 0xF0, 0x01, 0x80, 0x0F,
+        0xF0, 0x01, 0x80, 0x0F, 0xF0, 0x01, 0x80, 0x0F, 0xF0, 0x01, 0x80, 0x0F, 0xF0, 0x01, 0x80, 0x0F,
+        0xF0, 0x01, 0x80, 0x0F, 0xF0, 0x03, 0xC0, 0x0F, 0xE0, 0x07, 0xE0, 0x0F, 0xE0, 0xFF, 0xFF, 0x0F,
+        0xC0, 0xFF, 0xFF, 0x0F, 0x80, 0xFF, 0xBF, 0x0F, 0x00, 0xFE, 0x9F, 0x0F, 0x00, 0x00, 0x80, 0x0F,
+        0x00, 0x00, 0x80, 0x0F, 0x00, 0x00, 0x80, 0x0F, 0x00, 0x00, 0x80, 0x0F, 0x00, 0x00, 0x80, 0x0F,
+        0x00, 0x00, 0x80, 0x0F, 0x00, 0x00, 0x80, 0x0F, 0x00, 0x00, 0x80, 0x0F, 0x00, 0x00, 0x80, 0x0F,
+        0x00, 0x00, 0x80, 0x0F, 0x00, 0x00, 0x80, 0x0F, 0xF0, 0x01, 0x80, 0x0F, 0xF0, 0x01, 0x80, 0x0F,
+        0xF0, 0x01, 0x80, 0x0F, 0xF0, 0x03, 0xC0, 0x0F, 0xE0, 0x07, 0xE0, 0x07, 0xE0, 0xFF, 0xFF, 0x07,
+        0xC0, 0xFF, 0xFF, 0x03, 0x80, 0xFF, 0xFF, 0x01, 0x00, 0xFE, 0x7F, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    },
+};
@@ -19,6 +19,8 @@
  * ============================================================================ */
 #define DEBUG_MODE 1           /* Keep this - enables real sensors */
 /* #define DEBUG_LOG_TO_SD 1 */   /* Disabled for production - no SD logging */
+/* #define DEBUG_INPUT_RECORD 1 */ /* Record input sessions for tools/host/replay.c */
+/* #define DEBUG_SHADOW_ENGINES 1 */ /* Run candidate stability engines alongside production */
 
 #include <furi.h>
 #include <furi_hal.h>
@@ -28,6 +30,8 @@
 #include <input/input.h>
 #include <notification/notification.h>
 #include <notification/notification_messages.h>
+#include <storage/storage.h>
+#include <flipper_format/flipper_format.h>
 #include <stdlib.h>
 #include <math.h>
 
@@ -69,9 +73,6 @@ typedef struct {
 #ifdef DEBUG_MODE
 #include <furi_hal_subghz.h>
 #include <furi_hal_adc.h>
-#ifdef DEBUG_LOG_TO_SD
-#include <storage/storage.h>
-#endif
 #endif
 
 /* ============================================================================
@@ -81,12 +82,22 @@ typedef struct {
 #define SCREEN_WIDTH         128
 #define SCREEN_HEIGHT        64
 
-#define INPUT_QUEUE_SIZE     8
+#define INPUT_QUEUE_SIZE     16  /**< ~4 full taps of backlog while a sample is running */
+#define INPUT_PRESS_RESERVE  4   /**< Last queue slots kept for Press events */
 
 /** Sample rates - production values */
 #define SAMPLE_INTERVAL_CALIB_MS  200   /**< 5 samples/sec during calibration */
 #define SAMPLE_INTERVAL_NORMAL_MS 1000  /**< 1 sample/sec during normal (battery friendly) */
 
+/** Decimation front end: each band is read DECIM_FACTOR times per sample
+ *  interval and filtered down to the sample rate (see DECIMATION) */
+#define CIC_ORDER            3
+#define CIC_RATE             4     /**< CIC decimation, then 2 in the half-band */
+#define CIC_SCALE            256.0f  /**< dB to Q8 fixed point for the integrators */
+#define HALFBAND_TAPS        11
+#define DECIM_FACTOR         (CIC_RATE * 2)  /**< Reads per sample: 8 Hz normal, 40 Hz calibrating */
+#define DECIM_SETTLE_READS   (((CIC_ORDER + HALFBAND_TAPS) * CIC_RATE + DECIM_FACTOR - 1) / DECIM_FACTOR * DECIM_FACTOR)
+
 /** Rolling buffer size */
 #define BUFFER_SIZE          1000  /**< Rolling buffer for stability */
 #define CALIBRATION_SAMPLES  100   /**< Samples needed before stable (20 sec at 5Hz) */
@@ -110,10 +121,115 @@ typedef struct {
 #define RSSI_OFFSET          120.0f      /**< Add to RSSI to get positive dB */
 
 /** Log file path */
-#define DEBUG_LOG_PATH       EXT_PATH("apps_data/reality_clock/sensor_log.csv")
+#define DEBUG_LOG_PATH       EXT_PATH("apps_data/reality_clock/sensor_log.blk")
 #define DEBUG_LOG_DIR        EXT_PATH("apps_data/reality_clock")
+#define LOG_LINE_SIZE        300
+
+/** Block framing of the log (see debug_log_flush)
+ *  A block is written and synced when it cannot take another full line or
+ *  LOG_BLOCK_FLUSH_MS after its first row, so a crash loses at most one. */
+#define LOG_BLOCK_SIZE          2048   /**< Payload bytes per block */
+#define LOG_BLOCK_HEADER_SIZE   28     /**< "#blk <seq:8> <len:4> <crc:8>\n" */
+#define LOG_BLOCK_FLUSH_MS      10000  /**< Oldest row a pending block may hold */
+
+/** RTC anchoring of the log's epoch_ms column
+ *  The RTC only counts whole seconds, so an anchor is the tick at which a
+ *  new RTC second was observed. Re-anchoring polls briefly around the
+ *  predicted edge; +-50 ppm tick drift over 15 min is well inside the window. */
+#define LOG_ANCHOR_INTERVAL_MS    900000  /**< Re-anchor to the RTC every 15 min */
+#define LOG_ANCHOR_LEAD_MS        50      /**< Start polling this early before the predicted edge */
+#define LOG_ANCHOR_POLL_MS        100     /**< Longest periodic poll */
+#define LOG_ANCHOR_FULL_POLL_MS   1100    /**< First anchor (or after repeated misses) may wait a whole second */
+#define LOG_ANCHOR_MAX_MISSES     3       /**< Short polls missed in a row before a full one */
+
+/** Startup survey for the quietest frequency on each antenna path (see FREQUENCY SURVEY)
+ *  FREQ_BAND_* are the busiest ISM channels; they stay a candidate and the fallback. */
+#define SURVEY_GRID_POINTS      7       /**< Evenly spaced candidates per path, plus FREQ_BAND_* */
+#define SURVEY_CANDIDATES       (SURVEY_GRID_POINTS + 1)
+#define SURVEY_GRID_STEP_HZ     100000  /**< Grid frequencies are rounded to this */
+#define SURVEY_PASSES           16      /**< Reads per candidate, one per pass */
+#define SURVEY_MIN_PASSES       4       /**< Fewer and the defaults are kept */
+#define SURVEY_BUDGET_MS        1500    /**< Longest the survey may hold the radio */
+#define SURVEY_OCCUPIED_DB      6.0f    /**< A read this far above the path's floor is a transmission */
+#define SURVEY_OCCUPANCY_WEIGHT 100.0f  /**< Score (dB^2) of a candidate occupied on every read */
+#define SURVEY_RX_MA            16.0f   /**< CC1101 RX current, for the energy estimate */
+#endif
+
+#ifdef DEBUG_INPUT_RECORD
+/** Input session recording */
+#define INPUT_RECORD_DIR     EXT_PATH("apps_data/reality_clock")
+#define INPUT_RECORD_PATH    EXT_PATH("apps_data/reality_clock/input_session.txt")
+#endif
+
+#ifdef DEBUG_SHADOW_ENGINES
+/** Shadow evaluation of candidate stability engines (see SHADOW ENGINES) */
+#define SHADOW_MAX_ENGINES      5       /**< Production replica + up to 4 candidates */
+#define SHADOW_TIMELINE_LEN     16      /**< Status changes kept per engine */
+#define SHADOW_CYCLE_BUDGET     32000   /**< Cycles per sample for all engines (0.5 ms at 64 MHz) */
+#define SHADOW_CPU_MHZ          64
+#define SHADOW_LOG_VAR_INIT     0.25f   /**< ln(PHI) variance before any is measured (~4.3 dB) */
+#define SHADOW_Z_ALPHA_SLOW     0.01f   /**< zscore: baseline mean/variance */
+#define SHADOW_Z_ALPHA_FAST     0.2f    /**< zscore: smoothed current value */
+#define SHADOW_CUSUM_ALPHA      0.002f  /**< cusum: baseline mean/variance */
+#define SHADOW_CUSUM_K          0.5f    /**< cusum: slack, in standard deviations */
+#define SHADOW_CUSUM_H          8.0f    /**< cusum: decision level, in standard deviations */
 #endif
 
+/** Persistent settings (FlipperFormat), written back once input goes quiet */
+#define SETTINGS_DIR           EXT_PATH("apps_data/reality_clock")
+#define SETTINGS_PATH          EXT_PATH("apps_data/reality_clock/settings.txt")
+#define SETTINGS_FILETYPE      "Reality Clock Settings"
+#define SETTINGS_VERSION       1
+#define SETTINGS_SAVE_DELAY_MS 5000  /**< Quiet time after the last change before writing */
+
+/** Time-of-day profile (see TIME-OF-DAY PROFILE), accumulated across sessions */
+#define PROFILE_BINS             96      /**< Quarter-hour bins over 24 h */
+#define PROFILE_BIN_MINUTES      15
+#define PROFILE_CHANNELS         4       /**< LF, HF, UHF RSSI and ln(PHI) */
+#define PROFILE_MAX_WEIGHT       12600   /**< Samples per bin before old days fade (~14 days at 1 Hz) */
+#define PROFILE_MIN_WEIGHT       1800    /**< Samples before a bin is trusted (~2 days) */
+#define PROFILE_SAVE_INTERVAL_MS 3600000 /**< Write back hourly, and on exit */
+#define PROFILE_PATH             EXT_PATH("apps_data/reality_clock/profile.txt")
+#define PROFILE_TMP_PATH         EXT_PATH("apps_data/reality_clock/profile.tmp")
+#define PROFILE_FILETYPE         "Reality Clock Profile"
+#define PROFILE_VERSION          1
+
+/** Time-weighted rolling windows (see TIME WINDOWS) */
+#define TIMEWIN_BUCKET_MS    15000    /**< Held time is binned into buckets this long */
+#define TIMEWIN_BUCKETS      240      /**< Closed buckets kept: the longest window */
+#define TIMEWIN_SHORT_MS     300000   /**< 5 min */
+#define TIMEWIN_LONG_MS      3600000  /**< 1 h */
+#define TIMEWIN_COUNT        2
+#define TIMEWIN_SCALE        256.0f   /**< dB to Q8 fixed point for the integrals */
+
+/** Exact rolling windows paged to SD, by sample count (see PAGED WINDOWS) */
+#define LONGWIN_SHORT_SAMPLES 3600     /**< 1 h at 1 Hz, 10 h on the Low tier */
+#define LONGWIN_MID_SAMPLES   86400    /**< 1 day at 1 Hz */
+#define LONGWIN_MAX_SAMPLES   131072   /**< ~36 h at 1 Hz, the longest window */
+#define LONGWIN_COUNT         3
+#define LONGWIN_PAGE_SAMPLES  64       /**< Samples per SD page (384 bytes) */
+#define LONGWIN_CACHE_PAGES   8        /**< Pages held in RAM */
+#define LONGWIN_PREFETCH      8        /**< Samples ahead a window's next page is read in */
+#define LONGWIN_SCALE         128.0f   /**< dB to Q7 fixed point, as stored */
+#define LONGWIN_NO_PAGE       0xFFFF
+#define LONGWIN_PATH          EXT_PATH("apps_data/reality_clock/windows.bin")
+
+/** Battery QoS governor (see BATTERY GOVERNOR) */
+#define GOV_TIER_COUNT        4
+#define GOV_CHECK_MS          60000    /**< Re-evaluate the tier once a minute */
+#define GOV_HOLD_MS           600000   /**< Least time between target-driven steps, to measure the last one */
+#define GOV_CURRENT_ALPHA     0.2f     /**< EMA of the discharge current, per check */
+#define GOV_CHARGING_MA       1.0f     /**< Less draw than this is charging or on USB */
+#define GOV_TARGET_MARGIN     1.15f    /**< Step down when projected runtime < time left x this */
+#define GOV_TARGET_RELAX      1.3f     /**< Step back up when the tier above would last > time left x this */
+#define GOV_RUN_UNTIL_OFF     0xFFFF   /**< run_until when no target is set */
+#define GOV_RUN_UNTIL_STEP    30       /**< Minutes per LEFT/RIGHT on the Run Until screen */
+#define GOV_LOG_PATH          EXT_PATH("apps_data/reality_clock/runtime.csv")
+
+/** Cooperative I/O scheduler (see I/O SCHEDULER) */
+#define IO_SETTLE_MS          10     /**< Quiet time kept between a job and the next radio read */
+#define IO_MAX_DEFER_MS       500    /**< A job waiting this long delays the next read instead */
+
 /** Stability thresholds - based on short-term variance, not fixed baseline */
 #define HOME_THRESHOLD       98.0f       /**< Very stable readings */
 #define STABLE_THRESHOLD     95.0f       /**< Mostly stable */
@@ -132,12 +248,20 @@ typedef struct {
 #define SCREEN_INFO          3   /**< QR code / info screen */
 #define SCREEN_MENU          4   /**< Settings menu */
 #define SCREEN_BRIGHTNESS    5   /**< Brightness slider */
-#define SCREEN_COUNT         6
+#define SCREEN_RUN_UNTIL     6   /**< Battery runtime target */
+#define SCREEN_COUNT         7
+
+/** What a sample or governor check changed - screens with an on-sample refresh policy list the bits they draw */
+#define CHANGED_READINGS     (1 << 0)  /**< Band readings, PHI, stability, counters, battery */
+#define CHANGED_STATUS       (1 << 1)  /**< Dimension status or calibration state */
+#define CHANGED_PROGRESS     (1 << 2)  /**< Calibration progress */
+#define CHANGED_GOVERNOR     (1 << 3)  /**< Power tier or projected runtime (governor check) */
 
 /** Menu items */
 #define MENU_ITEM_CALIBRATE   0
 #define MENU_ITEM_BRIGHTNESS  1
-#define MENU_ITEM_COUNT       2
+#define MENU_ITEM_RUN_UNTIL   2
+#define MENU_ITEM_COUNT       3
 
 /** Brightness settings */
 #define BRIGHTNESS_MIN        0
@@ -145,8 +269,21 @@ typedef struct {
 #define BRIGHTNESS_STEP       5
 #define BRIGHTNESS_REFRESH_MS 60000  /* Reapply brightness every 60 sec to prevent firmware reset */
 
-/** Details screen */
-#define DETAILS_LINES        12
+/** Details screen: 32 lines, plus RSSI/temperature/survey and logging status in debug
+ *  builds and one line per shadow engine */
+#ifdef DEBUG_SHADOW_ENGINES
+#define DETAILS_SHADOW_LINES SHADOW_MAX_ENGINES
+#else
+#define DETAILS_SHADOW_LINES 0
+#endif
+#if defined(DEBUG_MODE) && defined(DEBUG_LOG_TO_SD)
+#define DETAILS_LINES        (35 + DETAILS_SHADOW_LINES)
+#elif defined(DEBUG_MODE)
+#define DETAILS_LINES        (34 + DETAILS_SHADOW_LINES)
+#else
+#define DETAILS_LINES        (32 + DETAILS_SHADOW_LINES)
+#endif
+#define DETAILS_LINE_CHARS   32
 #define DETAILS_VISIBLE      5
 #define LINE_HEIGHT          10
 
@@ -162,17 +299,175 @@ typedef enum {
     DimStatusCalibrating,
 } DimensionStatus;
 
+/** Work kept out of the radio's way by the I/O scheduler; bit n of io_pending */
+typedef enum {
+    IoJobBacklight,     /**< Send the brightness apply_brightness() set */
+    IoJobLogFlush,      /**< Write and sync the pending log block */
+    IoJobSettingsSave,
+    IoJobProfileSave,
+    IoJobLongWindows,   /**< Write back the finished page, read the windows' next pages */
+    IoJobCount,
+} IoJob;
+
 /** Rolling buffer for a single band */
 typedef struct {
-    float values[BUFFER_SIZE];
+    float* values;           /**< BUFFER_SIZE slots in the session arena */
     uint16_t write_idx;
     uint16_t count;
     float sum;
 } RollingBuffer;
 
+/** Running mean and variance per quarter hour and channel (see TIME-OF-DAY PROFILE) */
+typedef struct {
+    uint32_t weight[PROFILE_BINS];                /**< Samples folded in, capped at PROFILE_MAX_WEIGHT */
+    float mean[PROFILE_CHANNELS][PROFILE_BINS];
+    float m2[PROFILE_CHANNELS][PROFILE_BINS];     /**< Sum of squared deviations (Welford) */
+} TodProfile;
+
+/** LF, HF and UHF held over one TIMEWIN_BUCKET_MS bucket (see TIME WINDOWS) */
+typedef struct {
+    int32_t integral[3];     /**< Q8 dB x ms */
+    uint16_t ms;             /**< Time covered, short only in the first bucket */
+} TimeBucket;
+
+/** Running sums over the newest @c buckets closed buckets */
+typedef struct {
+    uint16_t buckets;
+    int64_t integral[3];
+    uint32_t ms;
+} TimeWindowSum;
+
+/** Time-weighted rolling averages of the three bands by duration */
+typedef struct {
+    TimeBucket* ring;        /**< TIMEWIN_BUCKETS closed buckets in the session arena */
+    uint16_t head;           /**< Slot the next closed bucket goes into */
+    uint16_t closed;         /**< Buckets closed so far, up to TIMEWIN_BUCKETS */
+    TimeBucket open;         /**< Bucket being filled */
+    uint32_t open_start;     /**< Tick the open bucket began */
+    uint32_t held_since;     /**< Tick of the latest sample */
+    int32_t held[3];         /**< Its Q8 values, held until the next one */
+    bool primed;
+    TimeWindowSum window[TIMEWIN_COUNT];
+} TimeWindows;
+
+/** LF, HF and UHF for LONGWIN_PAGE_SAMPLES samples: one page of the SD ring */
+typedef struct {
+    int16_t value[LONGWIN_PAGE_SAMPLES][3];  /**< Q7 dB */
+} LongPage;
+
+/** A page held in RAM */
+typedef struct {
+    LongPage* page;          /**< In the session arena */
+    uint16_t index;          /**< Page of the ring held, LONGWIN_NO_PAGE if none */
+    bool dirty;              /**< Not yet written back */
+    uint32_t used;           /**< LRU stamp */
+} LongPageSlot;
+
+/** Running sums over the newest @c samples samples */
+typedef struct {
+    uint32_t samples;
+    int64_t sum[3];          /**< Q7 dB */
+} LongWindowSum;
+
+/** Exact rolling averages of the three bands over up to LONGWIN_MAX_SAMPLES samples */
+typedef struct {
+    Storage* storage;        /**< Held from longwin_open() to longwin_close() */
+    File* file;              /**< LONGWIN_PATH, held open for the session */
+    LongPageSlot slot[LONGWIN_CACHE_PAGES];
+    LongWindowSum window[LONGWIN_COUNT];
+    uint32_t head;           /**< Samples added so far */
+    uint16_t file_pages;     /**< Pages written to the file at least once */
+    uint32_t lru_clock;
+    uint32_t page_reads;
+    uint32_t page_writes;
+    uint32_t sync_reads;     /**< Pages a sample had to wait for (not prefetched) */
+    uint32_t sync_writes;    /**< Dirty pages evicted before their write-back job ran */
+    bool failed;             /**< No SD, or an SD error: stopped for the session */
+} LongWindows;
+
+/** What the app gives up at one battery tier (see BATTERY GOVERNOR) */
+typedef struct {
+    const char* name;
+    uint8_t default_pct;          /**< Charge at or below which the tier starts, unless configured */
+    uint16_t sample_interval_ms;  /**< Once calibrated */
+    uint8_t brightness_cap;       /**< Percent; the user's setting is kept and restored */
+    bool window_averages;         /**< PHI from the 5 min window; the sample rings are not written */
+    bool timed_log_flush;         /**< SD log blocks also flushed by age, not only when full */
+} GovTier;
+
+/** CIC + half-band decimator for one band (see DECIMATION) */
+typedef struct {
+    uint32_t integrator[CIC_ORDER];  /**< Wrap around freely; only differences reach the output */
+    uint32_t comb_delay[CIC_ORDER];
+    float history[HALFBAND_TAPS];    /**< CIC outputs, newest at head */
+    uint8_t head;
+    uint8_t cic_phase;               /**< Reads since the last CIC output */
+    uint8_t halfband_phase;          /**< CIC outputs since the last decimated sample */
+    bool primed;
+} Decimator;
+
+#ifdef DEBUG_SHADOW_ENGINES
+/** What every shadow engine sees of a sample */
+typedef struct {
+    float phi;      /**< PHI of the buffer averages, as production uses */
+    float phi_raw;  /**< PHI of this sample alone */
+    float phi_tod_z;  /**< phi against the time-of-day profile, NAN while untrained */
+} ShadowInput;
+
+/** Working state of one engine; each uses the fields it needs */
+typedef struct {
+    float mean;
+    float fast;
+    float var;
+    float cusum_pos;
+    float cusum_neg;
+} ShadowEngineState;
+
+/** A candidate: primed on the calibration sample, then updated every sample */
+typedef struct {
+    const char* name;
+    void (*prime)(ShadowEngineState* s, const ShadowInput* in);
+    DimensionStatus (*update)(ShadowEngineState* s, const ShadowInput* in);
+} ShadowEngineDef;
+
+/** Status timeline entry */
+typedef struct {
+    uint32_t sample;          /**< total_samples when the status changed */
+    DimensionStatus status;
+} ShadowChange;
+
+/** One engine's state and scorecard */
+typedef struct {
+    ShadowEngineState state;
+    DimensionStatus status;
+    uint32_t samples;                     /**< Samples evaluated */
+    uint32_t skipped;                     /**< Samples skipped to stay within SHADOW_CYCLE_BUDGET */
+    uint32_t status_samples[DimStatusCalibrating];  /**< Samples spent in each status */
+    uint32_t transitions;
+    uint32_t agree;                       /**< Same status as production */
+    uint32_t alarm_agree;                 /**< Both or neither Unstable/Foreign */
+    uint64_t cycles;                      /**< CPU cycles spent in update() */
+    uint32_t cycles_last;
+    uint32_t cycles_max;
+    ShadowChange timeline[SHADOW_TIMELINE_LEN];  /**< Latest changes, ring */
+    uint8_t timeline_head;
+    uint8_t timeline_count;
+} ShadowEngine;
+#endif
+
+/** One heap block holding every per-session buffer (see ARENA) */
+typedef struct {
+    uint8_t* base;           /**< NULL while measuring */
+    size_t size;
+    size_t used;
+} Arena;
+
 typedef struct {
     bool is_running;
     bool is_calibrated;
+    bool recalibrating;       /**< Background recalibration running, old baseline still in use */
+    uint16_t recal_samples;   /**< Samples it has gathered into the rings */
+    uint16_t recalibrations;  /**< Completed this session */
 
     uint8_t current_screen;
     uint8_t previous_screen;  /**< For returning from menu */
@@ -184,17 +479,50 @@ typedef struct {
     NotificationAppInternal* notification; /**< Notification service (internal cast) */
     float original_brightness;             /**< Saved brightness to restore on exit */
 
+    /** Settings as last read from or written to SD (see SETTINGS) */
+    uint8_t saved_brightness;
+    uint8_t saved_screen;
+    uint16_t saved_run_until;
+    bool settings_save_pending;   /**< A write-back is scheduled */
+    uint32_t settings_save_due;   /**< Tick of the scheduled write-back */
+
+    /** Input path - written by input_callback on the input thread */
+    FuriMessageQueue* event_queue;
+    volatile bool input_repeat_queued;     /**< A Repeat event is waiting in event_queue */
+    volatile uint32_t input_coalesced;     /**< Repeats merged into the one already queued */
+    volatile uint32_t input_dropped;       /**< Events lost to a full queue */
+    volatile uint32_t input_queue_peak;    /**< Deepest event_queue seen */
+
+    /** Session arena: this struct, the band rings and the text buffers */
+    Arena arena;
+    char (*details_text)[DETAILS_LINE_CHARS];  /**< DETAILS_LINES lines, render thread only */
+
     /** Rolling buffers for each band */
     RollingBuffer lf_buffer;
     RollingBuffer hf_buffer;
     RollingBuffer uhf_buffer;
 
+    /** Time-weighted averages by duration, beside the per-sample buffers */
+    TimeWindows windows;
+    float phi_window[TIMEWIN_COUNT];       /**< PHI of each window's band averages */
+    uint32_t window_ms[TIMEWIN_COUNT];     /**< Time each window covers so far */
+
+    /** Exact averages over far more samples than the rings, paged to SD */
+    LongWindows long_windows;
+    float phi_long[LONGWIN_COUNT];         /**< PHI of each window's band averages */
+    uint32_t long_samples[LONGWIN_COUNT];  /**< Samples each window covers so far */
+
     /** Averaged readings (from buffers) */
     float lf_avg;
     float hf_avg;
     float uhf_avg;
 
-    /** Current raw readings (for display) */
+    /** Decimators from the read rate down to the sample rate */
+    Decimator lf_decim;
+    Decimator hf_decim;
+    Decimator uhf_decim;
+
+    /** Current readings, one decimated sample per band (for display) */
     float lf_raw;
     float hf_raw;
     float uhf_raw;
@@ -207,39 +535,193 @@ typedef struct {
 
     DimensionStatus status;
 
+    /** Time-of-day profile */
+    TodProfile* profile;     /**< In the session arena */
+    uint8_t profile_bin;     /**< Quarter hour of the latest sample */
+    float phi_tod_z;         /**< ln(PHI) against its profile bin, NAN until the bin is trusted */
+    bool profile_dirty;      /**< Changed since the last write-back */
+    uint32_t profile_save_due;
+    Storage* profile_storage;    /**< Held from profile_open() to profile_close() */
+    FlipperFormat* profile_file; /**< so the hourly save never allocates */
+
     uint32_t total_samples;
     float voltage;
     float current_ma;
 
+    /** Battery governor */
+    uint8_t gov_tier;                     /**< Index into gov_tiers, 0 = everything on */
+    uint8_t gov_target_tier;              /**< Tier the runtime target asks for */
+    uint8_t gov_tier_pct[GOV_TIER_COUNT]; /**< Charge thresholds, from settings */
+    uint16_t run_until;                   /**< Target, minutes after midnight, or GOV_RUN_UNTIL_OFF */
+    uint32_t gov_target_epoch;            /**< RTC time run_until next falls on, 0 once reached */
+    uint32_t gov_check_due;
+    uint32_t gov_step_tick;               /**< Tick of the last target-driven step */
+    uint32_t gov_tier_tick;               /**< Tick the current tier began */
+    float gov_draw_ma;                    /**< Smoothed discharge current, 0 when charging */
+    float gov_tier_draw_ma[GOV_TIER_COUNT];  /**< Settled draw last measured at each tier, 0 if never */
+    uint32_t gov_projected_s;             /**< Runtime left at gov_draw_ma, UINT32_MAX when charging */
+    uint32_t gov_start_epoch;
+    uint8_t gov_start_pct;
+    uint32_t gov_first_projected_s;       /**< First projection of the session */
+    uint16_t gov_tier_changes;
+    bool gov_target_met;                  /**< run_until came with charge to spare */
+    uint8_t gov_target_met_pct;           /**< Charge left when it did */
+    Storage* gov_storage;                 /**< Held from governor_start() to governor_log_session() */
+    File* gov_log_file;                   /**< so the exit never allocates */
+
+    /** Cooperative I/O scheduler */
+    uint8_t io_pending;                   /**< Bit per IoJob waiting for a gap between reads */
+    uint8_t io_waiting;                   /**< Pending jobs already passed over for a short gap */
+    uint32_t io_requested[IoJobCount];    /**< Tick each pending job was asked for */
+    uint16_t io_cost_ms[IoJobCount];      /**< Recent worst run time per job */
+    uint32_t io_last_end;                 /**< Tick the last job finished */
+    uint8_t io_recent;                    /**< Jobs that finished within IO_SETTLE_MS of io_last_end */
+    uint8_t io_read_tag;                  /**< Jobs near a read of the sample being decimated */
+    uint8_t io_sample_tag;                /**< The same for the last sample (logged as io_near) */
+    uint32_t io_deferred;                 /**< Jobs that waited for a gap */
+    uint32_t io_delayed_reads;            /**< Reads pushed back for a job past IO_MAX_DEFER_MS */
+    uint32_t io_tagged_samples;
+    float io_dev_mean[2];                 /**< Mean |raw - avg| (dB), clean and tagged samples */
+    uint32_t io_dev_count[2];
+
+    /** Memory telemetry, refreshed every sample */
+    uint32_t heap_free;       /**< Free heap (all of it, not just this app's share) */
+    uint32_t heap_min_free;   /**< Lowest free heap since boot */
+    uint32_t heap_free_start; /**< Free heap when the main loop started */
+    uint32_t stack_free;      /**< App thread stack never used so far (high-water mark) */
+
 #ifdef DEBUG_MODE
     /** Debug: Real sensor data */
     float temperature;       /**< Internal die temperature in °C */
-    float rssi_315;          /**< Real RSSI at 315 MHz */
-    float rssi_433;          /**< Real RSSI at 433 MHz */
-    float rssi_868;          /**< Real RSSI at 868 MHz */
+    float rssi_315;          /**< Real RSSI at 315 MHz, decimated */
+    float rssi_433;          /**< Real RSSI at 433 MHz, decimated */
+    float rssi_868;          /**< Real RSSI at 868 MHz, decimated */
     uint32_t start_time;     /**< Session start timestamp */
 
+    /** Debug: Frequencies chosen by the startup survey */
+    uint32_t band_freq[3];   /**< LF, HF, UHF path, in Hz */
+    uint16_t survey_reads;   /**< RSSI reads the survey made */
+    uint32_t survey_ms;      /**< Radio time it took */
+
     /** Debug: Hardware handles */
     FuriHalAdcHandle* adc_handle;
 #ifdef DEBUG_LOG_TO_SD
     Storage* storage;
     File* log_file;
+    char* log_block;         /**< Header + LOG_BLOCK_SIZE bytes in the session arena */
+    uint16_t log_block_used; /**< Payload bytes pending in log_block */
+    uint32_t log_block_seq;  /**< Sequence number of the next block */
+    uint32_t log_block_start;    /**< Tick of the oldest pending row */
     bool log_active;
+    uint32_t anchor_tick;    /**< Tick at which RTC second anchor_epoch began */
+    uint32_t anchor_epoch;   /**< RTC Unix time at anchor_tick */
+    uint32_t anchor_due;     /**< Tick to start polling for the next anchor */
+    uint8_t anchor_misses;   /**< Short polls missed since the last edge, LOG_ANCHOR_MAX_MISSES to poll fully */
+    uint32_t anchor_polls;       /**< Anchor polls run from the main loop */
+    uint32_t anchor_full_polls;  /**< Of them, full-second ones */
 #endif
 #endif
+
+#ifdef DEBUG_SHADOW_ENGINES
+    /** Debug: Candidate stability engines fed the same samples as production */
+    ShadowEngine shadow[SHADOW_MAX_ENGINES];
+#endif
+
+#ifdef DEBUG_INPUT_RECORD
+    /** Debug: Input session recorder */
+    Storage* record_storage;
+    File* record_file;
+    uint32_t record_last_tick;
+#endif
 } RealityClockState;
 
+/** When a screen needs a redraw, besides on entry and after its own input */
+typedef enum {
+    ScreenRefreshStatic,    /**< Never - content only changes through input */
+    ScreenRefreshOnSample,  /**< After a sample or governor check that changed one of its dependencies */
+    ScreenRefreshOnTimer,   /**< At a fixed rate, independent of sampling */
+} ScreenRefresh;
+
+/** Screen registry entry */
+typedef struct {
+    void (*draw)(Canvas* canvas, RealityClockState* state);
+    void (*input)(RealityClockState* state, InputEvent* event);
+    ScreenRefresh refresh;
+    uint8_t depends;      /**< CHANGED_* mask (ScreenRefreshOnSample) */
+    uint8_t refresh_hz;   /**< Redraw rate (ScreenRefreshOnTimer) */
+    bool in_carousel;     /**< Reachable with LEFT/RIGHT */
+} ScreenDef;
+
+/** Queue and run I/O (see I/O SCHEDULER, next to the main loop) */
+static void io_request(RealityClockState* state, IoJob job);
+static void io_run_job(RealityClockState* state, IoJob job);
+
+/* ============================================================================
+ * ARENA
+ * ============================================================================
+ * Every per-session buffer is carved out of one allocation made in
+ * state_alloc() and released in one free() in state_free(), so the main loop
+ * never touches the heap and a week-long session cannot fragment it.
+ * session_layout() is the single list of slices: run once against an empty
+ * arena it measures the exact size, run again it hands out the pointers.
+ */
+
+#define ARENA_ALIGN 8
+
+typedef struct {
+    RealityClockState* state;
+    float* band_values[3];   /**< LF, HF, UHF rings */
+    TimeBucket* window_ring;
+    LongPage* long_pages;    /**< LONGWIN_CACHE_PAGES */
+    TodProfile* profile;
+    char (*details_text)[DETAILS_LINE_CHARS];
+#if defined(DEBUG_MODE) && defined(DEBUG_LOG_TO_SD)
+    char* log_block;
+#endif
+} SessionLayout;
+
+static void* arena_take(Arena* arena, size_t size) {
+    size_t rounded = (size + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1);
+    if(arena->base == NULL) {
+        arena->used += rounded;
+        return NULL;
+    }
+    furi_check(arena->used + rounded <= arena->size);
+    void* slice = arena->base + arena->used;
+    arena->used += rounded;
+    return slice;
+}
+
+static void session_layout(Arena* arena, SessionLayout* layout) {
+    layout->state = arena_take(arena, sizeof(RealityClockState));
+    for(int i = 0; i < 3; i++) {
+        layout->band_values[i] = arena_take(arena, BUFFER_SIZE * sizeof(float));
+    }
+    layout->window_ring = arena_take(arena, TIMEWIN_BUCKETS * sizeof(TimeBucket));
+    layout->long_pages = arena_take(arena, LONGWIN_CACHE_PAGES * sizeof(LongPage));
+    layout->profile = arena_take(arena, sizeof(TodProfile));
+    layout->details_text = arena_take(arena, DETAILS_LINES * DETAILS_LINE_CHARS);
+#if defined(DEBUG_MODE) && defined(DEBUG_LOG_TO_SD)
+    layout->log_block = arena_take(arena, LOG_BLOCK_HEADER_SIZE + LOG_BLOCK_SIZE);
+#endif
+}
+
 /* ============================================================================
  * ROLLING BUFFER
  * ============================================================================ */
 
-static void buffer_init(RollingBuffer* buf) {
-    memset(buf->values, 0, sizeof(buf->values));
+static void buffer_reset(RollingBuffer* buf) {
+    memset(buf->values, 0, BUFFER_SIZE * sizeof(float));
     buf->write_idx = 0;
     buf->count = 0;
     buf->sum = 0.0f;
 }
 
+static void buffer_init(RollingBuffer* buf, float* values) {
+    buf->values = values;
+    buffer_reset(buf);
+}
+
 static void buffer_add(RollingBuffer* buf, float value) {
     /* Subtract old value from sum if buffer is full */
     if(buf->count >= BUFFER_SIZE) {
@@ -261,189 +743,1092 @@ static float buffer_average(RollingBuffer* buf) {
     return buf->sum / (float)buf->count;
 }
 
-/* ============================================================================
- * HARDWARE ENTROPY (used only in simulated mode)
- * ============================================================================ */
-
-#ifndef DEBUG_MODE
-static float get_entropy_float(void) {
-    uint32_t val;
-    furi_hal_random_fill_buf((uint8_t*)&val, sizeof(val));
-    return (float)(val & 0xFFFF) / 65536.0f;
+static void buffer_reverse(float* values, uint16_t from, uint16_t to) {
+    while(from + 1 < to) {
+        float value = values[from];
+        values[from++] = values[--to];
+        values[to] = value;
+    }
 }
 
-static float get_timing_jitter(void) {
-    uint32_t t1 = furi_get_tick();
-    furi_delay_us(1);
-    uint32_t t2 = furi_get_tick();
-    return ((float)((t2 - t1) ^ (t1 & 0xFF)) / 1000.0f) - 0.5f;
+/**
+ * @brief Keep only the latest @p keep values, as if they were the first ones added
+ *
+ * Rotates the ring (three reversals, no scratch memory) so they start at
+ * slot 0, clears the rest and recomputes the sum from them.
+ */
+static void buffer_keep_latest(RollingBuffer* buf, uint16_t keep) {
+    if(keep > buf->count) keep = buf->count;
+    uint16_t start = (uint16_t)((buf->write_idx + BUFFER_SIZE - keep) % BUFFER_SIZE);
+
+    buffer_reverse(buf->values, 0, start);
+    buffer_reverse(buf->values, start, BUFFER_SIZE);
+    buffer_reverse(buf->values, 0, BUFFER_SIZE);
+    memset(buf->values + keep, 0, (BUFFER_SIZE - keep) * sizeof(float));
+
+    buf->write_idx = keep % BUFFER_SIZE;
+    buf->count = keep;
+    buf->sum = 0.0f;
+    for(uint16_t i = 0; i < keep; i++) buf->sum += buf->values[i];
 }
-#endif
 
 /* ============================================================================
- * SENSOR READINGS - Raw with natural variation (SIMULATED - used when DEBUG_MODE is off)
- * ============================================================================ */
+ * TIME WINDOWS
+ * ============================================================================
+ * The rolling buffers weigh every sample alike, so "the last 1000 samples"
+ * is 200 s while calibrating, 1000 s after, and anything in between when
+ * input or SD writes delay the loop. These windows are by duration instead:
+ * each sample's value is held until the next sample and integrated over the
+ * time it was held, so the average is time-weighted whatever the rate.
+ *
+ * An hour of samples does not fit in RAM, so the held time goes into
+ * TIMEWIN_BUCKET_MS buckets instead (integer Q8 dB x ms, so the running sums
+ * never drift). Each window keeps running sums over its newest closed
+ * buckets, updated as a bucket closes: O(1) per sample, plus O(windows)
+ * every TIMEWIN_BUCKET_MS. A query adds the open bucket and takes off the
+ * share of the oldest bucket that has slid out, assuming it was uniform,
+ * so the window covers exactly its duration once it has filled.
+ */
 
-#ifndef DEBUG_MODE
-static float read_lf_raw(void) {
-    float base = -42.0f;
-    float variation = get_entropy_float() * 8.0f - 4.0f;
-    float jitter = get_timing_jitter() * 1.5f;
-    return base + variation + jitter;
-}
+static const uint32_t timewin_duration_ms[TIMEWIN_COUNT] = {TIMEWIN_SHORT_MS, TIMEWIN_LONG_MS};
 
-static float read_hf_raw(void) {
-    float base = -58.0f;
-    float variation = get_entropy_float() * 6.0f - 3.0f;
-    float jitter = get_timing_jitter() * 1.2f;
-    return base + variation + jitter;
+_Static_assert(TIMEWIN_LONG_MS / TIMEWIN_BUCKET_MS <= TIMEWIN_BUCKETS, "raise TIMEWIN_BUCKETS");
+
+static void timewin_init(TimeWindows* tw, TimeBucket* ring) {
+    memset(tw, 0, sizeof(*tw));
+    tw->ring = ring;
+    for(int w = 0; w < TIMEWIN_COUNT; w++) {
+        tw->window[w].buckets = timewin_duration_ms[w] / TIMEWIN_BUCKET_MS;
+    }
 }
 
-static float read_uhf_raw(void) {
-    float base = -70.0f;
-    float variation = get_entropy_float() * 10.0f - 5.0f;
-    float jitter = get_timing_jitter() * 2.0f;
-    return base + variation + jitter;
+/** Move the open bucket into the ring and slide every window by one bucket */
+static void timewin_close(TimeWindows* tw) {
+    for(int w = 0; w < TIMEWIN_COUNT; w++) {
+        TimeWindowSum* sum = &tw->window[w];
+        for(int b = 0; b < 3; b++) sum->integral[b] += tw->open.integral[b];
+        sum->ms += tw->open.ms;
+
+        /* The bucket that just left this window; not yet overwritten even
+           when the window spans the whole ring */
+        if(tw->closed >= sum->buckets) {
+            const TimeBucket* old = &tw->ring[(tw->head + TIMEWIN_BUCKETS - sum->buckets) % TIMEWIN_BUCKETS];
+            for(int b = 0; b < 3; b++) sum->integral[b] -= old->integral[b];
+            sum->ms -= old->ms;
+        }
+    }
+
+    tw->ring[tw->head] = tw->open;
+    tw->head = (tw->head + 1) % TIMEWIN_BUCKETS;
+    if(tw->closed < TIMEWIN_BUCKETS) tw->closed++;
+    memset(&tw->open, 0, sizeof(tw->open));
 }
-#endif
 
-/* ============================================================================
- * REAL SENSOR READINGS (DEBUG_MODE only)
- * Uses actual SubGHz radio RSSI and internal temperature sensor
- * ============================================================================ */
+/** Integrate the held values up to @p until, closing buckets on the way */
+static void timewin_hold(TimeWindows* tw, uint32_t until) {
+    for(;;) {
+        uint32_t bucket_end = tw->open_start + TIMEWIN_BUCKET_MS;
+        bool closes = (int32_t)(until - bucket_end) >= 0;
+        uint32_t end = closes ? bucket_end : until;
+        uint32_t ms = end - tw->held_since;
+
+        for(int b = 0; b < 3; b++) tw->open.integral[b] += tw->held[b] * (int32_t)ms;
+        tw->open.ms += ms;
+        tw->held_since = end;
+        if(!closes) return;
+
+        timewin_close(tw);
+        tw->open_start = bucket_end;
+    }
+}
 
-#ifdef DEBUG_MODE
+/**
+ * @brief Add a sample taken at @p now; it holds until the next one
+ */
+static void timewin_add(TimeWindows* tw, uint32_t now, float lf, float hf, float uhf) {
+    if(tw->primed) {
+        timewin_hold(tw, now);
+    } else {
+        tw->open_start = now;
+        tw->held_since = now;
+        tw->primed = true;
+    }
+    tw->held[0] = (int32_t)lroundf(lf * TIMEWIN_SCALE);
+    tw->held[1] = (int32_t)lroundf(hf * TIMEWIN_SCALE);
+    tw->held[2] = (int32_t)lroundf(uhf * TIMEWIN_SCALE);
+}
 
 /**
- * @brief Read real RSSI at specified frequency using SubGHz radio
- * @param frequency Frequency in Hz (e.g., 433920000 for 433.92 MHz)
- * @return RSSI value in dBm
+ * @brief Time-weighted average of each band over window @p w, up to @p now
+ * @param avg LF, HF, UHF averages in dB (left alone while nothing is covered)
+ * @return Time covered in ms: the window's duration once it has filled
  */
-static float read_real_rssi(uint32_t frequency) {
-    /* Set frequency and appropriate antenna path */
-    furi_hal_subghz_set_frequency_and_path(frequency);
+static uint32_t timewin_average(const TimeWindows* tw, int w, uint32_t now, float avg[3]) {
+    const TimeWindowSum* sum = &tw->window[w];
+    if(!tw->primed) return 0;
+
+    /* The latest sample counts up to now, even though it has not been added yet */
+    uint32_t held_ms = now - tw->held_since;
+    int64_t integral[3];
+    uint32_t ms = sum->ms + tw->open.ms + held_ms;
+    for(int b = 0; b < 3; b++) {
+        integral[b] = sum->integral[b] + tw->open.integral[b] + (int64_t)tw->held[b] * held_ms;
+    }
 
-    /* Switch to RX mode */
-    furi_hal_subghz_rx();
+    /* The oldest bucket has partly slid out by as much as the open one has filled */
+    if(tw->closed >= sum->buckets) {
+        const TimeBucket* oldest = &tw->ring[(tw->head + TIMEWIN_BUCKETS - sum->buckets) % TIMEWIN_BUCKETS];
+        uint32_t slid = now - tw->open_start;
+        if(slid > TIMEWIN_BUCKET_MS) slid = TIMEWIN_BUCKET_MS;
+        for(int b = 0; b < 3; b++) integral[b] -= (int64_t)oldest->integral[b] * slid / TIMEWIN_BUCKET_MS;
+        ms -= (uint32_t)((uint64_t)oldest->ms * slid / TIMEWIN_BUCKET_MS);
+    }
 
-    /* Small delay for RSSI to stabilize */
-    furi_delay_us(500);
+    if(ms == 0) return 0;
+    for(int b = 0; b < 3; b++) avg[b] = (float)integral[b] / (float)ms / TIMEWIN_SCALE;
+    return ms;
+}
 
-    /* Read RSSI */
-    float rssi = furi_hal_subghz_get_rssi();
+/* ============================================================================
+ * PAGED WINDOWS
+ * ============================================================================
+ * The rings stop at 1000 samples because every sample lives in RAM. These
+ * windows keep every sample for up to LONGWIN_MAX_SAMPLES (~36 h at 1 Hz) in
+ * a ring file on the SD card instead, as LONGWIN_PAGE_SAMPLES-sample pages of
+ * Q7 dB, with LONGWIN_CACHE_PAGES of them held in RAM (least recently used
+ * goes first). Each window keeps integer running sums, so a sample adds
+ * itself and takes off the one sample leaving each window: only the head
+ * page and the page of each window's expiring sample are touched, and the
+ * averages are exact however long the window.
+ *
+ * The windows are the last N samples, not a duration: the span follows the
+ * sample interval (0.2 s calibrating, 1 s normally, up to 10 s on the
+ * governor's tiers). Duration-based averages are the TIME WINDOWS above.
+ *
+ * The ring is a page longer than the longest window, so everything in the
+ * head page has expired by the time the head gets there and it starts from
+ * zeros without a read. The card is used from the IoJobLongWindows job:
+ * a finished head page is written back, and LONGWIN_PREFETCH samples before
+ * a window's expiring sample moves into a new page, that page is read in.
+ * That is one write and at most LONGWIN_COUNT reads per LONGWIN_PAGE_SAMPLES
+ * samples. A sample only waits for the card if the job has not run in time
+ * (sync_reads). The file is scratch: created empty each session and removed
+ * on exit.
+ */
 
-    /* Return to idle */
-    furi_hal_subghz_idle();
+#define LONGWIN_RING_PAGES   ((LONGWIN_MAX_SAMPLES + LONGWIN_PAGE_SAMPLES - 1) / LONGWIN_PAGE_SAMPLES + 1)
+#define LONGWIN_RING_SAMPLES (LONGWIN_RING_PAGES * LONGWIN_PAGE_SAMPLES)
 
-    return rssi;
+static const uint32_t longwin_samples[LONGWIN_COUNT] = {
+    LONGWIN_SHORT_SAMPLES, LONGWIN_MID_SAMPLES, LONGWIN_MAX_SAMPLES};
+
+_Static_assert(LONGWIN_RING_PAGES < LONGWIN_NO_PAGE, "raise LONGWIN_PAGE_SAMPLES");
+_Static_assert(LONGWIN_PREFETCH < LONGWIN_PAGE_SAMPLES, "LONGWIN_PREFETCH must be under a page");
+/* The head page, plus each window's current and next page */
+_Static_assert(2 * LONGWIN_COUNT + 1 <= LONGWIN_CACHE_PAGES, "raise LONGWIN_CACHE_PAGES");
+
+static int16_t longwin_quantize(float db) {
+    float q = roundf(db * LONGWIN_SCALE);
+    if(q > (float)INT16_MAX) q = (float)INT16_MAX;
+    if(q < (float)INT16_MIN) q = (float)INT16_MIN;
+    return (int16_t)q;
+}
+
+static void longwin_init(LongWindows* lw, LongPage* pages) {
+    memset(lw, 0, sizeof(*lw));
+    for(int i = 0; i < LONGWIN_CACHE_PAGES; i++) {
+        lw->slot[i].page = &pages[i];
+        lw->slot[i].index = LONGWIN_NO_PAGE;
+    }
+    for(int w = 0; w < LONGWIN_COUNT; w++) lw->window[w].samples = longwin_samples[w];
+    lw->failed = true;  /* Until longwin_open() has the file */
 }
 
 /**
- * @brief Read internal die temperature from STM32 ADC
- * @param adc_handle ADC handle (must be acquired and configured)
- * @return Temperature in degrees Celsius
+ * @brief Create LONGWIN_PATH and hold it open
  */
-static float read_real_temperature(FuriHalAdcHandle* adc_handle) {
-    if(adc_handle == NULL) return 0.0f;
+static void longwin_open(LongWindows* lw) {
+    lw->storage = furi_record_open(RECORD_STORAGE);
+    storage_common_mkdir(lw->storage, SETTINGS_DIR);
+    lw->file = storage_file_alloc(lw->storage);
+    if(storage_file_open(lw->file, LONGWIN_PATH, FSAM_READ_WRITE, FSOM_CREATE_ALWAYS)) {
+        lw->failed = false;
+    } else {
+        FURI_LOG_W("RealityClock", "Cannot open %s", LONGWIN_PATH);
+    }
+}
 
-    /* Read temperature sensor channel */
-    uint16_t raw_temp = furi_hal_adc_read(adc_handle, FuriHalAdcChannelTEMPSENSOR);
+static void longwin_fail(LongWindows* lw) {
+    FURI_LOG_W("RealityClock", "Paged windows stopped: %s failed", LONGWIN_PATH);
+    lw->failed = true;
+}
 
-    /* Convert to temperature */
-    return furi_hal_adc_convert_temp(adc_handle, raw_temp);
+static bool longwin_write_back(LongWindows* lw, LongPageSlot* slot) {
+    if(!storage_file_seek(lw->file, (uint32_t)slot->index * sizeof(LongPage), true) ||
+       storage_file_write(lw->file, slot->page, sizeof(LongPage)) != sizeof(LongPage)) {
+        longwin_fail(lw);
+        return false;
+    }
+    slot->dirty = false;
+    lw->page_writes++;
+    if(slot->index >= lw->file_pages) lw->file_pages = slot->index + 1;
+    return true;
 }
 
 /**
- * @brief Read all real sensor bands
- * Band mapping for "dimensional" theme:
- *   - "LF" band  = 315 MHz RSSI (lower frequency)
- *   - "HF" band  = 433 MHz RSSI (mid frequency)
- *   - "UHF" band = 868 MHz RSSI (higher frequency)
+ * @brief The cache slot holding page @p index, evicting the least recently used
+ * @param load Read the page from the file if it has been written; zeros otherwise
+ * @return NULL after an SD error
  */
-static void read_real_sensors(RealityClockState* state) {
-    /* Read RSSI at each frequency band */
-    state->rssi_315 = read_real_rssi(FREQ_BAND_1);
-    state->rssi_433 = read_real_rssi(FREQ_BAND_2);
-    state->rssi_868 = read_real_rssi(FREQ_BAND_3);
-
-    /* Map to LF/HF/UHF for display consistency */
-    state->lf_raw = state->rssi_315;
-    state->hf_raw = state->rssi_433;
-    state->uhf_raw = state->rssi_868;
+static LongPageSlot* longwin_page(LongWindows* lw, uint16_t index, bool load) {
+    LongPageSlot* victim = &lw->slot[0];
+    for(int i = 0; i < LONGWIN_CACHE_PAGES; i++) {
+        LongPageSlot* slot = &lw->slot[i];
+        if(slot->index == index) {
+            slot->used = ++lw->lru_clock;
+            return slot;
+        }
+        if(slot->used < victim->used) victim = slot;
+    }
 
-    /* Read temperature */
-    state->temperature = read_real_temperature(state->adc_handle);
+    if(victim->dirty) {
+        lw->sync_writes++;
+        if(!longwin_write_back(lw, victim)) return NULL;
+    }
+    victim->index = LONGWIN_NO_PAGE;
+    if(load && index < lw->file_pages) {
+        if(!storage_file_seek(lw->file, (uint32_t)index * sizeof(LongPage), true) ||
+           storage_file_read(lw->file, victim->page, sizeof(LongPage)) != sizeof(LongPage)) {
+            longwin_fail(lw);
+            return NULL;
+        }
+        lw->page_reads++;
+    } else {
+        memset(victim->page, 0, sizeof(LongPage));
+    }
+    victim->index = index;
+    victim->used = ++lw->lru_clock;
+    return victim;
 }
 
-#ifdef DEBUG_LOG_TO_SD
 /**
- * @brief Initialize SD card logging
+ * @brief Add a sample to every window
+ * @return true when IoJobLongWindows should run: a page has filled, or a
+ * window's next page is due for prefetch
  */
-static bool debug_log_init(RealityClockState* state) {
-    state->storage = furi_record_open(RECORD_STORAGE);
-    if(!state->storage) return false;
+static bool longwin_add(LongWindows* lw, float lf, float hf, float uhf) {
+    if(lw->failed) return false;
+    int16_t value[3] = {longwin_quantize(lf), longwin_quantize(hf), longwin_quantize(uhf)};
+
+    /* Take off the sample leaving each full window */
+    for(int w = 0; w < LONGWIN_COUNT; w++) {
+        LongWindowSum* sum = &lw->window[w];
+        if(lw->head < sum->samples) continue;
+        uint32_t old = (lw->head - sum->samples) % LONGWIN_RING_SAMPLES;
+        uint32_t reads = lw->page_reads;
+        LongPageSlot* slot = longwin_page(lw, (uint16_t)(old / LONGWIN_PAGE_SAMPLES), true);
+        if(slot == NULL) return false;
+        if(lw->page_reads != reads) lw->sync_reads++;
+        for(int b = 0; b < 3; b++) sum->sum[b] -= slot->page->value[old % LONGWIN_PAGE_SAMPLES][b];
+    }
 
-    /* Create directory if it doesn't exist */
-    storage_common_mkdir(state->storage, DEBUG_LOG_DIR);
+    /* A head page is only read back if it was evicted part-way */
+    uint32_t pos = lw->head % LONGWIN_RING_SAMPLES;
+    LongPageSlot* slot =
+        longwin_page(lw, (uint16_t)(pos / LONGWIN_PAGE_SAMPLES), pos % LONGWIN_PAGE_SAMPLES != 0);
+    if(slot == NULL) return false;
+    memcpy(slot->page->value[pos % LONGWIN_PAGE_SAMPLES], value, sizeof(value));
+    slot->dirty = true;
+    for(int w = 0; w < LONGWIN_COUNT; w++) {
+        for(int b = 0; b < 3; b++) lw->window[w].sum[b] += value[b];
+    }
+    lw->head++;
+
+    bool job = lw->head % LONGWIN_PAGE_SAMPLES == 0;
+    uint32_t ahead = lw->head + LONGWIN_PREFETCH;
+    for(int w = 0; w < LONGWIN_COUNT; w++) {
+        if(ahead >= lw->window[w].samples &&
+           (ahead - lw->window[w].samples) % LONGWIN_PAGE_SAMPLES == 0) {
+            job = true;
+        }
+    }
+    return job;
+}
 
-    /* Open log file for append */
-    state->log_file = storage_file_alloc(state->storage);
-    if(!storage_file_open(state->log_file, DEBUG_LOG_PATH, FSAM_WRITE, FSOM_OPEN_APPEND)) {
-        storage_file_free(state->log_file);
-        state->log_file = NULL;
-        furi_record_close(RECORD_STORAGE);
-        state->storage = NULL;
-        return false;
+/**
+ * @brief IoJobLongWindows: write back finished pages, then make sure the page
+ * holding each window's sample LONGWIN_PREFETCH samples from now is in RAM
+ */
+static void longwin_service(LongWindows* lw) {
+    if(lw->failed) return;
+    uint16_t head_page = (uint16_t)(lw->head % LONGWIN_RING_SAMPLES / LONGWIN_PAGE_SAMPLES);
+    for(int i = 0; i < LONGWIN_CACHE_PAGES; i++) {
+        LongPageSlot* slot = &lw->slot[i];
+        if(slot->dirty && slot->index != head_page && !longwin_write_back(lw, slot)) return;
     }
 
-    /* Always start fresh - truncate and write new header */
-    storage_file_seek(state->log_file, 0, true);
-    storage_file_truncate(state->log_file);
-    const char* header = "timestamp_ms,sample_num,rssi_315,rssi_433,rssi_868,temperature,voltage,phi_current,phi_baseline,phi_short,stability,match_pct\n";
-    storage_file_write(state->log_file, header, strlen(header));
+    uint32_t ahead = lw->head + LONGWIN_PREFETCH;
+    for(int w = 0; w < LONGWIN_COUNT; w++) {
+        if(ahead < lw->window[w].samples) continue;
+        uint32_t old = (ahead - lw->window[w].samples) % LONGWIN_RING_SAMPLES;
+        if(longwin_page(lw, (uint16_t)(old / LONGWIN_PAGE_SAMPLES), true) == NULL) return;
+    }
+}
 
-    state->log_active = true;
-    state->start_time = furi_get_tick();
-    return true;
+/**
+ * @brief Exact average of each band over window @p w
+ * @param avg LF, HF, UHF averages in dB (left alone while nothing is covered)
+ * @return Samples covered: the window's length once it has filled
+ */
+static uint32_t longwin_average(const LongWindows* lw, int w, float avg[3]) {
+    const LongWindowSum* sum = &lw->window[w];
+    uint32_t samples = lw->head < sum->samples ? lw->head : sum->samples;
+    if(samples == 0) return 0;
+    for(int b = 0; b < 3; b++) avg[b] = (float)sum->sum[b] / (float)samples / LONGWIN_SCALE;
+    return samples;
 }
 
 /**
- * @brief Write a log entry to SD card
+ * @brief Close and remove LONGWIN_PATH; the windows start over every session
  */
-static void debug_log_write(RealityClockState* state) {
-    if(!state->log_active || !state->log_file) return;
+static void longwin_close(LongWindows* lw) {
+    if(storage_file_is_open(lw->file)) storage_file_close(lw->file);
+    storage_file_free(lw->file);
+    storage_common_remove(lw->storage, LONGWIN_PATH);
+    furi_record_close(RECORD_STORAGE);
+    lw->file = NULL;
+    lw->storage = NULL;
+}
 
-    char log_line[300];
-    uint32_t elapsed_ms = furi_get_tick() - state->start_time;
+/* ============================================================================
+ * BATTERY GOVERNOR
+ * ============================================================================
+ * The battery readings used to be display-only. The governor turns them into
+ * a QoS tier, and every tier down gives up more: a slower sample rate (the
+ * radio is read DECIM_FACTOR times per sample, so this is most of the
+ * saving), a dimmer backlight, PHI from the 5 min time window instead of the
+ * 1000-sample rings, and SD log blocks written only when full.
+ *
+ * The tier is the more frugal of two:
+ *   - charge: the last tier whose threshold the charge is at or below
+ *     ("Tier Percent" in settings.txt, default 50/25/10 %)
+ *   - target: with Run Until set, the projected runtime (remaining capacity
+ *     over the smoothed discharge current) must beat the time left by
+ *     GOV_TARGET_MARGIN or the tier steps down one. It steps back up only
+ *     if the tier above would beat it by GOV_TARGET_RELAX, judged by the
+ *     draw last measured there (twice the current draw if never), so it
+ *     does not bounce between two tiers. Steps are GOV_HOLD_MS apart so
+ *     the current settles at the new tier before it is judged.
+ *
+ * Checked every GOV_CHECK_MS. At exit each session appends a row to
+ * runtime.csv: the runtime projected at the start against the one
+ * achieved, what was still projected at exit, and whether the target was met.
+ */
 
-    snprintf(log_line, sizeof(log_line),
-        "%lu,%lu,%.2f,%.2f,%.2f,%.2f,%.3f,%.6f,%.6f,%.6f,%.2f,%.2f\n",
-        (unsigned long)elapsed_ms,
-        (unsigned long)state->total_samples,
-        (double)state->rssi_315,
-        (double)state->rssi_433,
-        (double)state->rssi_868,
-        (double)state->temperature,
-        (double)state->voltage,
-        (double)state->phi_current,
-        (double)state->phi_baseline,
-        (double)state->phi_short_term,
-        (double)state->stability,
-        (double)state->match_percent);
+static const GovTier gov_tiers[GOV_TIER_COUNT] = {
+    {"Full", 100, SAMPLE_INTERVAL_NORMAL_MS, 100, false, true},
+    {"Eco", 50, 2000, 60, false, true},
+    {"Saver", 25, 5000, 30, true, false},
+    {"Low", 10, 10000, 10, true, false},
+};
 
-    storage_file_write(state->log_file, log_line, strlen(log_line));
+/** Defined with the screens; applies at most the tier's brightness_cap */
+static void apply_brightness(RealityClockState* state, uint8_t brightness);
 
-    /* Sync to disk every 100 samples */
-    if(state->total_samples % 100 == 0) {
-        storage_file_sync(state->log_file);
-    }
+/** RTC time at which @p minutes after midnight next comes round */
+static uint32_t governor_next_occurrence(uint32_t now, uint16_t minutes) {
+    uint32_t at = now - now % 86400 + minutes * 60u;
+    return at > now ? at : at + 86400;
 }
 
 /**
- * @brief Close log file and cleanup
+ * @brief Aim at the next run_until, at start and whenever it changes
  */
-static void debug_log_close(RealityClockState* state) {
+static void governor_set_target(RealityClockState* state) {
+    state->gov_target_epoch = state->run_until == GOV_RUN_UNTIL_OFF ?
+        0 : governor_next_occurrence(furi_hal_rtc_get_timestamp(), state->run_until);
+    state->gov_target_tier = 0;
+    state->gov_target_met = false;
+    state->gov_step_tick = furi_get_tick();
+}
+
+static void governor_apply(RealityClockState* state, uint8_t tier) {
+    if(tier == state->gov_tier) return;
+    bool rings_stale = gov_tiers[state->gov_tier].window_averages && !gov_tiers[tier].window_averages;
+
+    FURI_LOG_I(
+        "RealityClock",
+        "Governor: %s -> %s, projected %lu min",
+        gov_tiers[state->gov_tier].name,
+        gov_tiers[tier].name,
+        (unsigned long)(state->gov_projected_s / 60));
+    state->gov_tier = tier;
+    state->gov_tier_changes++;
+    state->gov_tier_tick = furi_get_tick();
+
+    /* The rings were not written on the window path; refill them from scratch
+       (a background recalibration starts its count over with them) */
+    if(rings_stale) {
+        buffer_reset(&state->lf_buffer);
+        buffer_reset(&state->hf_buffer);
+        buffer_reset(&state->uhf_buffer);
+        state->recal_samples = 0;
+    }
+    apply_brightness(state, state->brightness);
+    state->brightness_refresh_time = furi_get_tick() + BRIGHTNESS_REFRESH_MS;
+}
+
+/**
+ * @brief Remember where the session started and open the runtime log
+ */
+static void governor_start(RealityClockState* state) {
+    state->gov_start_epoch = furi_hal_rtc_get_timestamp();
+    state->gov_start_pct = furi_hal_power_get_pct();
+    state->gov_check_due = furi_get_tick();
+    governor_set_target(state);
+
+    state->gov_storage = furi_record_open(RECORD_STORAGE);
+    storage_common_mkdir(state->gov_storage, SETTINGS_DIR);
+    state->gov_log_file = storage_file_alloc(state->gov_storage);
+    if(!storage_file_open(state->gov_log_file, GOV_LOG_PATH, FSAM_WRITE, FSOM_OPEN_APPEND)) {
+        FURI_LOG_W("RealityClock", "Cannot open %s", GOV_LOG_PATH);
+    }
+}
+
+/**
+ * @brief Re-project the runtime and pick the tier, every GOV_CHECK_MS
+ * @return CHANGED_GOVERNOR if the tier or the projection to the minute moved
+ */
+static uint8_t governor_update(RealityClockState* state) {
+    uint8_t shown_tier = state->gov_tier;
+    uint32_t shown_min = state->gov_projected_s / 60;
+    uint32_t now = furi_hal_rtc_get_timestamp();
+    uint8_t pct = furi_hal_power_get_pct();
+    uint32_t remaining_mah = furi_hal_power_get_battery_remaining_capacity();
+
+    /* The fuel gauge reports discharge as negative current */
+    float current = furi_hal_power_get_battery_current(FuriHalPowerICFuelGauge);
+    float draw = current < -GOV_CHARGING_MA ? -current : 0.0f;
+    if(draw > 0.0f && state->gov_draw_ma > 0.0f) {
+        state->gov_draw_ma += GOV_CURRENT_ALPHA * (draw - state->gov_draw_ma);
+    } else {
+        state->gov_draw_ma = draw;
+    }
+    state->gov_projected_s = state->gov_draw_ma > 0.0f ?
+        (uint32_t)((float)remaining_mah * 3600.0f / state->gov_draw_ma) : UINT32_MAX;
+    if(state->gov_first_projected_s == 0) state->gov_first_projected_s = state->gov_projected_s;
+    if(furi_get_tick() - state->gov_tier_tick >= GOV_HOLD_MS) {
+        state->gov_tier_draw_ma[state->gov_tier] = state->gov_draw_ma;
+    }
+
+    uint8_t charge_tier = 0;
+    for(uint8_t i = 1; i < GOV_TIER_COUNT; i++) {
+        if(pct <= state->gov_tier_pct[i]) charge_tier = i;
+    }
+
+    if(state->gov_target_epoch != 0) {
+        if((int32_t)(now - state->gov_target_epoch) >= 0) {
+            FURI_LOG_I("RealityClock", "Governor: target reached with %u%% left", pct);
+            state->gov_target_met = true;
+            state->gov_target_met_pct = pct;
+            state->gov_target_epoch = 0;
+            state->gov_target_tier = 0;
+        } else if(furi_get_tick() - state->gov_step_tick >= GOV_HOLD_MS) {
+            float needed_s = (float)(state->gov_target_epoch - now);
+            float above_ma = state->gov_target_tier > 0 ? state->gov_tier_draw_ma[state->gov_target_tier - 1] : 0.0f;
+            if(above_ma <= 0.0f) above_ma = 2.0f * state->gov_draw_ma;
+
+            if(state->gov_projected_s < needed_s * GOV_TARGET_MARGIN &&
+               state->gov_tier < GOV_TIER_COUNT - 1) {
+                state->gov_target_tier = state->gov_tier + 1;
+                state->gov_step_tick = furi_get_tick();
+            } else if(state->gov_target_tier > 0 && above_ma > 0.0f &&
+                      (float)remaining_mah * 3600.0f / above_ma > needed_s * GOV_TARGET_RELAX) {
+                state->gov_target_tier--;
+                state->gov_step_tick = furi_get_tick();
+            }
+        }
+    }
+
+    governor_apply(state, charge_tier > state->gov_target_tier ? charge_tier : state->gov_target_tier);
+    return state->gov_tier != shown_tier || state->gov_projected_s / 60 != shown_min ? CHANGED_GOVERNOR : 0;
+}
+
+/**
+ * @brief Append this session's achieved against projected runtime to GOV_LOG_PATH
+ * and close it
+ */
+static void governor_log_session(RealityClockState* state) {
+    uint32_t now = furi_hal_rtc_get_timestamp();
+    uint32_t achieved_s = now - state->gov_start_epoch;
+    char projected[12] = "";
+    char left[12] = "";
+    char until[8] = "off";
+    char met[8] = "";
+
+    if(state->gov_first_projected_s != 0 && state->gov_first_projected_s != UINT32_MAX) {
+        snprintf(projected, sizeof(projected), "%lu", (unsigned long)state->gov_first_projected_s);
+    }
+    if(state->gov_projected_s != 0 && state->gov_projected_s != UINT32_MAX) {
+        snprintf(left, sizeof(left), "%lu", (unsigned long)state->gov_projected_s);
+    }
+    if(state->run_until != GOV_RUN_UNTIL_OFF) {
+        snprintf(until, sizeof(until), "%02u:%02u", (unsigned)(state->run_until / 60 % 24),
+            (unsigned)(state->run_until % 60));
+    }
+    if(state->gov_target_met) snprintf(met, sizeof(met), "%u", state->gov_target_met_pct);
+
+    FURI_LOG_I(
+        "RealityClock",
+        "Runtime: %lu min achieved, %s s projected at start, %s s left",
+        (unsigned long)(achieved_s / 60),
+        projected[0] ? projected : "-",
+        left[0] ? left : "-");
+
+    File* file = state->gov_log_file;
+    if(storage_file_is_open(file)) {
+        char line[128];
+        if(storage_file_size(file) == 0) {
+            const char* header = "start_epoch,end_epoch,start_pct,end_pct,projected_s,achieved_s,"
+                                 "left_s,run_until,target_met_pct,tier_changes,final_tier\n";
+            storage_file_write(file, header, strlen(header));
+        }
+        snprintf(line, sizeof(line), "%lu,%lu,%u,%u,%s,%lu,%s,%s,%s,%u,%s\n",
+            (unsigned long)state->gov_start_epoch,
+            (unsigned long)now,
+            state->gov_start_pct,
+            furi_hal_power_get_pct(),
+            projected,
+            (unsigned long)achieved_s,
+            left,
+            until,
+            met,
+            state->gov_tier_changes,
+            gov_tiers[state->gov_tier].name);
+        storage_file_write(file, line, strlen(line));
+        storage_file_close(file);
+    }
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+    state->gov_log_file = NULL;
+    state->gov_storage = NULL;
+}
+
+/* ============================================================================
+ * DECIMATION
+ * ============================================================================
+ * Sampling RSSI once per second aliases anything faster (a transmitter
+ * keying every few seconds, mains-rate interference) straight into PHI.
+ * Each band is therefore read DECIM_FACTOR times per sample interval and
+ * decimated in two stages, one read at a time:
+ *
+ *   CIC, order 3, rate 4   nulls at every multiple of the CIC output rate;
+ *                          integer integrators so it never drifts
+ *   Half-band FIR, 11 taps rate 2; only 4 distinct coefficients, and only
+ *                          every other output is computed (polyphase)
+ *
+ * Passband to 0.1x the sample rate within 0.12 dB, and at least 65 dB of
+ * rejection for everything that would alias into it (tools/host/
+ * filter_response.c measures both). State is 72 bytes per band.
+ */
+
+/** Half-band taps h[1], h[3], h[5] (h[0] = 1/2, even taps are zero), Blackman window */
+static const float halfband_coeffs[3] = {0.28437112f, -0.03608989f, 0.00171877f};
+
+/** CIC gain, CIC_RATE^CIC_ORDER */
+#define CIC_GAIN ((float)(CIC_RATE * CIC_RATE * CIC_RATE))
+
+static bool decimator_push(Decimator* d, float value, float* out);
+
+/**
+ * @brief Fill the filters as if @p value had always been the input
+ *
+ * Without this the first samples would ramp up from 0 dBm.
+ */
+static void decimator_prime(Decimator* d, float value) {
+    float unused;
+    memset(d, 0, sizeof(*d));
+    d->primed = true;
+    for(int i = 0; i < DECIM_SETTLE_READS; i++) {
+        decimator_push(d, value, &unused);
+    }
+}
+
+/**
+ * @brief Feed one read; every DECIM_FACTOR reads a sample comes out
+ *
+ * @param out  Receives the decimated sample, untouched otherwise
+ * @return true if @p out was written
+ */
+static bool decimator_push(Decimator* d, float value, float* out) {
+    if(!d->primed) decimator_prime(d, value);
+
+    /* Integrators at the read rate */
+    uint32_t acc = (uint32_t)(int32_t)lrintf(value * CIC_SCALE);
+    for(int i = 0; i < CIC_ORDER; i++) {
+        d->integrator[i] += acc;
+        acc = d->integrator[i];
+    }
+    if(++d->cic_phase < CIC_RATE) return false;
+    d->cic_phase = 0;
+
+    /* Combs at the CIC output rate */
+    for(int i = 0; i < CIC_ORDER; i++) {
+        uint32_t delayed = d->comb_delay[i];
+        d->comb_delay[i] = acc;
+        acc -= delayed;
+    }
+    d->head = (uint8_t)((d->head + 1) % HALFBAND_TAPS);
+    d->history[d->head] = (float)(int32_t)acc / (CIC_SCALE * CIC_GAIN);
+
+    if(++d->halfband_phase < 2) return false;
+    d->halfband_phase = 0;
+
+    /* Symmetric taps around the centre (HALFBAND_TAPS / 2 outputs ago) */
+    const int center = HALFBAND_TAPS / 2;
+    float sum = 0.5f * d->history[(d->head + HALFBAND_TAPS - center) % HALFBAND_TAPS];
+    for(int k = 0; k < 3; k++) {
+        int offset = 2 * k + 1;
+        sum += halfband_coeffs[k] *
+               (d->history[(d->head + HALFBAND_TAPS - center - offset) % HALFBAND_TAPS] +
+                d->history[(d->head + HALFBAND_TAPS - center + offset) % HALFBAND_TAPS]);
+    }
+    *out = sum;
+    return true;
+}
+
+/* ============================================================================
+ * HARDWARE ENTROPY (used only in simulated mode)
+ * ============================================================================ */
+
+#ifndef DEBUG_MODE
+static float get_entropy_float(void) {
+    uint32_t val;
+    furi_hal_random_fill_buf((uint8_t*)&val, sizeof(val));
+    return (float)(val & 0xFFFF) / 65536.0f;
+}
+
+static float get_timing_jitter(void) {
+    uint32_t t1 = furi_get_tick();
+    furi_delay_us(1);
+    uint32_t t2 = furi_get_tick();
+    return ((float)((t2 - t1) ^ (t1 & 0xFF)) / 1000.0f) - 0.5f;
+}
+#endif
+
+/* ============================================================================
+ * SENSOR READINGS - Raw with natural variation (SIMULATED - used when DEBUG_MODE is off)
+ * ============================================================================ */
+
+#ifndef DEBUG_MODE
+static float read_lf_raw(void) {
+    float base = -42.0f;
+    float variation = get_entropy_float() * 8.0f - 4.0f;
+    float jitter = get_timing_jitter() * 1.5f;
+    return base + variation + jitter;
+}
+
+static float read_hf_raw(void) {
+    float base = -58.0f;
+    float variation = get_entropy_float() * 6.0f - 3.0f;
+    float jitter = get_timing_jitter() * 1.2f;
+    return base + variation + jitter;
+}
+
+static float read_uhf_raw(void) {
+    float base = -70.0f;
+    float variation = get_entropy_float() * 10.0f - 5.0f;
+    float jitter = get_timing_jitter() * 2.0f;
+    return base + variation + jitter;
+}
+#endif
+
+/* ============================================================================
+ * REAL SENSOR READINGS (DEBUG_MODE only)
+ * Uses actual SubGHz radio RSSI and internal temperature sensor
+ * ============================================================================ */
+
+#ifdef DEBUG_MODE
+
+/**
+ * @brief Read real RSSI at specified frequency using SubGHz radio
+ * @param frequency Frequency in Hz (e.g., 433920000 for 433.92 MHz)
+ * @return RSSI value in dBm
+ */
+static float read_real_rssi(uint32_t frequency) {
+    /* Set frequency and appropriate antenna path */
+    furi_hal_subghz_set_frequency_and_path(frequency);
+
+    /* Switch to RX mode */
+    furi_hal_subghz_rx();
+
+    /* Small delay for RSSI to stabilize */
+    furi_delay_us(500);
+
+    /* Read RSSI */
+    float rssi = furi_hal_subghz_get_rssi();
+
+    /* Return to idle */
+    furi_hal_subghz_idle();
+
+    return rssi;
+}
+
+/**
+ * @brief Read internal die temperature from STM32 ADC
+ * @param adc_handle ADC handle (must be acquired and configured)
+ * @return Temperature in degrees Celsius
+ */
+static float read_real_temperature(FuriHalAdcHandle* adc_handle) {
+    if(adc_handle == NULL) return 0.0f;
+
+    /* Read temperature sensor channel */
+    uint16_t raw_temp = furi_hal_adc_read(adc_handle, FuriHalAdcChannelTEMPSENSOR);
+
+    /* Convert to temperature */
+    return furi_hal_adc_convert_temp(adc_handle, raw_temp);
+}
+
+/* ============================================================================
+ * FREQUENCY SURVEY (DEBUG_MODE only)
+ * ============================================================================
+ * FREQ_BAND_* are the channels every garage door, weather station and car
+ * key uses, so PHI mostly tracks other people's transmitters. At startup each
+ * antenna path is swept over SURVEY_CANDIDATES frequencies (FREQ_BAND_* and
+ * an even grid over the path's range) and the quietest one is used for the
+ * session. A candidate scores its RSSI variance plus a penalty for the share
+ * of reads more than SURVEY_OCCUPIED_DB above the path's quietest candidate,
+ * which is what a steady carrier shows instead of variance.
+ *
+ * Every candidate is read once per pass, all paths interleaved, so a burst
+ * lands on one read of many candidates rather than every read of one. The
+ * survey stops after SURVEY_PASSES or SURVEY_BUDGET_MS, whichever is first;
+ * with fewer than SURVEY_MIN_PASSES the defaults stay. The reads are kept in
+ * the band rings, which are unused until sampling starts.
+ */
+
+/** Tuning range of each CC1101 antenna path (furi_hal_subghz), LF/HF/UHF */
+static const uint32_t survey_path_range[3][2] = {
+    {300000000, 348000000},
+    {387000000, 464000000},
+    {779000000, 928000000},
+};
+
+static const uint32_t survey_default_freq[3] = {FREQ_BAND_1, FREQ_BAND_2, FREQ_BAND_3};
+
+_Static_assert(SURVEY_CANDIDATES * SURVEY_PASSES <= BUFFER_SIZE, "survey reads must fit a band ring");
+
+/** Candidate @p index on @p path: 0 is the default, then the grid midpoints */
+static uint32_t survey_candidate(int path, int index) {
+    if(index == 0) return survey_default_freq[path];
+    uint32_t low = survey_path_range[path][0];
+    uint32_t span = survey_path_range[path][1] - low;
+    uint32_t freq = low + (uint32_t)((uint64_t)span * (2 * index - 1) / (2 * SURVEY_GRID_POINTS));
+    return freq / SURVEY_GRID_STEP_HZ * SURVEY_GRID_STEP_HZ;
+}
+
+/**
+ * @brief Choose the quietest frequency on each path into state->band_freq
+ */
+static void frequency_survey(RealityClockState* state) {
+    RollingBuffer* rings[3] = {&state->lf_buffer, &state->hf_buffer, &state->uhf_buffer};
+    uint32_t start = furi_get_tick();
+    int passes = 0;
+
+    for(int path = 0; path < 3; path++) state->band_freq[path] = survey_default_freq[path];
+    state->survey_reads = 0;
+
+    while(passes < SURVEY_PASSES && (int32_t)(furi_get_tick() - start) < SURVEY_BUDGET_MS) {
+        for(int path = 0; path < 3; path++) {
+            for(int c = 0; c < SURVEY_CANDIDATES; c++) {
+                rings[path]->values[c * SURVEY_PASSES + passes] =
+                    read_real_rssi(survey_candidate(path, c));
+            }
+        }
+        state->survey_reads += 3 * SURVEY_CANDIDATES;
+        passes++;
+    }
+    state->survey_ms = furi_get_tick() - start;
+
+    for(int path = 0; passes >= SURVEY_MIN_PASSES && path < 3; path++) {
+        float mean[SURVEY_CANDIDATES];
+        float var[SURVEY_CANDIDATES];
+        float floor_db = INFINITY;
+
+        for(int c = 0; c < SURVEY_CANDIDATES; c++) {
+            const float* reads = &rings[path]->values[c * SURVEY_PASSES];
+            float sum = 0.0f, sum_sq = 0.0f;
+            for(int i = 0; i < passes; i++) sum += reads[i];
+            mean[c] = sum / passes;
+            for(int i = 0; i < passes; i++) sum_sq += (reads[i] - mean[c]) * (reads[i] - mean[c]);
+            var[c] = sum_sq / passes;
+            if(mean[c] < floor_db) floor_db = mean[c];
+        }
+
+        /* Strictly better only, so ties keep the default */
+        float best = INFINITY;
+        for(int c = 0; c < SURVEY_CANDIDATES; c++) {
+            const float* reads = &rings[path]->values[c * SURVEY_PASSES];
+            int occupied = 0;
+            for(int i = 0; i < passes; i++) {
+                if(reads[i] > floor_db + SURVEY_OCCUPIED_DB) occupied++;
+            }
+            float score = var[c] + SURVEY_OCCUPANCY_WEIGHT * occupied / passes;
+            if(score < best) {
+                best = score;
+                state->band_freq[path] = survey_candidate(path, c);
+            }
+        }
+    }
+
+    for(int path = 0; path < 3; path++) buffer_reset(rings[path]);
+
+    FURI_LOG_I(
+        "RealityClock",
+        "Survey: %lu/%lu/%lu Hz, %u reads in %lu ms",
+        (unsigned long)state->band_freq[0],
+        (unsigned long)state->band_freq[1],
+        (unsigned long)state->band_freq[2],
+        state->survey_reads,
+        (unsigned long)state->survey_ms);
+}
+
+/**
+ * @brief Read all real sensor bands once and feed the decimators
+ * Band mapping for "dimensional" theme:
+ *   - "LF" band  = 315 MHz path RSSI (lower frequency)
+ *   - "HF" band  = 433 MHz path RSSI (mid frequency)
+ *   - "UHF" band = 868 MHz path RSSI (higher frequency)
+ * each at the frequency frequency_survey() chose for the path.
+ *
+ * @return true once every DECIM_FACTOR reads, when a new sample is ready
+ */
+static bool read_real_sensors(RealityClockState* state) {
+    /* The three decimators run in lockstep, so they are ready together */
+    bool ready = decimator_push(&state->lf_decim, read_real_rssi(state->band_freq[0]), &state->rssi_315);
+    decimator_push(&state->hf_decim, read_real_rssi(state->band_freq[1]), &state->rssi_433);
+    decimator_push(&state->uhf_decim, read_real_rssi(state->band_freq[2]), &state->rssi_868);
+    if(!ready) return false;
+
+    /* Map to LF/HF/UHF for display consistency */
+    state->lf_raw = state->rssi_315;
+    state->hf_raw = state->rssi_433;
+    state->uhf_raw = state->rssi_868;
+
+    /* Read temperature */
+    state->temperature = read_real_temperature(state->adc_handle);
+    return true;
+}
+
+#ifdef DEBUG_LOG_TO_SD
+/**
+ * @brief Anchor the tick to the RTC by catching the start of an RTC second
+ *
+ * Polls the RTC in 1 ms steps for at most @p max_wait_ms. On a miss (RTC
+ * adjusted, or the edge moved outside the window) the previous anchor stays.
+ * A missed short poll is retried at the next predicted edge; a missed full
+ * poll means the RTC is not ticking, and waits for the next interval.
+ *
+ * @return true if a second edge was caught
+ */
+static bool debug_log_anchor(RealityClockState* state, uint32_t max_wait_ms) {
+    uint32_t start = furi_get_tick();
+    uint32_t second = furi_hal_rtc_get_timestamp();
+
+    while(furi_hal_rtc_get_timestamp() == second) {
+        if(furi_get_tick() - start >= max_wait_ms) {
+            if(max_wait_ms >= LOG_ANCHOR_FULL_POLL_MS) {
+                state->anchor_misses = LOG_ANCHOR_MAX_MISSES;
+                state->anchor_due = furi_get_tick() + LOG_ANCHOR_INTERVAL_MS;
+            } else {
+                state->anchor_misses++;
+                state->anchor_due = furi_get_tick();
+            }
+            return false;
+        }
+        furi_delay_ms(1);
+    }
+
+    state->anchor_tick = furi_get_tick();
+    state->anchor_epoch = furi_hal_rtc_get_timestamp();
+    state->anchor_misses = 0;
+    /* RTC seconds begin every 1000 ticks after the anchor, give or take drift */
+    state->anchor_due = state->anchor_tick + LOG_ANCHOR_INTERVAL_MS - LOG_ANCHOR_LEAD_MS;
+    return true;
+}
+
+/**
+ * @brief Re-anchor if due; called from the main loop between samples
+ *
+ * RTC seconds begin every 1000 ticks after the last anchor, so a short poll
+ * is only started just before a predicted edge. If the loop woke late and
+ * the edge has passed, the poll moves to the next one instead of waiting
+ * out the second. Only LOG_ANCHOR_MAX_MISSES short misses in a row (the
+ * prediction is off) cost a full-second poll.
+ */
+static void debug_log_anchor_update(RealityClockState* state) {
+    if(!state->log_active) return;
+    uint32_t now = furi_get_tick();
+    if((int32_t)(now - state->anchor_due) < 0) return;
+
+    if(state->anchor_misses < LOG_ANCHOR_MAX_MISSES) {
+        uint32_t to_edge = (1000 - (now - state->anchor_tick) % 1000) % 1000;
+        if(to_edge > LOG_ANCHOR_LEAD_MS) {
+            state->anchor_due = now + to_edge - LOG_ANCHOR_LEAD_MS;
+            return;
+        }
+    }
+
+    state->anchor_polls++;
+    if(state->anchor_misses < LOG_ANCHOR_MAX_MISSES) {
+        debug_log_anchor(state, LOG_ANCHOR_POLL_MS);
+    } else {
+        state->anchor_full_polls++;
+        debug_log_anchor(state, LOG_ANCHOR_FULL_POLL_MS);
+    }
+}
+
+/**
+ * @brief CRC-32 (IEEE 802.3, as zlib.crc32) with a 16-entry nibble table
+ */
+static uint32_t debug_log_crc32(const uint8_t* data, size_t len) {
+    static const uint32_t table[16] = {
+        0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+        0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C,
+    };
+    uint32_t crc = 0xFFFFFFFF;
+    for(size_t i = 0; i < len; i++) {
+        crc = table[(crc ^ data[i]) & 0x0F] ^ (crc >> 4);
+        crc = table[(crc ^ (data[i] >> 4)) & 0x0F] ^ (crc >> 4);
+    }
+    return ~crc;
+}
+
+/**
+ * @brief Write the pending block with its header in one write, then sync
+ *
+ * The file is a sequence of blocks, each a fixed-width text header
+ *   #blk <seq, 8 hex> <payload length, 4 hex> <CRC-32 of payload, 8 hex>
+ * followed by whole CSV lines. Block 0 holds the CSV header. A block torn
+ * by a crash fails its length or CRC check and scripts/recover_log.py
+ * skips it; every block before it is intact.
+ */
+static void debug_log_flush(RealityClockState* state) {
+    if(state->log_block_used == 0) return;
+
+    char* payload = state->log_block + LOG_BLOCK_HEADER_SIZE;
+    char header[LOG_BLOCK_HEADER_SIZE + 1];
+    snprintf(header, sizeof(header), "#blk %08lx %04x %08lx\n",
+        (unsigned long)state->log_block_seq,
+        (unsigned)state->log_block_used,
+        (unsigned long)debug_log_crc32((const uint8_t*)payload, state->log_block_used));
+    memcpy(state->log_block, header, LOG_BLOCK_HEADER_SIZE);
+
+    storage_file_write(state->log_file, state->log_block, LOG_BLOCK_HEADER_SIZE + state->log_block_used);
+    storage_file_sync(state->log_file);
+
+    state->log_block_seq++;
+    state->log_block_used = 0;
+}
+
+/**
+ * @brief Initialize SD card logging
+ */
+static bool debug_log_init(RealityClockState* state) {
+    state->storage = furi_record_open(RECORD_STORAGE);
+    if(!state->storage) return false;
+
+    /* Create directory if it doesn't exist */
+    storage_common_mkdir(state->storage, DEBUG_LOG_DIR);
+
+    /* Open log file for append */
+    state->log_file = storage_file_alloc(state->storage);
+    if(!storage_file_open(state->log_file, DEBUG_LOG_PATH, FSAM_WRITE, FSOM_OPEN_APPEND)) {
+        storage_file_free(state->log_file);
+        state->log_file = NULL;
+        furi_record_close(RECORD_STORAGE);
+        state->storage = NULL;
+        return false;
+    }
+
+    /* Always start fresh - truncate and write new header */
+    storage_file_seek(state->log_file, 0, true);
+    storage_file_truncate(state->log_file);
+    const char* header = "timestamp_ms,sample_num,rssi_315,rssi_433,rssi_868,temperature,voltage,phi_current,phi_baseline,phi_short,stability,match_pct,epoch_ms,heap_free,heap_min_free,stack_free,io_near\n";
+    state->log_block_seq = 0;
+    state->log_block_used = (uint16_t)strlen(header);
+    memcpy(state->log_block + LOG_BLOCK_HEADER_SIZE, header, state->log_block_used);
+    debug_log_flush(state);
+
+    /* Unaligned anchor first, so epoch_ms is usable even if the RTC is stopped */
+    state->anchor_tick = furi_get_tick();
+    state->anchor_epoch = furi_hal_rtc_get_timestamp();
+    debug_log_anchor(state, LOG_ANCHOR_FULL_POLL_MS);
+
+    state->log_active = true;
+    state->start_time = furi_get_tick();
+    return true;
+}
+
+/**
+ * @brief Append a log row to the pending block, flushing it when due
+ *
+ * The row is formatted straight into the block; the flush policy keeps at
+ * least LOG_LINE_SIZE bytes free for it.
+ */
+static void debug_log_write(RealityClockState* state) {
+    if(!state->log_active || !state->log_file) return;
+
+    /* A flush still waiting for a gap cannot hold back a row that would not fit */
+    if(state->log_block_used > LOG_BLOCK_SIZE - LOG_LINE_SIZE) io_run_job(state, IoJobLogFlush);
+
+    char* log_line = state->log_block + LOG_BLOCK_HEADER_SIZE + state->log_block_used;
+    uint32_t now = furi_get_tick();
+    uint32_t elapsed_ms = now - state->start_time;
+
+    /* RTC-anchored wall time; printed as seconds + 3 digits (no 64-bit printf) */
+    uint32_t since_anchor = now - state->anchor_tick;
+    uint32_t epoch_s = state->anchor_epoch + since_anchor / 1000;
+
+    snprintf(log_line, LOG_LINE_SIZE,
+        "%lu,%lu,%.2f,%.2f,%.2f,%.2f,%.3f,%.6f,%.6f,%.6f,%.2f,%.2f,%lu%03lu,%lu,%lu,%lu,%u\n",
+        (unsigned long)elapsed_ms,
+        (unsigned long)state->total_samples,
+        (double)state->rssi_315,
+        (double)state->rssi_433,
+        (double)state->rssi_868,
+        (double)state->temperature,
+        (double)state->voltage,
+        (double)state->phi_current,
+        (double)state->phi_baseline,
+        (double)state->phi_short_term,
+        (double)state->stability,
+        (double)state->match_percent,
+        (unsigned long)epoch_s,
+        (unsigned long)(since_anchor % 1000),
+        (unsigned long)state->heap_free,
+        (unsigned long)state->heap_min_free,
+        (unsigned long)state->stack_free,
+        (unsigned)state->io_sample_tag);
+
+    if(state->log_block_used == 0) state->log_block_start = now;
+    state->log_block_used += (uint16_t)strlen(log_line);
+
+    /* Size or age policy: a full block, or the oldest row has waited long
+       enough (the battery governor's low tiers only write full blocks).
+       The write itself waits for a gap between radio reads. */
+    if(state->log_block_used > LOG_BLOCK_SIZE - LOG_LINE_SIZE ||
+       (gov_tiers[state->gov_tier].timed_log_flush && now - state->log_block_start >= LOG_BLOCK_FLUSH_MS)) {
+        io_request(state, IoJobLogFlush);
+    }
+}
+
+/**
+ * @brief Close log file and cleanup
+ */
+static void debug_log_close(RealityClockState* state) {
     if(state->log_file) {
+        debug_log_flush(state);
         storage_file_close(state->log_file);
         storage_file_free(state->log_file);
         state->log_file = NULL;
@@ -458,6 +1843,19 @@ static void debug_log_close(RealityClockState* state) {
 
 #endif /* DEBUG_MODE */
 
+/* ============================================================================
+ * MEMORY TELEMETRY
+ * ============================================================================
+ * stack_free only ever shrinks: stack_size in application.fam minus the
+ * smallest value seen over a long run is what the app really needs.
+ */
+
+static void memory_telemetry_update(RealityClockState* state) {
+    state->heap_free = (uint32_t)memmgr_get_free_heap();
+    state->heap_min_free = (uint32_t)memmgr_get_minimum_free_heap();
+    state->stack_free = furi_thread_get_stack_space(furi_thread_get_current_id());
+}
+
 /* ============================================================================
  * CALCULATIONS
  * ============================================================================ */
@@ -549,32 +1947,464 @@ static DimensionStatus classify_status(float match_pct) {
     return DimStatusForeign;
 }
 
-static void update_readings(RealityClockState* state) {
+/* ============================================================================
+ * TIME-OF-DAY PROFILE
+ * ============================================================================
+ * Interference is often diurnal, and the adaptive baseline chases that cycle
+ * all day. The profile learns what each quarter hour normally looks like:
+ * a running mean and variance (Welford) of each band's RSSI and of ln(PHI),
+ * one bin per RTC quarter hour. Each sample updates one bin in O(1). Once a
+ * bin holds PROFILE_MIN_WEIGHT samples, phi_tod_z says how unusual PHI is
+ * for this time of day.
+ *
+ * Weights stop at PROFILE_MAX_WEIGHT; after that each update also scales
+ * the old spread down, so the profile follows seasonal change with a memory
+ * of about two weeks. It persists in PROFILE_PATH across sessions, written
+ * hourly and on exit through a temporary file. The file handle is allocated
+ * once per session, like the arena, so the main loop stays off the heap.
+ *
+ * Only samples with a full rolling buffer are profiled, so the averaged PHI
+ * of the first minutes of a session does not skew its bin.
+ */
+
+static const char* const profile_keys[PROFILE_CHANNELS][2] = {
+    {"LF Mean", "LF M2"},
+    {"HF Mean", "HF M2"},
+    {"UHF Mean", "UHF M2"},
+    {"PHI Mean", "PHI M2"},
+};
+
+static uint8_t profile_bin_now(void) {
+    DateTime now;
+    furi_hal_rtc_get_datetime(&now);
+    return (uint8_t)((now.hour * 60 + now.minute) / PROFILE_BIN_MINUTES % PROFILE_BINS);
+}
+
+/**
+ * @brief Fold this sample into its quarter-hour bin and score PHI against it
+ */
+static void profile_update(RealityClockState* state) {
+    TodProfile* profile = state->profile;
+    uint8_t bin = profile_bin_now();
+    state->profile_bin = bin;
+    if(state->lf_buffer.count < BUFFER_SIZE) return;
+
+    float values[PROFILE_CHANNELS] = {
+        state->lf_raw, state->hf_raw, state->uhf_raw, logf(fmaxf(state->phi_current, 1e-6f))};
+
+    /* Score against what the bin knew before this sample */
+    uint32_t weight = profile->weight[bin];
+    state->phi_tod_z = NAN;
+    if(weight >= PROFILE_MIN_WEIGHT) {
+        float var = profile->m2[PROFILE_CHANNELS - 1][bin] / (float)(weight - 1);
+        if(var > 0.0f) {
+            state->phi_tod_z = (values[PROFILE_CHANNELS - 1] - profile->mean[PROFILE_CHANNELS - 1][bin]) /
+                               sqrtf(var);
+        }
+    }
+
+    bool capped = weight >= PROFILE_MAX_WEIGHT;
+    if(!capped) profile->weight[bin] = ++weight;
+    for(int c = 0; c < PROFILE_CHANNELS; c++) {
+        float* mean = &profile->mean[c][bin];
+        float* m2 = &profile->m2[c][bin];
+        if(capped) *m2 -= *m2 / (float)weight;  /* Forget 1/weight of the old spread */
+        float delta = values[c] - *mean;
+        *mean += delta / (float)weight;
+        *m2 += delta * (values[c] - *mean);
+    }
+    state->profile_dirty = true;
+}
+
+/** @brief Number of bins trusted for scoring */
+static uint8_t profile_trained_bins(const TodProfile* profile) {
+    uint8_t count = 0;
+    for(int bin = 0; bin < PROFILE_BINS; bin++) {
+        if(profile->weight[bin] >= PROFILE_MIN_WEIGHT) count++;
+    }
+    return count;
+}
+
+/**
+ * @brief Take the file handle for the session and read the profile from
+ *        PROFILE_PATH, or from the temporary file a crash left mid-save
+ *
+ * Anything missing or malformed leaves the profile empty: a half-read
+ * profile would pair means and spreads from different bins.
+ */
+static void profile_open(RealityClockState* state) {
+    TodProfile* profile = state->profile;
+    state->profile_storage = furi_record_open(RECORD_STORAGE);
+    state->profile_file = flipper_format_file_alloc(state->profile_storage);
+    FlipperFormat* file = state->profile_file;
+    FuriString* filetype = furi_string_alloc();
+    uint32_t version = 0;
+
+    bool loaded = false;
+    const char* paths[] = {PROFILE_PATH, PROFILE_TMP_PATH};
+    for(size_t i = 0; i < 2 && !loaded; i++) {
+        loaded = flipper_format_file_open_existing(file, paths[i]) &&
+                 flipper_format_read_header(file, filetype, &version) &&
+                 furi_string_equal_str(filetype, PROFILE_FILETYPE) && version == PROFILE_VERSION &&
+                 flipper_format_read_uint32(file, "Weight", profile->weight, PROFILE_BINS);
+        for(int c = 0; c < PROFILE_CHANNELS && loaded; c++) {
+            loaded = flipper_format_read_float(file, profile_keys[c][0], profile->mean[c], PROFILE_BINS) &&
+                     flipper_format_read_float(file, profile_keys[c][1], profile->m2[c], PROFILE_BINS);
+        }
+        flipper_format_file_close(file);
+    }
+    if(!loaded) memset(profile, 0, sizeof(*profile));
+    for(int bin = 0; bin < PROFILE_BINS; bin++) {
+        if(profile->weight[bin] > PROFILE_MAX_WEIGHT) profile->weight[bin] = PROFILE_MAX_WEIGHT;
+    }
+
+    furi_string_free(filetype);
+    state->profile_dirty = false;
+}
+
+/**
+ * @brief Write the profile back if it changed
+ *
+ * Written to PROFILE_TMP_PATH first and renamed over PROFILE_PATH, so a
+ * crash mid-write never costs the weeks of history already saved.
+ */
+static void profile_save(RealityClockState* state) {
+    if(!state->profile_dirty) return;
+
+    TodProfile* profile = state->profile;
+    Storage* storage = state->profile_storage;
+    FlipperFormat* file = state->profile_file;
+    storage_common_mkdir(storage, SETTINGS_DIR);
+
+    bool written = flipper_format_file_open_always(file, PROFILE_TMP_PATH) &&
+                   flipper_format_write_header_cstr(file, PROFILE_FILETYPE, PROFILE_VERSION) &&
+                   flipper_format_write_uint32(file, "Weight", profile->weight, PROFILE_BINS);
+    for(int c = 0; c < PROFILE_CHANNELS && written; c++) {
+        written = flipper_format_write_float(file, profile_keys[c][0], profile->mean[c], PROFILE_BINS) &&
+                  flipper_format_write_float(file, profile_keys[c][1], profile->m2[c], PROFILE_BINS);
+    }
+    written = flipper_format_file_close(file) && written;
+
+    if(written) {
+        storage_common_remove(storage, PROFILE_PATH);
+        written = storage_common_rename(storage, PROFILE_TMP_PATH, PROFILE_PATH) == FSE_OK;
+    }
+    if(written) {
+        state->profile_dirty = false;
+    } else {
+        FURI_LOG_W("RealityClock", "Cannot write %s", PROFILE_PATH);
+    }
+}
+
+/** @brief Final save, then release the file handle */
+static void profile_close(RealityClockState* state) {
+    profile_save(state);
+    flipper_format_free(state->profile_file);
+    furi_record_close(RECORD_STORAGE);
+    state->profile_file = NULL;
+}
+
+#ifdef DEBUG_SHADOW_ENGINES
+/* ============================================================================
+ * SHADOW ENGINES
+ * ============================================================================
+ * Comparing a change to calculate_stability()/classify_status() across two
+ * runs means comparing two different RF environments. In shadow mode every
+ * engine in shadow_engines[] sees exactly the samples production sees, from
+ * the calibration sample on, and keeps a scorecard: time in each status,
+ * transitions, agreement with production and CPU cycles. The Details screen
+ * shows one line per engine; tools/host/detect_bench.c scores them against
+ * a labeled corpus.
+ *
+ * Entry 0 replays production with its own state, so it must agree on every
+ * sample - a check on the harness itself. All engines together get
+ * SHADOW_CYCLE_BUDGET cycles per sample; an engine whose last update would
+ * not fit is skipped for that sample and the skip is counted.
+ */
+
+static void shadow_prime_production(ShadowEngineState* s, const ShadowInput* in) {
+    s->mean = in->phi;
+    s->fast = in->phi;
+}
+
+/** Production: EMAs of the averaged PHI, calculate_stability(), classify_status() */
+static DimensionStatus shadow_update_production(ShadowEngineState* s, const ShadowInput* in) {
+    s->mean = EMA_ALPHA * in->phi + (1.0f - EMA_ALPHA) * s->mean;
+    s->fast = EMA_ALPHA_FAST * in->phi + (1.0f - EMA_ALPHA_FAST) * s->fast;
+    return classify_status(calculate_stability(in->phi, s->fast, s->mean));
+}
+
+static void shadow_prime_raw(ShadowEngineState* s, const ShadowInput* in) {
+    s->mean = in->phi_raw;
+    s->fast = in->phi_raw;
+}
+
+/** Production's rule on each sample's own PHI, without the 1000-sample average */
+static DimensionStatus shadow_update_raw(ShadowEngineState* s, const ShadowInput* in) {
+    s->mean = EMA_ALPHA * in->phi_raw + (1.0f - EMA_ALPHA) * s->mean;
+    s->fast = EMA_ALPHA_FAST * in->phi_raw + (1.0f - EMA_ALPHA_FAST) * s->fast;
+    return classify_status(calculate_stability(in->phi_raw, s->fast, s->mean));
+}
+
+/** ln(PHI) is linear in the band dB values, so its noise is close to Gaussian */
+static float shadow_log_phi(const ShadowInput* in) {
+    return logf(fmaxf(in->phi_raw, 1e-6f));
+}
+
+/** Exponentially weighted mean and variance of @p x */
+static void shadow_track(ShadowEngineState* s, float x, float alpha) {
+    float d = x - s->mean;
+    s->mean += alpha * d;
+    s->var = (1.0f - alpha) * (s->var + alpha * d * d);
+}
+
+static void shadow_prime_log(ShadowEngineState* s, const ShadowInput* in) {
+    memset(s, 0, sizeof(*s));
+    s->mean = shadow_log_phi(in);
+    s->fast = s->mean;
+    s->var = SHADOW_LOG_VAR_INIT;
+}
+
+/** Z-score of a fast EMA of ln(PHI) against a slow mean and variance */
+static DimensionStatus shadow_update_zscore(ShadowEngineState* s, const ShadowInput* in) {
+    float x = shadow_log_phi(in);
+    s->fast = SHADOW_Z_ALPHA_FAST * x + (1.0f - SHADOW_Z_ALPHA_FAST) * s->fast;
+    shadow_track(s, x, SHADOW_Z_ALPHA_SLOW);
+
+    /* Variance of an EMA of white noise: var * alpha / (2 - alpha) */
+    float sd = sqrtf(s->var * SHADOW_Z_ALPHA_FAST / (2.0f - SHADOW_Z_ALPHA_FAST));
+    float z = sd > 0.0f ? fabsf(s->fast - s->mean) / sd : 0.0f;
+    if(z < 2.0f) return DimStatusHome;
+    if(z < 3.0f) return DimStatusStable;
+    if(z < 4.0f) return DimStatusUnstable;
+    return DimStatusForeign;
+}
+
+/** Two-sided CUSUM of standardized ln(PHI) against a slowly adapting baseline */
+static DimensionStatus shadow_update_cusum(ShadowEngineState* s, const ShadowInput* in) {
+    float x = shadow_log_phi(in);
+    float sd = sqrtf(s->var);
+    float e = sd > 0.0f ? (x - s->mean) / sd : 0.0f;
+    s->cusum_pos = fmaxf(0.0f, s->cusum_pos + e - SHADOW_CUSUM_K);
+    s->cusum_neg = fmaxf(0.0f, s->cusum_neg - e - SHADOW_CUSUM_K);
+    shadow_track(s, x, SHADOW_CUSUM_ALPHA);
+
+    float score = fmaxf(s->cusum_pos, s->cusum_neg);
+    if(score < SHADOW_CUSUM_H * 0.5f) return DimStatusHome;
+    if(score < SHADOW_CUSUM_H) return DimStatusStable;
+    if(score < SHADOW_CUSUM_H * 2.0f) return DimStatusUnstable;
+    return DimStatusForeign;
+}
+
+static void shadow_prime_none(ShadowEngineState* s, const ShadowInput* in) {
+    UNUSED(s);
+    UNUSED(in);
+}
+
+/** PHI against what this quarter hour normally looks like (TIME-OF-DAY PROFILE) */
+static DimensionStatus shadow_update_tod(ShadowEngineState* s, const ShadowInput* in) {
+    UNUSED(s);
+    if(isnan(in->phi_tod_z)) return DimStatusHome;  /* Bin not trained yet */
+    float z = fabsf(in->phi_tod_z);
+    if(z < 2.0f) return DimStatusHome;
+    if(z < 3.0f) return DimStatusStable;
+    if(z < 4.0f) return DimStatusUnstable;
+    return DimStatusForeign;
+}
+
+static const ShadowEngineDef shadow_engines[] = {
+    {"prod", shadow_prime_production, shadow_update_production},
+    {"raw", shadow_prime_raw, shadow_update_raw},
+    {"zscore", shadow_prime_log, shadow_update_zscore},
+    {"cusum", shadow_prime_log, shadow_update_cusum},
+    {"tod", shadow_prime_none, shadow_update_tod},
+};
+#define SHADOW_ENGINE_COUNT (sizeof(shadow_engines) / sizeof(shadow_engines[0]))
+
+_Static_assert(SHADOW_ENGINE_COUNT <= SHADOW_MAX_ENGINES, "raise SHADOW_MAX_ENGINES");
+
+static bool shadow_is_alarm(DimensionStatus status) {
+    return status == DimStatusUnstable || status == DimStatusForeign;
+}
+
+static void shadow_input(RealityClockState* state, ShadowInput* in) {
+    in->phi = state->phi_current;
+    in->phi_raw = calculate_phi(state->lf_raw, state->hf_raw, state->uhf_raw);
+    in->phi_tod_z = state->phi_tod_z;
+}
+
+/**
+ * @brief Start every engine from the calibration sample, scorecards cleared
+ */
+static void shadow_reset(RealityClockState* state) {
+    ShadowInput in;
+    shadow_input(state, &in);
+    memset(state->shadow, 0, sizeof(state->shadow));
+    for(size_t i = 0; i < SHADOW_ENGINE_COUNT; i++) {
+        state->shadow[i].status = DimStatusCalibrating;
+        shadow_engines[i].prime(&state->shadow[i].state, &in);
+    }
+}
+
+/**
+ * @brief Run every engine on the current sample and score it against production
+ *
+ * Called after production has classified the sample.
+ */
+static void shadow_update(RealityClockState* state) {
+    ShadowInput in;
+    shadow_input(state, &in);
+    uint32_t budget_used = 0;
+
+    for(size_t i = 0; i < SHADOW_ENGINE_COUNT; i++) {
+        ShadowEngine* engine = &state->shadow[i];
+        if(budget_used + engine->cycles_last > SHADOW_CYCLE_BUDGET) {
+            engine->skipped++;
+            continue;
+        }
+
+        uint32_t start = DWT->CYCCNT;
+        DimensionStatus status = shadow_engines[i].update(&engine->state, &in);
+        uint32_t cycles = DWT->CYCCNT - start;
+
+        budget_used += cycles;
+        engine->cycles += cycles;
+        engine->cycles_last = cycles;
+        if(cycles > engine->cycles_max) engine->cycles_max = cycles;
+
+        if(status != engine->status) {
+            if(engine->status != DimStatusCalibrating) engine->transitions++;
+            engine->timeline[engine->timeline_head] = (ShadowChange){state->total_samples, status};
+            engine->timeline_head = (uint8_t)((engine->timeline_head + 1) % SHADOW_TIMELINE_LEN);
+            if(engine->timeline_count < SHADOW_TIMELINE_LEN) engine->timeline_count++;
+            engine->status = status;
+        }
+
+        engine->samples++;
+        engine->status_samples[status]++;
+        if(status == state->status) engine->agree++;
+        if(shadow_is_alarm(status) == shadow_is_alarm(state->status)) engine->alarm_agree++;
+    }
+}
+#endif
+
+/**
+ * @brief Read every band once, DECIM_FACTOR times per sample interval
+ * @return true when the decimators have a new sample for update_readings()
+ */
+static bool sample_sensors(RealityClockState* state) {
+    bool ready;
+
+    /* A read this soon after scheduled I/O tags the sample it goes into */
+    if(state->io_recent && furi_get_tick() - state->io_last_end < IO_SETTLE_MS) {
+        state->io_read_tag |= state->io_recent;
+    }
+
 #ifdef DEBUG_MODE
     /* Read REAL sensor values from hardware */
-    read_real_sensors(state);
+    ready = read_real_sensors(state);
 #else
     /* Read simulated sensor values */
-    state->lf_raw = read_lf_raw();
-    state->hf_raw = read_hf_raw();
-    state->uhf_raw = read_uhf_raw();
+    ready = decimator_push(&state->lf_decim, read_lf_raw(), &state->lf_raw);
+    decimator_push(&state->hf_decim, read_hf_raw(), &state->hf_raw);
+    decimator_push(&state->uhf_decim, read_uhf_raw(), &state->uhf_raw);
+#endif
+
+    if(ready) {
+        state->io_sample_tag = state->io_read_tag;
+        state->io_read_tag = 0;
+        if(state->io_sample_tag) state->io_tagged_samples++;
+    }
+    return ready;
+}
+
+/**
+ * @brief Swap in the baseline a background recalibration has gathered
+ *
+ * Its CALIBRATION_SAMPLES samples are the newest in the rings, so they are
+ * all it needs: the rings drop everything older, exactly as a first
+ * calibration would have left them, and both EMAs restart from their PHI.
+ * Called from update_readings() before the averages are taken, so the
+ * sample that completes it is the first scored against the new baseline.
+ */
+static void recalibration_finish(RealityClockState* state) {
+    buffer_keep_latest(&state->lf_buffer, CALIBRATION_SAMPLES);
+    buffer_keep_latest(&state->hf_buffer, CALIBRATION_SAMPLES);
+    buffer_keep_latest(&state->uhf_buffer, CALIBRATION_SAMPLES);
+
+    float phi = calculate_phi(
+        buffer_average(&state->lf_buffer), buffer_average(&state->hf_buffer), buffer_average(&state->uhf_buffer));
+    FURI_LOG_I(
+        "RealityClock", "Recalibrated: baseline %.4f -> %.4f", (double)state->phi_baseline, (double)phi);
+    state->phi_baseline = phi;
+    state->phi_short_term = phi;
+    state->recalibrating = false;
+    state->recal_samples = 0;
+    state->recalibrations++;
+#ifdef DEBUG_SHADOW_ENGINES
+    shadow_reset(state);
 #endif
+}
 
-    /* Add to rolling buffers */
-    buffer_add(&state->lf_buffer, state->lf_raw);
-    buffer_add(&state->hf_buffer, state->hf_raw);
-    buffer_add(&state->uhf_buffer, state->uhf_raw);
+/**
+ * @brief Fold a new decimated sample into the averages, PHI and status
+ * @return CHANGED_* mask of what moved
+ */
+static uint8_t update_readings(RealityClockState* state) {
+    DimensionStatus previous_status = state->status;
+    bool was_calibrated = state->is_calibrated;
+    uint32_t now = furi_get_tick();
+    float window_avg[TIMEWIN_COUNT][3];
+    float long_avg[3];
+
+    timewin_add(&state->windows, now, state->lf_raw, state->hf_raw, state->uhf_raw);
+    for(int w = 0; w < TIMEWIN_COUNT; w++) {
+        state->window_ms[w] = timewin_average(&state->windows, w, now, window_avg[w]);
+        if(state->window_ms[w]) {
+            state->phi_window[w] = calculate_phi(window_avg[w][0], window_avg[w][1], window_avg[w][2]);
+        }
+    }
+    if(longwin_add(&state->long_windows, state->lf_raw, state->hf_raw, state->uhf_raw)) {
+        io_request(state, IoJobLongWindows);
+    }
+    for(int w = 0; w < LONGWIN_COUNT; w++) {
+        state->long_samples[w] = longwin_average(&state->long_windows, w, long_avg);
+        if(state->long_samples[w]) {
+            state->phi_long[w] = calculate_phi(long_avg[0], long_avg[1], long_avg[2]);
+        }
+    }
 
-    /* Calculate averages from buffers */
-    state->lf_avg = buffer_average(&state->lf_buffer);
-    state->hf_avg = buffer_average(&state->hf_buffer);
-    state->uhf_avg = buffer_average(&state->uhf_buffer);
+    /* Battery governor's memory-light path: the 5 min window stands in for
+       the rings, which are left alone. Calibration always fills them. */
+    bool window_path = state->is_calibrated && gov_tiers[state->gov_tier].window_averages;
+    if(!window_path || state->recalibrating) {
+        buffer_add(&state->lf_buffer, state->lf_raw);
+        buffer_add(&state->hf_buffer, state->hf_raw);
+        buffer_add(&state->uhf_buffer, state->uhf_raw);
+    }
+    if(state->recalibrating && ++state->recal_samples >= CALIBRATION_SAMPLES) {
+        recalibration_finish(state);
+    }
+
+    /* Averages from the buffers, or the window while the rings refill after that path */
+    bool refilling = state->is_calibrated && state->lf_buffer.count < CALIBRATION_SAMPLES;
+    if((window_path || refilling) && state->window_ms[0]) {
+        state->lf_avg = window_avg[0][0];
+        state->hf_avg = window_avg[0][1];
+        state->uhf_avg = window_avg[0][2];
+    } else {
+        state->lf_avg = buffer_average(&state->lf_buffer);
+        state->hf_avg = buffer_average(&state->hf_buffer);
+        state->uhf_avg = buffer_average(&state->uhf_buffer);
+    }
 
     /* Calculate Φ from AVERAGED readings (stable!) */
     state->phi_current = calculate_phi(state->lf_avg, state->hf_avg, state->uhf_avg);
 
     state->total_samples++;
 
+    profile_update(state);
+
     /* Read battery */
     state->voltage = furi_hal_power_get_battery_voltage(FuriHalPowerICFuelGauge);
     state->current_ma = furi_hal_power_get_battery_current(FuriHalPowerICFuelGauge);
@@ -588,6 +2418,9 @@ static void update_readings(RealityClockState* state) {
             state->phi_baseline = state->phi_current;
             state->phi_short_term = state->phi_current;
             state->is_calibrated = true;
+#ifdef DEBUG_SHADOW_ENGINES
+            shadow_reset(state);
+#endif
         }
     } else {
         /* ADAPTIVE BASELINE: Continuously update using EMA
@@ -611,57 +2444,44 @@ static void update_readings(RealityClockState* state) {
 
         /* Status based on stability, not fixed-baseline distance */
         state->status = classify_status(state->stability);
+#ifdef DEBUG_SHADOW_ENGINES
+        shadow_update(state);
+#endif
+
+        /* Spread of samples taken near I/O against clean ones, to see what it costs */
+        float deviation = (fabsf(state->lf_raw - state->lf_avg) + fabsf(state->hf_raw - state->hf_avg) +
+                           fabsf(state->uhf_raw - state->uhf_avg)) / 3.0f;
+        int tagged = state->io_sample_tag ? 1 : 0;
+        state->io_dev_count[tagged]++;
+        state->io_dev_mean[tagged] += (deviation - state->io_dev_mean[tagged]) / (float)state->io_dev_count[tagged];
     }
 
+    memory_telemetry_update(state);
+
 #ifdef DEBUG_MODE
 #ifdef DEBUG_LOG_TO_SD
     /* Log data to SD card */
     debug_log_write(state);
 #endif
 #endif
+
+    /* Every sample moves the averages and counters */
+    uint8_t changed = CHANGED_READINGS;
+    if(state->status != previous_status || state->is_calibrated != was_calibrated) {
+        changed |= CHANGED_STATUS;
+    }
+    if(!was_calibrated || state->recalibrating) changed |= CHANGED_PROGRESS;
+    return changed;
 }
 
 /* ============================================================================
  * QR CODE DATA - https://github.com/Eris-Margeta/flipper-apps
  * ============================================================================
- * 29x29 QR code - displayed at 2x scale (58x58 pixels on screen)
+ * Encoded from assets/qr_payload.txt by tools/assets/gen_assets.py: a 29x29
+ * QR code pre-scaled 2x to a 58x58 XBM, drawn in one canvas_draw_xbm().
  */
 
-#define QR_SIZE 29
-#define QR_BYTES_PER_ROW 4
-#define QR_SCALE 2
-
-static const uint8_t qr_code_data[] = {
-    0xFE, 0x2A, 0x9B, 0xF8,  /* Row 0 */
-    0x82, 0xA1, 0x6A, 0x08,  /* Row 1 */
-    0xBA, 0x09, 0x02, 0xE8,  /* Row 2 */
-    0xBA, 0xEF, 0xF2, 0xE8,  /* Row 3 */
-    0xBA, 0x40, 0xFA, 0xE8,  /* Row 4 */
-    0x82, 0xDB, 0x82, 0x08,  /* Row 5 */
-    0xFE, 0xAA, 0xAB, 0xF8,  /* Row 6 */
-    0x00, 0x73, 0x10, 0x00,  /* Row 7 */
-    0xFB, 0xD6, 0x0D, 0x50,  /* Row 8 */
-    0x00, 0x2A, 0xFB, 0x88,  /* Row 9 */
-    0x3F, 0xA5, 0x08, 0x80,  /* Row 10 */
-    0xC9, 0x89, 0x88, 0x50,  /* Row 11 */
-    0x36, 0x6C, 0x40, 0x60,  /* Row 12 */
-    0xFD, 0xC4, 0xAF, 0x88,  /* Row 13 */
-    0x57, 0x7B, 0x2C, 0xE0,  /* Row 14 */
-    0x80, 0xF2, 0x9F, 0x90,  /* Row 15 */
-    0x36, 0xF7, 0x55, 0x60,  /* Row 16 */
-    0xE0, 0x68, 0x97, 0xA8,  /* Row 17 */
-    0xBA, 0xC1, 0xEB, 0xA0,  /* Row 18 */
-    0x85, 0xAA, 0xAE, 0x10,  /* Row 19 */
-    0x96, 0x0E, 0x5F, 0xB8,  /* Row 20 */
-    0x00, 0xE2, 0x28, 0xF8,  /* Row 21 */
-    0xFE, 0xD9, 0xDA, 0xE0,  /* Row 22 */
-    0x82, 0x31, 0x18, 0x90,  /* Row 23 */
-    0xBA, 0xFF, 0x4F, 0xA8,  /* Row 24 */
-    0xBA, 0xAA, 0xB8, 0x78,  /* Row 25 */
-    0xBA, 0xA1, 0x1F, 0xF0,  /* Row 26 */
-    0x82, 0xD9, 0x8D, 0x50,  /* Row 27 */
-    0xFE, 0xA7, 0xD3, 0xA0,  /* Row 28 */
-};
+#include "reality_clock_assets.h"
 
 /* ============================================================================
  * SCI-FI UI DRAWING UTILITIES
@@ -810,6 +2630,12 @@ static void draw_screen_home(Canvas* canvas, RealityClockState* state) {
     }
     canvas_draw_str_aligned(canvas, 64, 56, AlignCenter, AlignCenter, status_text);
 
+    /* Background recalibration: the gap in the title line fills as it runs */
+    if(state->recalibrating) {
+        int16_t fill = (int16_t)(state->recal_samples * 66 / CALIBRATION_SAMPLES);
+        if(fill > 0) canvas_draw_line(canvas, 31, 14, 31 + fill, 14);
+    }
+
     /* Navigation hint - subtle */
     canvas_draw_str(canvas, 122, 32, ">");
 }
@@ -887,45 +2713,111 @@ static void draw_screen_bands(Canvas* canvas, RealityClockState* state) {
 }
 
 static void draw_screen_details(Canvas* canvas, RealityClockState* state) {
-#ifdef DEBUG_MODE
-    #define DETAILS_LINES_ACTUAL 17  /* Extra lines for debug info */
-#else
-    #define DETAILS_LINES_ACTUAL 14  /* Extra lines for stability info */
-#endif
-    char lines[DETAILS_LINES_ACTUAL][32];
+    char (*lines)[DETAILS_LINE_CHARS] = state->details_text;
     int line_count = 0;
 
-    snprintf(lines[line_count++], 32, "Current PHI:  %.4f", (double)state->phi_current);
-    snprintf(lines[line_count++], 32, "Short-term:   %.4f", (double)state->phi_short_term);
-    snprintf(lines[line_count++], 32, "Baseline:     %.4f", (double)state->phi_baseline);
-    snprintf(lines[line_count++], 32, "Stability:    %.1f%%", (double)state->stability);
-    snprintf(lines[line_count++], 32, "Match:        %.1f%%", (double)state->match_percent);
-    snprintf(lines[line_count++], 32, "Buffer Size:  %d", state->lf_buffer.count);
-    snprintf(lines[line_count++], 32, "Total Samples:%lu", (unsigned long)state->total_samples);
+    snprintf(lines[line_count++], DETAILS_LINE_CHARS, "Current PHI:  %.4f", (double)state->phi_current);
+    snprintf(lines[line_count++], DETAILS_LINE_CHARS, "Short-term:   %.4f", (double)state->phi_short_term);
+    snprintf(lines[line_count++], DETAILS_LINE_CHARS, "Baseline:     %.4f", (double)state->phi_baseline);
+    snprintf(lines[line_count++], DETAILS_LINE_CHARS, "Stability:    %.1f%%", (double)state->stability);
+    snprintf(lines[line_count++], DETAILS_LINE_CHARS, "Match:        %.1f%%", (double)state->match_percent);
+    snprintf(lines[line_count++], DETAILS_LINE_CHARS, "Buffer Size:  %d", state->lf_buffer.count);
+    snprintf(lines[line_count++], DETAILS_LINE_CHARS, "Total Samples:%lu", (unsigned long)state->total_samples);
+    if(isnan(state->phi_tod_z)) {
+        snprintf(lines[line_count++], DETAILS_LINE_CHARS, "PHI vs ToD:   learning");
+    } else {
+        snprintf(lines[line_count++], DETAILS_LINE_CHARS, "PHI vs ToD:   %+.2f sd", (double)state->phi_tod_z);
+    }
+    snprintf(lines[line_count++], DETAILS_LINE_CHARS, "ToD profile:  %u/%d bins",
+        profile_trained_bins(state->profile), PROFILE_BINS);
+    /* Time-weighted windows; the minutes covered until they have filled */
+    for(int w = 0; w < TIMEWIN_COUNT; w++) {
+        const char* label = w == 0 ? "PHI 5 min:" : "PHI 1 hour:";
+        if(state->window_ms[w] >= timewin_duration_ms[w]) {
+            snprintf(lines[line_count++], DETAILS_LINE_CHARS, "%-13s %.4f", label, (double)state->phi_window[w]);
+        } else {
+            snprintf(lines[line_count++], DETAILS_LINE_CHARS, "%-13s %.4f (%hum)", label,
+                (double)state->phi_window[w], (uint16_t)(state->window_ms[w] / 60000));
+        }
+    }
+    /* Exact windows paged to SD over the last N samples; the share filled until they have */
+    for(int w = 0; w < LONGWIN_COUNT; w++) {
+        char label[20];
+        snprintf(label, sizeof(label), "Last %lu:", (unsigned long)longwin_samples[w]);
+        if(state->long_samples[w] >= longwin_samples[w]) {
+            snprintf(lines[line_count++], DETAILS_LINE_CHARS, "%-13s %.4f", label, (double)state->phi_long[w]);
+        } else {
+            snprintf(lines[line_count++], DETAILS_LINE_CHARS, "%-13s %.4f (%hu%%)", label,
+                (double)state->phi_long[w], (uint16_t)(100ULL * state->long_samples[w] / longwin_samples[w]));
+        }
+    }
+    if(state->long_windows.failed) {
+        snprintf(lines[line_count++], DETAILS_LINE_CHARS, "Page reads:   %s",
+            state->long_windows.head ? "SD error" : "no SD");
+    } else {
+        snprintf(lines[line_count++], DETAILS_LINE_CHARS, "Page reads:   %lu",
+            (unsigned long)state->long_windows.page_reads);
+    }
 #ifdef DEBUG_MODE
-    snprintf(lines[line_count++], 32, "315MHz RSSI:  %.2f dBm", (double)state->rssi_315);
-    snprintf(lines[line_count++], 32, "433MHz RSSI:  %.2f dBm", (double)state->rssi_433);
-    snprintf(lines[line_count++], 32, "868MHz RSSI:  %.2f dBm", (double)state->rssi_868);
-    snprintf(lines[line_count++], 32, "Temperature:  %.1f C", (double)state->temperature);
+    snprintf(lines[line_count++], DETAILS_LINE_CHARS, "RSSI %5.1f:   %.2f dBm",
+        (double)state->band_freq[0] / 1e6, (double)state->rssi_315);
+    snprintf(lines[line_count++], DETAILS_LINE_CHARS, "RSSI %5.1f:   %.2f dBm",
+        (double)state->band_freq[1] / 1e6, (double)state->rssi_433);
+    snprintf(lines[line_count++], DETAILS_LINE_CHARS, "RSSI %5.1f:   %.2f dBm",
+        (double)state->band_freq[2] / 1e6, (double)state->rssi_868);
+    snprintf(lines[line_count++], DETAILS_LINE_CHARS, "Survey: %hurd %hums %.1fuAh",
+        state->survey_reads, (uint16_t)state->survey_ms,
+        (double)(state->survey_ms * SURVEY_RX_MA / 3600.0f));
+    snprintf(lines[line_count++], DETAILS_LINE_CHARS, "Temperature:  %.1f C", (double)state->temperature);
 #else
-    snprintf(lines[line_count++], 32, "LF Raw:       %.2f dB", (double)state->lf_raw);
-    snprintf(lines[line_count++], 32, "HF Raw:       %.2f dB", (double)state->hf_raw);
-    snprintf(lines[line_count++], 32, "UHF Raw:      %.2f dB", (double)state->uhf_raw);
+    snprintf(lines[line_count++], DETAILS_LINE_CHARS, "LF Raw:       %.2f dB", (double)state->lf_raw);
+    snprintf(lines[line_count++], DETAILS_LINE_CHARS, "HF Raw:       %.2f dB", (double)state->hf_raw);
+    snprintf(lines[line_count++], DETAILS_LINE_CHARS, "UHF Raw:      %.2f dB", (double)state->uhf_raw);
+#endif
+    snprintf(lines[line_count++], DETAILS_LINE_CHARS, "LF Avg:       %.2f dB", (double)state->lf_avg);
+    snprintf(lines[line_count++], DETAILS_LINE_CHARS, "HF Avg:       %.2f dB", (double)state->hf_avg);
+    snprintf(lines[line_count++], DETAILS_LINE_CHARS, "UHF Avg:      %.2f dB", (double)state->uhf_avg);
+    snprintf(lines[line_count++], DETAILS_LINE_CHARS, "Battery:      %.2fV", (double)state->voltage);
+    snprintf(lines[line_count++], DETAILS_LINE_CHARS, "Power tier:   %s (%hu changes)",
+        gov_tiers[state->gov_tier].name, state->gov_tier_changes);
+    if(state->gov_projected_s == UINT32_MAX) {
+        snprintf(lines[line_count++], DETAILS_LINE_CHARS, "Runtime left: charging");
+    } else {
+        snprintf(lines[line_count++], DETAILS_LINE_CHARS, "Runtime left: %hu min",
+            (uint16_t)(state->gov_projected_s / 60 < 65535 ? state->gov_projected_s / 60 : 65535));
+    }
+    snprintf(lines[line_count++], DETAILS_LINE_CHARS, "I/O waits:    %lu", (unsigned long)state->io_deferred);
+    snprintf(lines[line_count++], DETAILS_LINE_CHARS, "Near I/O:     %lu", (unsigned long)state->io_tagged_samples);
+    /* Mean distance from the averages: samples near I/O / clean samples */
+    snprintf(lines[line_count++], DETAILS_LINE_CHARS, "I/O spread:   %.2f/%.2f dB",
+        (double)state->io_dev_mean[1], (double)state->io_dev_mean[0]);
+    snprintf(lines[line_count++], DETAILS_LINE_CHARS, "Input drops:  %lu", (unsigned long)state->input_dropped);
+    snprintf(lines[line_count++], DETAILS_LINE_CHARS, "Heap free:    %lu", (unsigned long)state->heap_free);
+    snprintf(lines[line_count++], DETAILS_LINE_CHARS, "Heap min:     %lu", (unsigned long)state->heap_min_free);
+    snprintf(lines[line_count++], DETAILS_LINE_CHARS, "Stack free:   %lu", (unsigned long)state->stack_free);
+    snprintf(lines[line_count++], DETAILS_LINE_CHARS, "Arena:        %lu B", (unsigned long)state->arena.size);
+#ifdef DEBUG_SHADOW_ENGINES
+    /* Per engine: agreement with production, status changes, mean update time */
+    for(size_t i = 0; i < SHADOW_ENGINE_COUNT; i++) {
+        const ShadowEngine* engine = &state->shadow[i];
+        uint8_t agree = engine->samples ? (uint8_t)(100ULL * engine->agree / engine->samples) : 0;
+        uint16_t changes = engine->transitions < 65535 ? (uint16_t)engine->transitions : 65535;
+        uint64_t ns = engine->samples ?
+            engine->cycles * 1000 / SHADOW_CPU_MHZ / engine->samples : 0;
+        snprintf(lines[line_count++], DETAILS_LINE_CHARS, "%-6.6s agr%3hhu%% ch%5hu %5huns",
+            shadow_engines[i].name, agree, changes, (uint16_t)(ns < 65535 ? ns : 65535));
+    }
 #endif
-    snprintf(lines[line_count++], 32, "LF Avg:       %.2f dB", (double)state->lf_avg);
-    snprintf(lines[line_count++], 32, "HF Avg:       %.2f dB", (double)state->hf_avg);
-    snprintf(lines[line_count++], 32, "UHF Avg:      %.2f dB", (double)state->uhf_avg);
-    snprintf(lines[line_count++], 32, "Battery:      %.2fV", (double)state->voltage);
 #ifdef DEBUG_MODE
 #ifdef DEBUG_LOG_TO_SD
-    snprintf(lines[line_count++], 32, "Logging:      %s", state->log_active ? "ACTIVE" : "OFF");
+    snprintf(lines[line_count++], DETAILS_LINE_CHARS, "Logging:      %s", state->log_active ? "ACTIVE" : "OFF");
 #endif
 #endif
 
     canvas_set_font(canvas, FontSecondary);
     canvas_draw_str(canvas, 2, 8, "DETAILS");
 
-    char scroll_buf[16];
+    char scroll_buf[24];
     snprintf(scroll_buf, sizeof(scroll_buf), "[%d-%d/%d]",
         state->scroll_offset + 1,
         state->scroll_offset + DETAILS_VISIBLE,
@@ -954,23 +2846,9 @@ static void draw_screen_details(Canvas* canvas, RealityClockState* state) {
 static void draw_screen_info(Canvas* canvas, RealityClockState* state) {
     UNUSED(state);
 
-    /* Draw QR code at 2x scale - 58x58 pixels, centered vertically */
-    int16_t qr_x = 2;
-    int16_t qr_y = (SCREEN_HEIGHT - QR_SIZE * QR_SCALE) / 2;
-
-    for(int row = 0; row < QR_SIZE; row++) {
-        for(int col = 0; col < QR_SIZE; col++) {
-            int byte_idx = row * QR_BYTES_PER_ROW + col / 8;
-            int bit_idx = 7 - (col % 8);
-            if(qr_code_data[byte_idx] & (1 << bit_idx)) {
-                /* Draw 2x2 pixel block for each QR module */
-                canvas_draw_box(canvas,
-                    qr_x + col * QR_SCALE,
-                    qr_y + row * QR_SCALE,
-                    QR_SCALE, QR_SCALE);
-            }
-        }
-    }
+    /* Draw QR code - 58x58 pixels, centered vertically */
+    canvas_draw_xbm(canvas, 2, (SCREEN_HEIGHT - QR_CODE_XBM_HEIGHT) / 2,
+        QR_CODE_XBM_WIDTH, QR_CODE_XBM_HEIGHT, qr_code_xbm);
 
     /* Minimal text on right side */
     canvas_set_font(canvas, FontSecondary);
@@ -993,14 +2871,14 @@ static void draw_screen_menu(Canvas* canvas, RealityClockState* state) {
     /* Menu items */
     canvas_set_font(canvas, FontPrimary);
 
-    const char* items[] = {"CALIBRATE", "BRIGHTNESS"};
+    const char* items[] = {"CALIBRATE", "BRIGHTNESS", "RUN UNTIL"};
 
     for(int i = 0; i < MENU_ITEM_COUNT; i++) {
-        int16_t y = 28 + i * 16;
+        int16_t y = 25 + i * 12;
 
         if(i == state->menu_selection) {
             /* Selected item - draw highlight box */
-            canvas_draw_box(canvas, 20, y - 8, 88, 14);
+            canvas_draw_box(canvas, 20, y - 6, 88, 12);
             canvas_set_color(canvas, ColorWhite);
             canvas_draw_str_aligned(canvas, 64, y, AlignCenter, AlignCenter, items[i]);
             canvas_set_color(canvas, ColorBlack);
@@ -1044,57 +2922,283 @@ static void draw_screen_brightness(Canvas* canvas, RealityClockState* state) {
         canvas_draw_box(canvas, bar_x + 1, bar_y + 1, fill_w, bar_h - 2);
     }
 
-    /* Navigation hint */
-    canvas_set_font(canvas, FontSecondary);
-    canvas_draw_str_aligned(canvas, 64, 58, AlignCenter, AlignCenter, "L/R=Adjust  Back=Done");
+    /* Navigation hint */
+    canvas_set_font(canvas, FontSecondary);
+    canvas_draw_str_aligned(canvas, 64, 58, AlignCenter, AlignCenter, "L/R=Adjust  Back=Done");
+}
+
+static void draw_screen_run_until(Canvas* canvas, RealityClockState* state) {
+    /* Draw sci-fi corners */
+    draw_scifi_corners(canvas);
+
+    /* Title */
+    canvas_set_font(canvas, FontSecondary);
+    canvas_draw_str_aligned(canvas, 64, 8, AlignCenter, AlignCenter, "RUN UNTIL");
+    draw_scifi_lines(canvas, 14);
+
+    /* Target time of day */
+    char buf[24];
+    if(state->run_until == GOV_RUN_UNTIL_OFF) {
+        canvas_set_font(canvas, FontPrimary);
+        canvas_draw_str_aligned(canvas, 64, 30, AlignCenter, AlignCenter, "OFF");
+    } else {
+        snprintf(buf, sizeof(buf), "%02u:%02u", (unsigned)(state->run_until / 60 % 24),
+            (unsigned)(state->run_until % 60));
+        canvas_set_font(canvas, FontBigNumbers);
+        canvas_draw_str_aligned(canvas, 64, 30, AlignCenter, AlignCenter, buf);
+    }
+
+    /* What the battery is projected to last at the current tier */
+    canvas_set_font(canvas, FontSecondary);
+    if(state->gov_projected_s == UINT32_MAX) {
+        snprintf(buf, sizeof(buf), "Charging  %s", gov_tiers[state->gov_tier].name);
+    } else {
+        snprintf(buf, sizeof(buf), "Battery %hu.%huh  %s",
+            (uint16_t)(state->gov_projected_s / 3600 % 1000), (uint16_t)(state->gov_projected_s / 360 % 10),
+            gov_tiers[state->gov_tier].name);
+    }
+    canvas_draw_str_aligned(canvas, 64, 46, AlignCenter, AlignCenter, buf);
+
+    /* Navigation hint */
+    canvas_draw_str_aligned(canvas, 64, 58, AlignCenter, AlignCenter, "L/R=Adjust  Back=Done");
+}
+
+/**
+ * @brief Apply brightness via notification settings (NightStand Clock approach)
+ *
+ * Directly modifies the notification app's internal brightness setting,
+ * then triggers a backlight update. This avoids flickering because the
+ * system uses our value instead of overriding it.
+ *
+ * @param state      Application state (contains notification handle)
+ * @param brightness Brightness percentage (0-100), capped by the battery tier
+ */
+static void apply_brightness(RealityClockState* state, uint8_t brightness) {
+    if(state->notification == NULL) return;
+    if(brightness > gov_tiers[state->gov_tier].brightness_cap) {
+        brightness = gov_tiers[state->gov_tier].brightness_cap;
+    }
+
+    /* Set brightness in notification settings (0.0 - 1.0) */
+    state->notification->settings.display_brightness = (float)brightness / 100.0f;
+
+    /* Trigger backlight update with new brightness value, between radio reads */
+    io_request(state, IoJobBacklight);
+}
+
+/* ============================================================================
+ * SETTINGS
+ * Brightness, the carousel screen, the Run Until target and the battery
+ * tier thresholds persist in SETTINGS_PATH. The thresholds are only set by
+ * editing the file. The file is
+ * read once at startup; keypresses only change RAM, and the main loop
+ * writes back after SETTINGS_SAVE_DELAY_MS without input, or on exit.
+ * ============================================================================ */
+
+/** Screen registry, defined below once every handler exists */
+static const ScreenDef screens[SCREEN_COUNT];
+
+/** The carousel screen to reopen on: the current one, or the one the menu came from */
+static uint8_t settings_screen(RealityClockState* state) {
+    return screens[state->current_screen].in_carousel ? state->current_screen : state->previous_screen;
+}
+
+static bool settings_modified(RealityClockState* state) {
+    return state->brightness != state->saved_brightness ||
+           settings_screen(state) != state->saved_screen ||
+           state->run_until != state->saved_run_until;
 }
 
 /**
- * @brief Apply brightness via notification settings (NightStand Clock approach)
+ * @brief Read SETTINGS_PATH over the defaults already in @p state
  *
- * Directly modifies the notification app's internal brightness setting,
- * then triggers a backlight update. This avoids flickering because the
- * system uses our value instead of overriding it.
+ * A missing file, another file type or version, or a value out of range
+ * leaves the corresponding default in place. Optional keys are looked up
+ * from the top: a failed lookup leaves the stream at the end of the file.
  *
- * @param state      Application state (contains notification handle)
- * @param brightness Brightness percentage (0-100)
+ * @return true if the brightness came from the file
  */
-static void apply_brightness(RealityClockState* state, uint8_t brightness) {
-    if(state->notification == NULL) return;
+static bool settings_load(RealityClockState* state) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FlipperFormat* file = flipper_format_file_alloc(storage);
+    FuriString* filetype = furi_string_alloc();
+    uint32_t version = 0;
+    uint32_t value = 0;
+    uint32_t tier_pct[GOV_TIER_COUNT - 1];
+    bool loaded = false;
+
+    if(flipper_format_file_open_existing(file, SETTINGS_PATH) &&
+       flipper_format_read_header(file, filetype, &version) &&
+       furi_string_equal_str(filetype, SETTINGS_FILETYPE) && version == SETTINGS_VERSION) {
+        if(flipper_format_read_uint32(file, "Brightness", &value, 1) && value <= BRIGHTNESS_MAX) {
+            state->brightness = (uint8_t)(value / BRIGHTNESS_STEP * BRIGHTNESS_STEP);
+            loaded = true;
+        }
+        if(flipper_format_read_uint32(file, "Screen", &value, 1) &&
+           value < SCREEN_COUNT && screens[value].in_carousel) {
+            state->current_screen = (uint8_t)value;
+            state->previous_screen = (uint8_t)value;
+        }
+        if(flipper_format_rewind(file) && flipper_format_read_uint32(file, "Run Until", &value, 1) &&
+           value < 24 * 60 && value % GOV_RUN_UNTIL_STEP == 0) {
+            state->run_until = (uint16_t)value;
+        }
+        /* Below 100 and strictly falling, or the defaults stay */
+        if(flipper_format_rewind(file) &&
+           flipper_format_read_uint32(file, "Tier Percent", tier_pct, GOV_TIER_COUNT - 1)) {
+            bool valid = true;
+            for(int i = 0; i < GOV_TIER_COUNT - 1; i++) {
+                uint32_t above = i == 0 ? 100 : tier_pct[i - 1];
+                if(tier_pct[i] >= above) valid = false;
+            }
+            for(int i = 0; valid && i < GOV_TIER_COUNT - 1; i++) {
+                state->gov_tier_pct[i + 1] = (uint8_t)tier_pct[i];
+            }
+        }
+    }
 
-    /* Set brightness in notification settings (0.0 - 1.0) */
-    state->notification->settings.display_brightness = (float)brightness / 100.0f;
+    furi_string_free(filetype);
+    flipper_format_free(file);
+    furi_record_close(RECORD_STORAGE);
 
-    /* Trigger backlight update with new brightness value */
-    notification_message((NotificationApp*)state->notification, &sequence_display_backlight_on);
+    state->saved_brightness = state->brightness;
+    state->saved_screen = settings_screen(state);
+    state->saved_run_until = state->run_until;
+    return loaded;
 }
 
+/**
+ * @brief Write the settings back if they differ from the file
+ *
+ * Nothing is written when a change was undone before the save came due.
+ * On failure the saved copy is left stale, so the exit save retries.
+ */
+static void settings_save(RealityClockState* state) {
+    state->settings_save_pending = false;
+    if(!settings_modified(state)) return;
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    storage_common_mkdir(storage, SETTINGS_DIR);
+    FlipperFormat* file = flipper_format_file_alloc(storage);
+    uint32_t brightness = state->brightness;
+    uint32_t screen = settings_screen(state);
+    uint32_t run_until = state->run_until;
+    uint32_t tier_pct[GOV_TIER_COUNT - 1];
+    for(int i = 0; i < GOV_TIER_COUNT - 1; i++) tier_pct[i] = state->gov_tier_pct[i + 1];
+
+    /* Run Until is left out when off */
+    if(flipper_format_file_open_always(file, SETTINGS_PATH) &&
+       flipper_format_write_header_cstr(file, SETTINGS_FILETYPE, SETTINGS_VERSION) &&
+       flipper_format_write_uint32(file, "Brightness", &brightness, 1) &&
+       flipper_format_write_uint32(file, "Screen", &screen, 1) &&
+       (run_until == GOV_RUN_UNTIL_OFF || flipper_format_write_uint32(file, "Run Until", &run_until, 1)) &&
+       flipper_format_write_uint32(file, "Tier Percent", tier_pct, GOV_TIER_COUNT - 1)) {
+        state->saved_brightness = (uint8_t)brightness;
+        state->saved_screen = (uint8_t)screen;
+        state->saved_run_until = (uint16_t)run_until;
+    } else {
+        FURI_LOG_W("RealityClock", "Cannot write %s", SETTINGS_PATH);
+    }
 
-static void render_callback(Canvas* canvas, void* ctx) {
-    RealityClockState* state = (RealityClockState*)ctx;
-    canvas_clear(canvas);
+    flipper_format_free(file);
+    furi_record_close(RECORD_STORAGE);
+}
 
-    switch(state->current_screen) {
-        case SCREEN_HOME:
-            draw_screen_home(canvas, state);
-            break;
-        case SCREEN_BANDS:
-            draw_screen_bands(canvas, state);
+/* ============================================================================
+ * I/O SCHEDULER
+ * SD writes and backlight updates are requested wherever they come up and
+ * run by the main loop in the gap after a radio read, only if the job's
+ * recent worst run time plus IO_SETTLE_MS still fits before the next read.
+ * The backlight change itself happens on the notification thread, and the
+ * card stays busy after a sync returns, so IO_SETTLE_MS covers both. A job
+ * that has waited IO_MAX_DEFER_MS (gaps are only 25 ms during calibration)
+ * runs anyway and pushes the next read back instead, as does a job that
+ * ran past its estimate.
+ *
+ * A read that still lands within IO_SETTLE_MS of a job tags its sample.
+ * That should not happen; the tag is how to check on a device.
+ * The tag is the io_near column of the log; the Details screen compares the
+ * spread of tagged and clean samples.
+ * ============================================================================ */
+
+static void io_request(RealityClockState* state, IoJob job) {
+    if(state->io_pending & (1u << job)) return;
+    state->io_pending |= (uint8_t)(1u << job);
+    state->io_requested[job] = furi_get_tick();
+}
+
+static void io_run_job(RealityClockState* state, IoJob job) {
+    uint32_t start = furi_get_tick();
+    state->io_pending &= (uint8_t)~(1u << job);
+    state->io_waiting &= (uint8_t)~(1u << job);
+
+    switch(job) {
+        case IoJobBacklight:
+            notification_message((NotificationApp*)state->notification, &sequence_display_backlight_on);
             break;
-        case SCREEN_DETAILS:
-            draw_screen_details(canvas, state);
+        case IoJobLogFlush:
+#if defined(DEBUG_MODE) && defined(DEBUG_LOG_TO_SD)
+            debug_log_flush(state);
+#endif
             break;
-        case SCREEN_INFO:
-            draw_screen_info(canvas, state);
+        case IoJobSettingsSave:
+            settings_save(state);
             break;
-        case SCREEN_MENU:
-            draw_screen_menu(canvas, state);
+        case IoJobProfileSave:
+            profile_save(state);
             break;
-        case SCREEN_BRIGHTNESS:
-            draw_screen_brightness(canvas, state);
+        case IoJobLongWindows:
+            longwin_service(&state->long_windows);
             break;
         default:
-            draw_screen_home(canvas, state);
+            break;
+    }
+
+    /* Take a new worst case at once, let a spike fade over a few runs */
+    uint32_t end = furi_get_tick();
+    uint32_t took = end - start;
+    if(took > 0xFFFF) took = 0xFFFF;
+    if(took >= state->io_cost_ms[job]) {
+        state->io_cost_ms[job] = (uint16_t)took;
+    } else {
+        state->io_cost_ms[job] -= (uint16_t)((state->io_cost_ms[job] - took + 7) / 8);
+    }
+
+    if(end - state->io_last_end >= IO_SETTLE_MS) state->io_recent = 0;
+    state->io_recent |= (uint8_t)(1u << job);
+    state->io_last_end = end;
+}
+
+/**
+ * @brief Run the pending jobs that fit before @p next_read
+ *
+ * An overdue job runs regardless. Whenever the last job ended less than
+ * IO_SETTLE_MS before @p next_read, the read moves back to leave that gap.
+ */
+static void io_run_pending(RealityClockState* state, uint32_t* next_read) {
+    for(int job = 0; job < IoJobCount; job++) {
+        if(!(state->io_pending & (1u << job))) continue;
+
+        uint32_t now = furi_get_tick();
+        int32_t gap = (int32_t)(*next_read - now);
+        bool overdue = now - state->io_requested[job] >= IO_MAX_DEFER_MS;
+        if(gap < (int32_t)(state->io_cost_ms[job] + IO_SETTLE_MS) && !overdue) {
+            /* Counted once, when the job first has to wait */
+            if(!(state->io_waiting & (1u << job))) {
+                state->io_waiting |= (uint8_t)(1u << job);
+                state->io_deferred++;
+            }
+            continue;
+        }
+
+        io_run_job(state, (IoJob)job);
+    }
+
+    /* A job that overran its estimate, or a log block flushed inline, still
+       gets its quiet time */
+    if(state->io_recent && (int32_t)(*next_read - state->io_last_end) < IO_SETTLE_MS) {
+        *next_read = state->io_last_end + IO_SETTLE_MS;
+        state->io_delayed_reads++;
     }
 }
 
@@ -1102,16 +3206,63 @@ static void render_callback(Canvas* canvas, void* ctx) {
  * INPUT
  * ============================================================================ */
 
+/**
+ * @brief Forward input to the main loop without ever blocking the input thread
+ *
+ * While the main loop is busy (radio dwells, SD writes), at most one Repeat
+ * is queued; later repeats are merged into it. The main loop only acts on
+ * Press and Repeat, so the last INPUT_PRESS_RESERVE slots are kept for
+ * presses. Whatever still does not fit is dropped and counted instead of
+ * stalling the GUI.
+ */
 static void input_callback(InputEvent* event, void* ctx) {
-    FuriMessageQueue* queue = (FuriMessageQueue*)ctx;
-    furi_message_queue_put(queue, event, FuriWaitForever);
+    RealityClockState* state = (RealityClockState*)ctx;
+    bool repeat = (event->type == InputTypeRepeat);
+
+    if(event->type != InputTypePress &&
+       furi_message_queue_get_space(state->event_queue) <= INPUT_PRESS_RESERVE) {
+        state->input_dropped++;
+        return;
+    }
+
+    if(repeat) {
+        if(state->input_repeat_queued) {
+            state->input_coalesced++;
+            return;
+        }
+        state->input_repeat_queued = true;
+    }
+
+    if(furi_message_queue_put(state->event_queue, event, 0) != FuriStatusOk) {
+        state->input_dropped++;
+        if(repeat) state->input_repeat_queued = false;
+        return;
+    }
+
+    uint32_t depth = furi_message_queue_get_count(state->event_queue);
+    if(depth > state->input_queue_peak) state->input_queue_peak = depth;
 }
 
+/**
+ * @brief CALIBRATE from the menu
+ *
+ * Once calibrated, recalibration runs in the background: the next
+ * CALIBRATION_SAMPLES samples (at the calibration rate) are gathered while
+ * the old baseline keeps scoring them, then recalibration_finish() swaps
+ * the new one in. Before that there is no baseline to keep, so the first
+ * calibration simply starts over.
+ */
 static void do_calibrate(RealityClockState* state) {
+    if(state->is_calibrated) {
+        state->recalibrating = true;
+        state->recal_samples = 0;
+        return;
+    }
+
     state->is_calibrated = false;
-    buffer_init(&state->lf_buffer);
-    buffer_init(&state->hf_buffer);
-    buffer_init(&state->uhf_buffer);
+    buffer_reset(&state->lf_buffer);
+    buffer_reset(&state->hf_buffer);
+    buffer_reset(&state->uhf_buffer);
     state->total_samples = 0;
     state->phi_baseline = 0;
     state->phi_short_term = 0;
@@ -1119,126 +3270,317 @@ static void do_calibrate(RealityClockState* state) {
     state->stability = 0;
 }
 
-static void process_input(RealityClockState* state, InputEvent* event) {
-    /* Only process actions for Press and Repeat events */
-    if(event->type != InputTypePress && event->type != InputTypeRepeat) {
-        return;
-    }
-
-    /* Handle brightness screen */
-    if(state->current_screen == SCREEN_BRIGHTNESS) {
-        switch(event->key) {
-            case InputKeyLeft:
-                if(state->brightness >= BRIGHTNESS_STEP) {
-                    state->brightness -= BRIGHTNESS_STEP;
-                    apply_brightness(state, state->brightness);
-                    state->brightness_refresh_time = furi_get_tick() + BRIGHTNESS_REFRESH_MS;
-                }
-                break;
-            case InputKeyRight:
-                if(state->brightness <= BRIGHTNESS_MAX - BRIGHTNESS_STEP) {
-                    state->brightness += BRIGHTNESS_STEP;
-                    apply_brightness(state, state->brightness);
-                    state->brightness_refresh_time = furi_get_tick() + BRIGHTNESS_REFRESH_MS;
-                }
-                break;
-            case InputKeyBack:
-            case InputKeyOk:
-                /* Return to menu */
-                state->current_screen = SCREEN_MENU;
-                break;
-            default:
-                break;
-        }
-        return;
-    }
-
-    /* Handle menu screen */
-    if(state->current_screen == SCREEN_MENU) {
-        switch(event->key) {
-            case InputKeyUp:
-                if(state->menu_selection > 0) {
-                    state->menu_selection--;
-                }
-                break;
-            case InputKeyDown:
-                if(state->menu_selection < MENU_ITEM_COUNT - 1) {
-                    state->menu_selection++;
-                }
-                break;
-            case InputKeyOk:
-                if(state->menu_selection == MENU_ITEM_CALIBRATE) {
-                    do_calibrate(state);
-                    state->current_screen = state->previous_screen;
-                } else if(state->menu_selection == MENU_ITEM_BRIGHTNESS) {
-                    state->current_screen = SCREEN_BRIGHTNESS;
-                }
-                break;
-            case InputKeyBack:
-                state->current_screen = state->previous_screen;
-                break;
-            default:
-                break;
+/**
+ * @brief Move LEFT/RIGHT to the next screen that is part of the carousel
+ * @param direction -1 for left, +1 for right; stops at either end
+ */
+static void carousel_step(RealityClockState* state, int direction) {
+    for(int i = (int)state->current_screen + direction; i >= 0 && i < SCREEN_COUNT; i += direction) {
+        if(screens[i].in_carousel) {
+            state->current_screen = (uint8_t)i;
+            state->scroll_offset = 0;
+            return;
         }
-        return;
     }
+}
 
-    /* Handle normal screens (HOME, BANDS, DETAILS, INFO) */
+/** Input for the carousel screens (HOME, BANDS, INFO) */
+static void input_carousel(RealityClockState* state, InputEvent* event) {
     switch(event->key) {
         case InputKeyLeft:
-            if(state->current_screen > 0) {
-                state->current_screen--;
-                state->scroll_offset = 0;
-            }
+            carousel_step(state, -1);
             break;
 
         case InputKeyRight:
-            if(state->current_screen < SCREEN_INFO) {
-                state->current_screen++;
-                state->scroll_offset = 0;
-            }
+            carousel_step(state, 1);
             break;
 
+        case InputKeyOk:
+            /* Open menu */
+            state->previous_screen = state->current_screen;
+            state->current_screen = SCREEN_MENU;
+            state->menu_selection = 0;
+            break;
+
+        case InputKeyBack:
+            state->is_running = false;
+            break;
+
+        default:
+            break;
+    }
+}
+
+/** Input for the details screen: UP/DOWN scroll, everything else as the carousel */
+static void input_details(RealityClockState* state, InputEvent* event) {
+    switch(event->key) {
         case InputKeyUp:
-            /* Only scroll on details screen */
-            if(state->current_screen == SCREEN_DETAILS && state->scroll_offset > 0) {
+            if(state->scroll_offset > 0) {
                 state->scroll_offset--;
             }
             break;
 
         case InputKeyDown:
-            /* Only scroll on details screen */
-            if(state->current_screen == SCREEN_DETAILS) {
-                if(state->scroll_offset + DETAILS_VISIBLE < DETAILS_LINES) {
-                    state->scroll_offset++;
-                }
+            if(state->scroll_offset + DETAILS_VISIBLE < DETAILS_LINES) {
+                state->scroll_offset++;
             }
             break;
 
+        default:
+            input_carousel(state, event);
+    }
+}
+
+static void input_menu(RealityClockState* state, InputEvent* event) {
+    switch(event->key) {
+        case InputKeyUp:
+            if(state->menu_selection > 0) {
+                state->menu_selection--;
+            }
+            break;
+        case InputKeyDown:
+            if(state->menu_selection < MENU_ITEM_COUNT - 1) {
+                state->menu_selection++;
+            }
+            break;
         case InputKeyOk:
-            /* Open menu */
-            state->previous_screen = state->current_screen;
-            state->current_screen = SCREEN_MENU;
-            state->menu_selection = 0;
+            if(state->menu_selection == MENU_ITEM_CALIBRATE) {
+                do_calibrate(state);
+                state->current_screen = state->previous_screen;
+            } else if(state->menu_selection == MENU_ITEM_BRIGHTNESS) {
+                state->current_screen = SCREEN_BRIGHTNESS;
+            } else if(state->menu_selection == MENU_ITEM_RUN_UNTIL) {
+                state->current_screen = SCREEN_RUN_UNTIL;
+            }
+            break;
+        case InputKeyBack:
+            state->current_screen = state->previous_screen;
+            break;
+        default:
             break;
+    }
+}
 
+static void input_brightness(RealityClockState* state, InputEvent* event) {
+    switch(event->key) {
+        case InputKeyLeft:
+            if(state->brightness >= BRIGHTNESS_STEP) {
+                state->brightness -= BRIGHTNESS_STEP;
+                apply_brightness(state, state->brightness);
+                state->brightness_refresh_time = furi_get_tick() + BRIGHTNESS_REFRESH_MS;
+            }
+            break;
+        case InputKeyRight:
+            if(state->brightness <= BRIGHTNESS_MAX - BRIGHTNESS_STEP) {
+                state->brightness += BRIGHTNESS_STEP;
+                apply_brightness(state, state->brightness);
+                state->brightness_refresh_time = furi_get_tick() + BRIGHTNESS_REFRESH_MS;
+            }
+            break;
         case InputKeyBack:
-            state->is_running = false;
+        case InputKeyOk:
+            /* Return to menu */
+            state->current_screen = SCREEN_MENU;
+            break;
+        default:
             break;
+    }
+}
+
+/**
+ * @brief LEFT/RIGHT step Run Until by GOV_RUN_UNTIL_STEP minutes, through OFF
+ */
+static void input_run_until(RealityClockState* state, InputEvent* event) {
+    const uint16_t steps = 24 * 60 / GOV_RUN_UNTIL_STEP;
+    /* Step index: 0..steps-1 are times of day, steps is OFF */
+    uint16_t index = state->run_until == GOV_RUN_UNTIL_OFF ? steps : state->run_until / GOV_RUN_UNTIL_STEP;
 
+    switch(event->key) {
+        case InputKeyLeft:
+        case InputKeyRight:
+            index = (index + (event->key == InputKeyRight ? 1 : steps)) % (steps + 1);
+            state->run_until = index == steps ? GOV_RUN_UNTIL_OFF : index * GOV_RUN_UNTIL_STEP;
+            governor_set_target(state);
+            break;
+        case InputKeyBack:
+        case InputKeyOk:
+            /* Return to menu */
+            state->current_screen = SCREEN_MENU;
+            break;
         default:
             break;
     }
 }
 
+/* ============================================================================
+ * SCREEN REGISTRY
+ * Each screen declares how it draws, how it handles input and when it needs
+ * a redraw. Adding a screen means adding a SCREEN_* id and a row here.
+ * ============================================================================ */
+
+static const ScreenDef screens[SCREEN_COUNT] = {
+    [SCREEN_HOME] = {
+        .draw = draw_screen_home,
+        .input = input_carousel,
+        .refresh = ScreenRefreshOnSample,
+        .depends = CHANGED_STATUS | CHANGED_PROGRESS,
+        .in_carousel = true,
+    },
+    [SCREEN_BANDS] = {
+        .draw = draw_screen_bands,
+        .input = input_carousel,
+        .refresh = ScreenRefreshOnSample,
+        .depends = CHANGED_READINGS,
+        .in_carousel = true,
+    },
+    [SCREEN_DETAILS] = {
+        .draw = draw_screen_details,
+        .input = input_details,
+        .refresh = ScreenRefreshOnSample,
+        .depends = CHANGED_READINGS | CHANGED_STATUS | CHANGED_GOVERNOR,
+        .in_carousel = true,
+    },
+    [SCREEN_INFO] = {
+        .draw = draw_screen_info,
+        .input = input_carousel,
+        .refresh = ScreenRefreshStatic,
+        .in_carousel = true,
+    },
+    [SCREEN_MENU] = {
+        .draw = draw_screen_menu,
+        .input = input_menu,
+        .refresh = ScreenRefreshStatic,
+    },
+    [SCREEN_BRIGHTNESS] = {
+        .draw = draw_screen_brightness,
+        .input = input_brightness,
+        .refresh = ScreenRefreshStatic,
+    },
+    [SCREEN_RUN_UNTIL] = {
+        .draw = draw_screen_run_until,
+        .input = input_run_until,
+        .refresh = ScreenRefreshOnSample,
+        .depends = CHANGED_GOVERNOR,
+    },
+};
+
+static const ScreenDef* current_screen_def(RealityClockState* state) {
+    return &screens[state->current_screen < SCREEN_COUNT ? state->current_screen : SCREEN_HOME];
+}
+
+static void render_callback(Canvas* canvas, void* ctx) {
+    RealityClockState* state = (RealityClockState*)ctx;
+    canvas_clear(canvas);
+    current_screen_def(state)->draw(canvas, state);
+}
+
+/**
+ * @brief Dispatch an input event to the current screen
+ * @return true if the event was handled and the screen needs a redraw
+ */
+static bool process_input(RealityClockState* state, InputEvent* event) {
+    /* Only process actions for Press and Repeat events */
+    if(event->type != InputTypePress && event->type != InputTypeRepeat) {
+        return false;
+    }
+
+    current_screen_def(state)->input(state, event);
+    return true;
+}
+
+/**
+ * @brief Whether a sample or governor check that changed @p changed (CHANGED_* mask) needs a redraw
+ */
+static bool screen_needs_redraw(RealityClockState* state, uint8_t changed) {
+    const ScreenDef* screen = current_screen_def(state);
+    return screen->refresh == ScreenRefreshOnSample && (screen->depends & changed) != 0;
+}
+
+/**
+ * @brief Whether a ScreenRefreshOnTimer screen is due a redraw at @p now
+ *
+ * The next deadline counts from the redraw, so a late loop skips the frames
+ * it missed instead of drawing them back to back.
+ */
+static bool screen_timer_due(const ScreenDef* screen, uint32_t now, uint32_t* next_redraw) {
+    if(screen->refresh != ScreenRefreshOnTimer || (int32_t)(now - *next_redraw) < 0) return false;
+    *next_redraw = now + 1000 / screen->refresh_hz;
+    return true;
+}
+
+/* ============================================================================
+ * INPUT RECORDING (DEBUG_INPUT_RECORD only)
+ * Writes "+<delay_ms> <key> <type>" lines replayable by tools/host/replay.c
+ * ============================================================================ */
+
+#ifdef DEBUG_INPUT_RECORD
+static void input_record_open(RealityClockState* state) {
+    state->record_storage = furi_record_open(RECORD_STORAGE);
+    storage_common_mkdir(state->record_storage, INPUT_RECORD_DIR);
+
+    state->record_file = storage_file_alloc(state->record_storage);
+    if(!storage_file_open(state->record_file, INPUT_RECORD_PATH, FSAM_WRITE, FSOM_CREATE_ALWAYS)) {
+        storage_file_free(state->record_file);
+        state->record_file = NULL;
+    }
+    state->record_last_tick = furi_get_tick();
+}
+
+static void input_record_event(RealityClockState* state, const InputEvent* event) {
+    static const char* const key_names[] = {"up", "down", "right", "left", "ok", "back"};
+    static const char* const type_names[] = {"press", "release", "short", "long", "repeat"};
+
+    if(state->record_file == NULL) return;
+    if(event->key >= InputKeyMAX || event->type >= InputTypeMAX) return;
+
+    uint32_t now = furi_get_tick();
+    char line[40];
+    int len = snprintf(line, sizeof(line), "+%lu %s %s\n",
+        (unsigned long)(now - state->record_last_tick),
+        key_names[event->key],
+        type_names[event->type]);
+    storage_file_write(state->record_file, line, len);
+    state->record_last_tick = now;
+}
+
+static void input_record_close(RealityClockState* state) {
+    if(state->record_file) {
+        storage_file_close(state->record_file);
+        storage_file_free(state->record_file);
+        state->record_file = NULL;
+    }
+    furi_record_close(RECORD_STORAGE);
+    state->record_storage = NULL;
+}
+#endif /* DEBUG_INPUT_RECORD */
+
 /* ============================================================================
  * LIFECYCLE
  * ============================================================================ */
 
 static RealityClockState* state_alloc(void) {
-    RealityClockState* state = malloc(sizeof(RealityClockState));
-    furi_check(state != NULL);  /* Abort if allocation fails */
-    memset(state, 0, sizeof(RealityClockState));
+    /* Measure the layout, then carve it out of one zeroed block */
+    Arena arena = {0};
+    SessionLayout layout;
+    session_layout(&arena, &layout);
+
+    arena.size = arena.used;
+    arena.used = 0;
+    arena.base = malloc(arena.size);
+    furi_check(arena.base != NULL);  /* Abort if allocation fails */
+    memset(arena.base, 0, arena.size);
+    session_layout(&arena, &layout);
+
+    RealityClockState* state = layout.state;
+    state->arena = arena;
+    state->details_text = layout.details_text;
+    state->profile = layout.profile;
+    state->phi_tod_z = NAN;
+    state->run_until = GOV_RUN_UNTIL_OFF;
+    for(int i = 0; i < GOV_TIER_COUNT; i++) state->gov_tier_pct[i] = gov_tiers[i].default_pct;
+#if defined(DEBUG_MODE) && defined(DEBUG_LOG_TO_SD)
+    state->log_block = layout.log_block;
+#endif
 
     state->is_running = true;
     state->status = DimStatusCalibrating;
@@ -1247,26 +3589,31 @@ static RealityClockState* state_alloc(void) {
     state->notification = NULL;
     state->original_brightness = 1.0f;
 
-    buffer_init(&state->lf_buffer);
-    buffer_init(&state->hf_buffer);
-    buffer_init(&state->uhf_buffer);
+    buffer_init(&state->lf_buffer, layout.band_values[0]);
+    buffer_init(&state->hf_buffer, layout.band_values[1]);
+    buffer_init(&state->uhf_buffer, layout.band_values[2]);
+    timewin_init(&state->windows, layout.window_ring);
+    longwin_init(&state->long_windows, layout.long_pages);
 
     return state;
 }
 
 static void state_free(RealityClockState* state) {
-    free(state);
+    /* The state lives in the arena too */
+    free(state->arena.base);
 }
 
 int32_t reality_clock_app(void* p) {
     UNUSED(p);
 
     RealityClockState* state = state_alloc();
+    FURI_LOG_I("RealityClock", "Arena: %lu bytes", (unsigned long)state->arena.size);
     FuriMessageQueue* event_queue = furi_message_queue_alloc(INPUT_QUEUE_SIZE, sizeof(InputEvent));
+    state->event_queue = event_queue;
 
     ViewPort* view_port = view_port_alloc();
     view_port_draw_callback_set(view_port, render_callback, state);
-    view_port_input_callback_set(view_port, input_callback, event_queue);
+    view_port_input_callback_set(view_port, input_callback, state);
 
     Gui* gui = furi_record_open(RECORD_GUI);
     gui_add_view_port(gui, view_port, GuiLayerFullscreen);
@@ -1282,17 +3629,22 @@ int32_t reality_clock_app(void* p) {
     state->brightness = (system_brightness_pct / BRIGHTNESS_STEP) * BRIGHTNESS_STEP;
     if(state->brightness > BRIGHTNESS_MAX) state->brightness = BRIGHTNESS_MAX;
 
-    /* Enable always-on backlight (keeps current brightness, just prevents auto-off) */
-    notification_message((NotificationApp*)state->notification, &sequence_display_backlight_enforce_on);
-
-    /* Set up periodic brightness refresh to prevent firmware from reverting after ~1 hour */
-    state->brightness_refresh_time = furi_get_tick() + BRIGHTNESS_REFRESH_MS;
+    /* A saved brightness and screen take precedence over the system setting */
+    if(settings_load(state)) {
+        apply_brightness(state, state->brightness);
+    }
+    profile_open(state);
+    state->profile_save_due = furi_get_tick() + PROFILE_SAVE_INTERVAL_MS;
+    governor_start(state);
+    longwin_open(&state->long_windows);
 
 #ifdef DEBUG_MODE
     /* SubGHz radio is already initialized by the system
-     * We just need to wake it from sleep mode before use */
+     * We just need to wake it from sleep mode before use.
+     * The survey runs before any backlight or SD traffic. */
     furi_hal_subghz_reset();
     furi_hal_subghz_idle();
+    frequency_survey(state);
 
     /* Initialize ADC for temperature sensor */
     state->adc_handle = furi_hal_adc_acquire();
@@ -1313,34 +3665,173 @@ int32_t reality_clock_app(void* p) {
 #endif
 #endif
 
+    /* Enable always-on backlight (keeps current brightness, just prevents auto-off) */
+    notification_message((NotificationApp*)state->notification, &sequence_display_backlight_enforce_on);
+
+    /* Set up periodic brightness refresh to prevent firmware from reverting after ~1 hour */
+    state->brightness_refresh_time = furi_get_tick() + BRIGHTNESS_REFRESH_MS;
+
+#ifdef DEBUG_INPUT_RECORD
+    input_record_open(state);
+#endif
+
+    /* Everything is allocated now; later drops in free heap are leaks or other apps */
+    memory_telemetry_update(state);
+    state->heap_free_start = state->heap_free;
+
     InputEvent event;
+    /* The first read waits for the startup backlight and log header to settle */
+    uint32_t next_read = furi_get_tick() + IO_SETTLE_MS;
+    uint32_t next_redraw = next_read;  /* ScreenRefreshOnTimer screens only */
 
     while(state->is_running) {
-        /* Update readings */
-        update_readings(state);
-        view_port_update(view_port);
+#ifdef DEBUG_MODE
+#ifdef DEBUG_LOG_TO_SD
+        /* Periodic RTC anchor for the log, a short poll between samples */
+        debug_log_anchor_update(state);
+#endif
+#endif
+        uint32_t now = furi_get_tick();
+
+        /* Read on schedule; every DECIM_FACTOR reads the decimators deliver a
+           sample, and only then redraw if the current screen shows what changed */
+        if((int32_t)(now - next_read) >= 0) {
+            if(sample_sensors(state)) {
+                uint8_t changed = update_readings(state);
+                if(screen_needs_redraw(state, changed)) {
+                    view_port_update(view_port);
+                }
+            }
+
+            /* Dynamic sample rate: faster during (re)calibration, slower on a low battery tier */
+            next_read = now + (state->is_calibrated && !state->recalibrating ?
+                gov_tiers[state->gov_tier].sample_interval_ms : SAMPLE_INTERVAL_CALIB_MS) / DECIM_FACTOR;
+        }
+
+        const ScreenDef* screen = current_screen_def(state);
+        if(screen_timer_due(screen, now, &next_redraw)) {
+            view_port_update(view_port);
+        }
 
         /*
          * Periodically reapply brightness to prevent firmware from reverting it.
          * The notification system has an internal timer that can reset brightness
          * to system defaults after a timeout period (~1 hour).
+         * Signed difference so the check survives the 32-bit tick wrap (~49.7 days).
          */
-        if(furi_get_tick() >= state->brightness_refresh_time) {
+        if((int32_t)(now - state->brightness_refresh_time) >= 0) {
             apply_brightness(state, state->brightness);
-            state->brightness_refresh_time = furi_get_tick() + BRIGHTNESS_REFRESH_MS;
+            state->brightness_refresh_time = now + BRIGHTNESS_REFRESH_MS;
         }
 
-        /* Dynamic sample rate: faster during calibration */
-        uint32_t interval = state->is_calibrated ?
-            SAMPLE_INTERVAL_NORMAL_MS : SAMPLE_INTERVAL_CALIB_MS;
+        if(state->settings_save_pending && (int32_t)(now - state->settings_save_due) >= 0) {
+            state->settings_save_pending = false;
+            io_request(state, IoJobSettingsSave);
+        }
+
+        if((int32_t)(now - state->profile_save_due) >= 0) {
+            io_request(state, IoJobProfileSave);
+            state->profile_save_due = now + PROFILE_SAVE_INTERVAL_MS;
+        }
+
+        if((int32_t)(now - state->gov_check_due) >= 0) {
+            if(screen_needs_redraw(state, governor_update(state))) {
+                view_port_update(view_port);
+            }
+            state->gov_check_due = now + GOV_CHECK_MS;
+        }
+
+        /* SD writes and backlight updates due by now, if they fit before the next read */
+        io_run_pending(state, &next_read);
+
+        /* Sleep until the next read, timed redraw, settings or profile save, governor check or log anchor */
+        uint32_t wake = next_read;
+        if(screen->refresh == ScreenRefreshOnTimer && (int32_t)(next_redraw - wake) < 0) {
+            wake = next_redraw;
+        }
+        if(state->settings_save_pending && (int32_t)(state->settings_save_due - wake) < 0) {
+            wake = state->settings_save_due;
+        }
+        if((int32_t)(state->profile_save_due - wake) < 0) {
+            wake = state->profile_save_due;
+        }
+        if((int32_t)(state->gov_check_due - wake) < 0) {
+            wake = state->gov_check_due;
+        }
+#ifdef DEBUG_MODE
+#ifdef DEBUG_LOG_TO_SD
+        if(state->log_active && (int32_t)(state->anchor_due - wake) < 0) {
+            wake = state->anchor_due;
+        }
+#endif
+#endif
+        int32_t until_wake = (int32_t)(wake - furi_get_tick());
+        uint32_t timeout = until_wake > 0 ? (uint32_t)until_wake : 0;
 
-        if(furi_message_queue_get(event_queue, &event, interval) == FuriStatusOk) {
-            process_input(state, &event);
+        if(furi_message_queue_get(event_queue, &event, timeout) == FuriStatusOk) {
+            if(event.type == InputTypeRepeat) state->input_repeat_queued = false;
+#ifdef DEBUG_INPUT_RECORD
+            input_record_event(state, &event);
+#endif
+            uint8_t shown_screen = state->current_screen;
+            if(process_input(state, &event)) {
+                view_port_update(view_port);
+                /* A timed screen starts its cadence from entry */
+                if(state->current_screen != shown_screen) next_redraw = furi_get_tick();
+            }
+            /* Every keypress restarts the write-back delay while settings differ */
+            if(settings_modified(state)) {
+                state->settings_save_pending = true;
+                state->settings_save_due = furi_get_tick() + SETTINGS_SAVE_DELAY_MS;
+            }
         }
     }
 
+    settings_save(state);
+    profile_close(state);
+    governor_log_session(state);
+    longwin_close(&state->long_windows);
+
+#ifdef DEBUG_INPUT_RECORD
+    input_record_close(state);
+#endif
+
+    FURI_LOG_I(
+        "RealityClock",
+        "Input: %lu dropped, %lu repeats coalesced, queue peak %lu/%d",
+        (unsigned long)state->input_dropped,
+        (unsigned long)state->input_coalesced,
+        (unsigned long)state->input_queue_peak,
+        INPUT_QUEUE_SIZE);
+    FURI_LOG_I(
+        "RealityClock",
+        "I/O: %lu jobs waited for a gap, %lu reads pushed back, %lu samples near I/O",
+        (unsigned long)state->io_deferred,
+        (unsigned long)state->io_delayed_reads,
+        (unsigned long)state->io_tagged_samples);
+    FURI_LOG_I(
+        "RealityClock",
+        "Paged windows: %lu page reads (%lu waited for), %lu writes (%lu on eviction)",
+        (unsigned long)state->long_windows.page_reads,
+        (unsigned long)state->long_windows.sync_reads,
+        (unsigned long)state->long_windows.page_writes,
+        (unsigned long)state->long_windows.sync_writes);
+    memory_telemetry_update(state);
+    FURI_LOG_I(
+        "RealityClock",
+        "Memory: stack %lu bytes never used, heap free %lu (min %lu, %ld since start)",
+        (unsigned long)state->stack_free,
+        (unsigned long)state->heap_free,
+        (unsigned long)state->heap_min_free,
+        (long)state->heap_free - (long)state->heap_free_start);
+
 #ifdef DEBUG_MODE
 #ifdef DEBUG_LOG_TO_SD
+    FURI_LOG_I(
+        "RealityClock",
+        "RTC anchor: %lu polls, %lu of them full-second",
+        (unsigned long)state->anchor_polls,
+        (unsigned long)state->anchor_full_polls);
     /* Close SD card logging */
     debug_log_close(state);
 #endif
@@ -0,0 +1,53 @@
+/**
+ * @file reality_clock_assets.h
+ * @brief Bitmaps for reality-clock, generated from apps/reality-clock/assets/
+ *
+ * Generated by tools/assets/gen_assets.py - edit the sources and rerun it
+ * (just assets) rather than editing this file. Sizes are in bytes:
+ *
+ *   Asset        Source          Size   Layout               1-bpp  Flash
+ *   qr_code_xbm  qr_payload.txt  58x58  XBM, v3-L mask 2 x2    116    464
+ *   Total                                                      116    464
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#define QR_CODE_XBM_WIDTH 58
+#define QR_CODE_XBM_HEIGHT 58
+
+/* https://github.com/Eris-Margeta/flipper-apps */
+static const uint8_t qr_code_xbm[464] = {
+    0xFF, 0x3F, 0x30, 0x33, 0xC3, 0xF3, 0xFF, 0x03, 0xFF, 0x3F, 0x30, 0x33, 0xC3, 0xF3, 0xFF, 0x03,
+    0x03, 0x30, 0x33, 0xC0, 0x3C, 0x33, 0x00, 0x03, 0x03, 0x30, 0x33, 0xC0, 0x3C, 0x33, 0x00, 0x03,
+    0xF3, 0x33, 0x00, 0xC3, 0x00, 0x30, 0x3F, 0x03, 0xF3, 0x33, 0x00, 0xC3, 0x00, 0x30, 0x3F, 0x03,
+    0xF3, 0x33, 0x3F, 0xFF, 0xFF, 0x30, 0x3F, 0x03, 0xF3, 0x33, 0x3F, 0xFF, 0xFF, 0x30, 0x3F, 0x03,
+    0xF3, 0x33, 0x0C, 0x00, 0xFF, 0x33, 0x3F, 0x03, 0xF3, 0x33, 0x0C, 0x00, 0xFF, 0x33, 0x3F, 0x03,
+    0x03, 0x30, 0xCF, 0xF3, 0x03, 0x30, 0x00, 0x03, 0x03, 0x30, 0xCF, 0xF3, 0x03, 0x30, 0x00, 0x03,
+    0xFF, 0x3F, 0x33, 0x33, 0x33, 0xF3, 0xFF, 0x03, 0xFF, 0x3F, 0x33, 0x33, 0x33, 0xF3, 0xFF, 0x03,
+    0x00, 0x00, 0xFC, 0xF0, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFC, 0xF0, 0xC0, 0x00, 0x00, 0x00,
+    0xFF, 0xF3, 0xCF, 0x3C, 0x00, 0xCF, 0xCC, 0x00, 0xFF, 0xF3, 0xCF, 0x3C, 0x00, 0xCF, 0xCC, 0x00,
+    0x00, 0x00, 0x30, 0x33, 0xFF, 0xF3, 0x03, 0x03, 0x00, 0x00, 0x30, 0x33, 0xFF, 0xF3, 0x03, 0x03,
+    0xF0, 0xFF, 0x33, 0xCC, 0x00, 0x03, 0x03, 0x00, 0xF0, 0xFF, 0x33, 0xCC, 0x00, 0x03, 0x03, 0x00,
+    0x0F, 0xC3, 0x03, 0xC3, 0x03, 0x03, 0xCC, 0x00, 0x0F, 0xC3, 0x03, 0xC3, 0x03, 0x03, 0xCC, 0x00,
+    0xF0, 0x3C, 0x3C, 0x0F, 0x0C, 0x00, 0x3C, 0x00, 0xF0, 0x3C, 0x3C, 0x0F, 0x0C, 0x00, 0x3C, 0x00,
+    0xFF, 0xCF, 0x0F, 0x0C, 0x33, 0xFF, 0x03, 0x03, 0xFF, 0xCF, 0x0F, 0x0C, 0x33, 0xFF, 0x03, 0x03,
+    0xCC, 0xFC, 0xFC, 0xF3, 0x30, 0x0F, 0x3F, 0x00, 0xCC, 0xFC, 0xFC, 0xF3, 0x30, 0x0F, 0x3F, 0x00,
+    0x03, 0x00, 0xFF, 0x30, 0xC3, 0xFF, 0xC3, 0x00, 0x03, 0x00, 0xFF, 0x30, 0xC3, 0xFF, 0xC3, 0x00,
+    0xF0, 0x3C, 0xFF, 0xFC, 0xCC, 0xCC, 0x3C, 0x00, 0xF0, 0x3C, 0xFF, 0xFC, 0xCC, 0xCC, 0x3C, 0x00,
+    0x3F, 0x00, 0x3C, 0x03, 0xC3, 0xFC, 0x33, 0x03, 0x3F, 0x00, 0x3C, 0x03, 0xC3, 0xFC, 0x33, 0x03,
+    0xF3, 0x33, 0x0F, 0xC0, 0x3F, 0xF3, 0x33, 0x00, 0xF3, 0x33, 0x0F, 0xC0, 0x3F, 0xF3, 0x33, 0x00,
+    0x03, 0xCC, 0x33, 0x33, 0x33, 0x3F, 0xC0, 0x00, 0x03, 0xCC, 0x33, 0x33, 0x33, 0x3F, 0xC0, 0x00,
+    0xC3, 0x3C, 0x00, 0x3F, 0xCC, 0xFF, 0xF3, 0x03, 0xC3, 0x3C, 0x00, 0x3F, 0xCC, 0xFF, 0xF3, 0x03,
+    0x00, 0x00, 0x3F, 0x30, 0x30, 0x03, 0xFF, 0x03, 0x00, 0x00, 0x3F, 0x30, 0x30, 0x03, 0xFF, 0x03,
+    0xFF, 0x3F, 0xCF, 0xC3, 0xCF, 0x33, 0x3F, 0x00, 0xFF, 0x3F, 0xCF, 0xC3, 0xCF, 0x33, 0x3F, 0x00,
+    0x03, 0x30, 0xF0, 0xC0, 0xC0, 0x03, 0xC3, 0x00, 0x03, 0x30, 0xF0, 0xC0, 0xC0, 0x03, 0xC3, 0x00,
+    0xF3, 0x33, 0xFF, 0xFF, 0x0C, 0xFF, 0x33, 0x03, 0xF3, 0x33, 0xFF, 0xFF, 0x0C, 0xFF, 0x33, 0x03,
+    0xF3, 0x33, 0x33, 0x33, 0xF3, 0x03, 0xFC, 0x03, 0xF3, 0x33, 0x33, 0x33, 0xF3, 0x03, 0xFC, 0x03,
+    0xF3, 0x33, 0x33, 0xC0, 0xC0, 0xFF, 0xFF, 0x00, 0xF3, 0x33, 0x33, 0xC0, 0xC0, 0xFF, 0xFF, 0x00,
+    0x03, 0x30, 0xCF, 0xC3, 0x03, 0xCF, 0xCC, 0x00, 0x03, 0x30, 0xCF, 0xC3, 0x03, 0xCF, 0xCC, 0x00,
+    0xFF, 0x3F, 0x33, 0xFC, 0xCF, 0xF0, 0x33, 0x00, 0xFF, 0x3F, 0x33, 0xFC, 0xCF, 0xF0, 0x33, 0x00,
+};
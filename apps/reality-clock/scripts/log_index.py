@@ -0,0 +1,259 @@
+#!/usr/bin/env python3
+"""
+Sparse time index for Reality Clock sensor logs.
+
+sensor_log.csv is append-only and its first column (timestamp_ms) only ever
+grows, apart from the 32-bit tick wrap after ~49.7 days. Every N records the
+index stores (elapsed_ms, byte_offset, row), so a time-range query is a
+binary search plus a seek and reads at most N rows it does not need.
+
+The index lives next to the log as <log>.idx and is updated incrementally:
+when the log has grown, scanning resumes from the last indexed record. If
+the log was restarted (the app truncates it at every session start), the
+index is rebuilt.
+
+Usage:
+    log_index.py build <sensor_log.csv> [--every N]
+    log_index.py query <sensor_log.csv> <from> <to>
+
+Times are elapsed since the session start: plain milliseconds, or
+[<days>d]HH:MM[:SS] (e.g. 3d03:10 is 3 days, 3 hours and 10 minutes in).
+"""
+
+import bisect
+import csv
+import io
+import os
+import re
+import sys
+import zlib
+
+INDEX_VERSION = 1
+DEFAULT_EVERY = 1000
+TICK_WRAP = 1 << 32
+
+# Enough of the file to tell one session's log from the next
+IDENTITY_BYTES = 4096
+
+
+def index_path(log_path):
+    return str(log_path) + ".idx"
+
+
+def parse_elapsed(text):
+    """Parse an elapsed-time spec into milliseconds."""
+    text = text.strip()
+    if text.isdigit():
+        return int(text)
+    match = re.fullmatch(r"(?:(\d+)d)?(\d+):(\d{2})(?::(\d{2}(?:\.\d+)?))?", text)
+    if not match:
+        raise ValueError(f"cannot parse time '{text}' (use ms or [Nd]HH:MM[:SS])")
+    days, hours, minutes, seconds = match.groups()
+    total = int(days or 0) * 86400 + int(hours) * 3600 + int(minutes) * 60 + float(seconds or 0)
+    return int(total * 1000)
+
+
+def format_elapsed(ms):
+    seconds, ms = divmod(int(ms), 1000)
+    minutes, seconds = divmod(seconds, 60)
+    hours, minutes = divmod(minutes, 60)
+    days, hours = divmod(hours, 24)
+    prefix = f"{days}d" if days else ""
+    return f"{prefix}{hours:02d}:{minutes:02d}:{seconds:02d}.{ms:03d}"
+
+
+def unwrap_ms(last_ms, raw):
+    """Extend a 32-bit elapsed tick to the unwrapped value closest after last_ms."""
+    ms = (last_ms - (last_ms % TICK_WRAP)) + raw
+    if ms < last_ms - TICK_WRAP // 2:
+        ms += TICK_WRAP
+    return ms
+
+
+def _identity(log_path):
+    with open(log_path, "rb") as f:
+        head = f.read(IDENTITY_BYTES)
+    return zlib.crc32(head[: head.rfind(b"\n") + 1])
+
+
+class LogIndex:
+    """In-memory view of a .idx file."""
+
+    def __init__(self, every=DEFAULT_EVERY):
+        self.every = every
+        self.identity = None
+        self.indexed_bytes = 0  # Log bytes covered (always ends on a line boundary)
+        self.rows = 0           # Data rows covered
+        self.last_ms = None     # Unwrapped timestamp of the last covered row
+        self.header = None      # CSV header line of the log
+        self.entries_ms = []
+        self.entries_offset = []
+        self.entries_row = []
+
+    def load(self, path):
+        with open(path, "r") as f:
+            meta = {}
+            for line in f:
+                if not line.startswith("#"):
+                    break
+                for field in line[1:].split():
+                    if "=" in field:
+                        key, value = field.split("=", 1)
+                        meta[key] = value
+            if int(meta.get("version", 0)) != INDEX_VERSION:
+                raise ValueError("unsupported index version")
+            self.every = int(meta["every"])
+            self.identity = int(meta["identity"])
+            self.indexed_bytes = int(meta["bytes"])
+            self.rows = int(meta["rows"])
+            self.last_ms = int(meta["last_ms"]) if meta.get("last_ms", "-") != "-" else None
+            self.header = meta.get("header", "").replace("|", ",") or None
+            for line in f:
+                ms, offset, row = line.split(",")
+                self.entries_ms.append(int(ms))
+                self.entries_offset.append(int(offset))
+                self.entries_row.append(int(row))
+        return self
+
+    def save(self, path):
+        tmp = path + ".tmp"
+        with open(tmp, "w") as f:
+            f.write(f"# reality_clock sensor_log index version={INDEX_VERSION}\n")
+            f.write(
+                f"# every={self.every} identity={self.identity} bytes={self.indexed_bytes} "
+                f"rows={self.rows} last_ms={'-' if self.last_ms is None else self.last_ms} "
+                f"header={(self.header or '').replace(',', '|')}\n"
+            )
+            f.write("elapsed_ms,offset,row\n")
+            for entry in zip(self.entries_ms, self.entries_offset, self.entries_row):
+                f.write("%d,%d,%d\n" % entry)
+        os.replace(tmp, path)
+
+
+def build_index(log_path, every=DEFAULT_EVERY, verbose=False):
+    """Create or extend the index for log_path and return it."""
+    idx_file = index_path(log_path)
+    identity = _identity(log_path)
+    size = os.path.getsize(log_path)
+
+    index = None
+    if os.path.exists(idx_file):
+        try:
+            index = LogIndex().load(idx_file)
+        except (ValueError, KeyError, OSError):
+            index = None
+        if index and (index.identity != identity or index.indexed_bytes > size or index.every != every):
+            index = None  # New session, truncated log or different spacing: start over
+
+    if index is None:
+        index = LogIndex(every)
+        index.identity = identity
+
+    if index.indexed_bytes == size:
+        return index
+
+    added = 0
+    with open(log_path, "rb") as f:
+        f.seek(index.indexed_bytes)
+        offset = index.indexed_bytes
+        if offset == 0:
+            header = f.readline()
+            index.header = header.decode("utf-8", "replace").strip()
+            offset += len(header)
+
+        rows = index.rows
+        last_ms = index.last_ms
+        for line in f:
+            if not line.endswith(b"\n"):
+                break  # Record still being written
+            comma = line.find(b",")
+            try:
+                raw = int(line[:comma])
+            except ValueError:
+                offset += len(line)
+                continue
+
+            ms = raw if last_ms is None else unwrap_ms(last_ms, raw)
+
+            if rows % index.every == 0:
+                index.entries_ms.append(ms)
+                index.entries_offset.append(offset)
+                index.entries_row.append(rows)
+                added += 1
+
+            rows += 1
+            last_ms = ms
+            offset += len(line)
+
+        index.rows = rows
+        index.last_ms = last_ms
+        index.indexed_bytes = offset
+
+    index.save(idx_file)
+    if verbose:
+        print(f"Indexed {index.rows} rows ({added} new index entries) in {idx_file}")
+    return index
+
+
+def query(log_path, start_ms, end_ms, index=None):
+    """
+    Yield (elapsed_ms, row_dict) for every record with start_ms <= elapsed_ms <= end_ms.
+
+    elapsed_ms is unwrapped across the 32-bit tick wrap. Records appended after
+    the index was last built are still found; they are scanned linearly.
+    """
+    if index is None:
+        index = build_index(log_path)
+    if not index.entries_ms or index.header is None:
+        return
+
+    # Last index entry at or before start_ms
+    pos = max(bisect.bisect_right(index.entries_ms, start_ms) - 1, 0)
+    fields = next(csv.reader([index.header]))
+    last_ms = index.entries_ms[pos]
+
+    with open(log_path, "rb") as f:
+        f.seek(index.entries_offset[pos])
+        for line in f:
+            if not line.endswith(b"\n"):
+                break
+            values = next(csv.reader(io.StringIO(line.decode("utf-8", "replace"))), None)
+            if not values:
+                continue
+            try:
+                raw = int(values[0])
+            except ValueError:
+                continue
+            ms = unwrap_ms(last_ms, raw)
+            last_ms = ms
+
+            if ms > end_ms:
+                break
+            if ms >= start_ms:
+                yield ms, dict(zip(fields, values))
+
+
+def main(argv):
+    if len(argv) >= 2 and argv[0] == "build":
+        every = DEFAULT_EVERY
+        if "--every" in argv:
+            every = int(argv[argv.index("--every") + 1])
+        build_index(argv[1], every, verbose=True)
+        return 0
+    if len(argv) == 4 and argv[0] == "query":
+        start_ms, end_ms = parse_elapsed(argv[2]), parse_elapsed(argv[3])
+        count = 0
+        for ms, row in query(argv[1], start_ms, end_ms):
+            if count == 0:
+                print(",".join(row.keys()))
+            print(",".join(row.values()))
+            count += 1
+        print(f"# {count} rows between {format_elapsed(start_ms)} and {format_elapsed(end_ms)}",
+              file=sys.stderr)
+        return 0
+    print(__doc__.strip(), file=sys.stderr)
+    return 2
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv[1:]))
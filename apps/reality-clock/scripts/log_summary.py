@@ -0,0 +1,396 @@
+#!/usr/bin/env python3
+"""
+Incremental summary and columnar cache for Reality Clock sensor logs.
+
+sensor_log.csv only ever grows during a session, so the analyzer should not
+re-parse it from row one on every sync. This module keeps, next to the log,
+a <log>.cache/ directory with:
+
+  summary.json   streaming statistics (Welford mean/variance, min/max, first
+                 and last value per column, heap trend against elapsed time)
+                 plus the log identity and the byte offset they cover
+  <column>.bin   every parsed row, one flat array per column (elapsed_ms as
+                 int64, unwrapped across the tick wrap; the rest as float64)
+
+update() parses only the bytes appended since the last run and folds them
+into both, so analyzing the whole log costs time proportional to the new
+data. range_summary() answers a time window from the column files alone: a
+binary search on elapsed_ms, then a read of just the rows in the window.
+
+A new session (the app truncates the log at start) changes the identity and
+the cache is rebuilt, exactly like the sparse index in log_index.py.
+
+Usage:
+    log_summary.py update <sensor_log.csv>
+    log_summary.py show <sensor_log.csv> [<from> <to>]
+"""
+
+import array
+import bisect
+import json
+import math
+import os
+import shutil
+import sys
+
+import log_index
+
+CACHE_VERSION = 2
+ELAPSED = "elapsed_ms"
+TREND_COLUMN = "heap_free"
+MS_PER_HOUR = 3600 * 1000
+
+# Rows parsed before their values are folded into the summary and appended
+CHUNK_ROWS = 65536
+
+
+def cache_dir(log_path):
+    return str(log_path) + ".cache"
+
+
+# ==== Streaming statistics ====
+
+
+class Welford:
+    """Running count, mean, M2 (sum of squared deviations), min and max."""
+
+    __slots__ = ("n", "mean", "m2", "min", "max", "first", "last")
+
+    def __init__(self, n=0, mean=0.0, m2=0.0, min=None, max=None, first=None, last=None):
+        self.n, self.mean, self.m2 = n, mean, m2
+        self.min, self.max, self.first, self.last = min, max, first, last
+
+    def extend(self, values):
+        """Fold a batch in (Chan et al. parallel update)."""
+        count = len(values)
+        if count == 0:
+            return
+        mean = math.fsum(values) / count
+        m2 = math.fsum((v - mean) ** 2 for v in values)
+        low, high = min(values), max(values)
+
+        if self.n == 0:
+            self.n, self.mean, self.m2 = count, mean, m2
+            self.min, self.max, self.first = low, high, values[0]
+        else:
+            total = self.n + count
+            delta = mean - self.mean
+            self.mean += delta * count / total
+            self.m2 += m2 + delta * delta * self.n * count / total
+            self.n = total
+            self.min, self.max = min(self.min, low), max(self.max, high)
+        self.last = values[-1]
+
+    @property
+    def stdev(self):
+        """Sample standard deviation, as statistics.stdev() reports it."""
+        return math.sqrt(self.m2 / (self.n - 1)) if self.n > 1 else 0.0
+
+    def to_list(self):
+        return [self.n, self.mean, self.m2, self.min, self.max, self.first, self.last]
+
+    @classmethod
+    def from_list(cls, values):
+        return cls(*values)
+
+
+class Trend:
+    """Online least-squares slope of a column against elapsed_ms.
+
+    Rows are not evenly spaced (the battery governor samples every 1 to 10 s),
+    so the slope is fitted against time rather than row number.
+    """
+
+    __slots__ = ("n", "mean_x", "mean_y", "sxx", "sxy")
+
+    def __init__(self, n=0, mean_x=0.0, mean_y=0.0, sxx=0.0, sxy=0.0):
+        self.n, self.mean_x, self.mean_y, self.sxx, self.sxy = n, mean_x, mean_y, sxx, sxy
+
+    def extend(self, times, values):
+        for x, y in zip(times, values):
+            self.n += 1
+            dx = x - self.mean_x
+            self.mean_x += dx / self.n
+            self.mean_y += (y - self.mean_y) / self.n
+            self.sxx += dx * (x - self.mean_x)
+            self.sxy += dx * (y - self.mean_y)
+
+    @property
+    def slope(self):
+        """Change per millisecond."""
+        return self.sxy / self.sxx if self.sxx else 0.0
+
+    @property
+    def per_hour(self):
+        return self.slope * MS_PER_HOUR
+
+    def to_list(self):
+        return [self.n, self.mean_x, self.mean_y, self.sxx, self.sxy]
+
+    @classmethod
+    def from_list(cls, values):
+        return cls(*values)
+
+
+class LogSummary:
+    """Per-column statistics for a log or part of one."""
+
+    def __init__(self, columns=()):
+        self.columns = {name: Welford() for name in columns}
+        self.trend = Trend()
+
+    @property
+    def rows(self):
+        return max((stats.n for stats in self.columns.values()), default=0)
+
+    def extend(self, batch):
+        """Fold in {column: [values]} for consecutive rows, elapsed_ms included."""
+        for name, values in batch.items():
+            if name in self.columns:
+                self.columns[name].extend(values)
+        if TREND_COLUMN in batch:
+            self.trend.extend(batch[ELAPSED], batch[TREND_COLUMN])
+
+    def get(self, name):
+        """Statistics for a column, or None if the log has no such column or no rows."""
+        stats = self.columns.get(name)
+        return stats if stats is not None and stats.n else None
+
+    def to_dict(self):
+        return {
+            "columns": {name: stats.to_list() for name, stats in self.columns.items()},
+            "trend": self.trend.to_list(),
+        }
+
+    @classmethod
+    def from_dict(cls, data):
+        summary = cls()
+        summary.columns = {name: Welford.from_list(v) for name, v in data["columns"].items()}
+        summary.trend = Trend.from_list(data["trend"])
+        return summary
+
+
+# ==== Column files ====
+
+
+class _Column:
+    """Read-only sequence view of a column file; supports bisect without loading it."""
+
+    def __init__(self, path, typecode, length):
+        self.f = open(path, "rb")
+        self.typecode = typecode
+        self.itemsize = array.array(typecode).itemsize
+        self.length = length
+
+    def __len__(self):
+        return self.length
+
+    def __getitem__(self, i):
+        self.f.seek(i * self.itemsize)
+        return array.array(self.typecode, self.f.read(self.itemsize))[0]
+
+    def read(self, start, stop):
+        self.f.seek(start * self.itemsize)
+        values = array.array(self.typecode)
+        values.frombytes(self.f.read((stop - start) * self.itemsize))
+        return values
+
+    def close(self):
+        self.f.close()
+
+
+# ==== Cache ====
+
+
+class AnalysisCache:
+    """The <log>.cache/ directory for one log."""
+
+    def __init__(self, log_path):
+        self.log_path = str(log_path)
+        self.dir = cache_dir(log_path)
+        self.identity = None
+        self.bytes = 0          # Log bytes covered (always ends on a line boundary)
+        self.rows = 0
+        self.last_ms = None
+        self.fields = None      # CSV header of the log
+        self.summary = LogSummary()
+
+    def _meta_path(self):
+        return os.path.join(self.dir, "summary.json")
+
+    def _column_path(self, name):
+        return os.path.join(self.dir, name + ".bin")
+
+    def _typecode(self, name):
+        return "q" if name == ELAPSED else "d"
+
+    def _stored_columns(self):
+        return [ELAPSED] + [name for name in self.fields if name != "timestamp_ms"]
+
+    def _load(self):
+        try:
+            with open(self._meta_path()) as f:
+                meta = json.load(f)
+            if meta.get("version") != CACHE_VERSION:
+                return False
+            self.identity = meta["identity"]
+            self.bytes = meta["bytes"]
+            self.rows = meta["rows"]
+            self.last_ms = meta["last_ms"]
+            self.fields = meta["fields"]
+            self.summary = LogSummary.from_dict(meta["summary"])
+        except (OSError, ValueError, KeyError):
+            return False
+
+        # Column files are appended before summary.json is replaced; drop any
+        # rows a crash left behind beyond what the summary covers
+        for name in self._stored_columns():
+            path = self._column_path(name)
+            want = self.rows * array.array(self._typecode(name)).itemsize
+            if not os.path.exists(path) or os.path.getsize(path) < want:
+                return False
+            if os.path.getsize(path) > want:
+                with open(path, "r+b") as f:
+                    f.truncate(want)
+        return True
+
+    def _save(self):
+        meta = {
+            "version": CACHE_VERSION,
+            "log": os.path.basename(self.log_path),
+            "identity": self.identity,
+            "bytes": self.bytes,
+            "rows": self.rows,
+            "last_ms": self.last_ms,
+            "fields": self.fields,
+            "summary": self.summary.to_dict(),
+        }
+        tmp = self._meta_path() + ".tmp"
+        with open(tmp, "w") as f:
+            json.dump(meta, f)
+        os.replace(tmp, self._meta_path())
+
+    def _reset(self, identity):
+        shutil.rmtree(self.dir, ignore_errors=True)
+        os.makedirs(self.dir)
+        self.identity = identity
+        self.bytes = 0
+        self.rows = 0
+        self.last_ms = None
+        self.fields = None
+        self.summary = LogSummary()
+
+    def _flush(self, batch):
+        if not batch[ELAPSED]:
+            return
+        for name, values in batch.items():
+            with open(self._column_path(name), "ab") as f:
+                array.array(self._typecode(name), values).tofile(f)
+        self.summary.extend(batch)
+        for values in batch.values():
+            values.clear()
+
+    def update(self, verbose=False):
+        """Bring the cache up to date with the log; returns the whole-log LogSummary."""
+        identity = log_index._identity(self.log_path)
+        size = os.path.getsize(self.log_path)
+
+        if not self._load() or self.identity != identity or self.bytes > size:
+            self._reset(identity)  # New session, truncated log or no usable cache
+
+        start_rows = self.rows
+        if self.bytes < size:
+            self._append(size)
+        if verbose:
+            print(f"Cache: {self.rows - start_rows} new rows, {self.rows} total ({self.dir})")
+        return self.summary
+
+    def _append(self, size):
+        with open(self.log_path, "rb") as f:
+            f.seek(self.bytes)
+            offset = self.bytes
+            if offset == 0:
+                header = f.readline()
+                offset += len(header)
+                self.fields = header.decode("utf-8", "replace").strip().split(",")
+                self.summary = LogSummary(self._stored_columns())
+
+            columns = self._stored_columns()
+            width = len(self.fields)
+            batch = {name: [] for name in columns}
+            last_ms = self.last_ms
+
+            for line in f:
+                if not line.endswith(b"\n"):
+                    break  # Record still being written
+                offset += len(line)
+                parts = line.split(b",")
+                if len(parts) != width:
+                    continue  # Torn or malformed record
+                try:
+                    values = [float(p) for p in parts]
+                except ValueError:
+                    continue
+
+                raw = int(values[0])
+                ms = raw if last_ms is None else log_index.unwrap_ms(last_ms, raw)
+                last_ms = ms
+                batch[ELAPSED].append(ms)
+                for name, value in zip(columns[1:], values[1:]):
+                    batch[name].append(value)
+
+                if len(batch[ELAPSED]) >= CHUNK_ROWS:
+                    self.rows += len(batch[ELAPSED])
+                    self._flush(batch)
+
+            self.rows += len(batch[ELAPSED])
+            self._flush(batch)
+            self.last_ms = last_ms
+            self.bytes = offset
+
+        self._save()
+
+    def range_summary(self, start_ms, end_ms):
+        """LogSummary of the rows with start_ms <= elapsed_ms <= end_ms (call update() first)."""
+        if not self.fields or self.rows == 0:
+            return LogSummary()
+
+        elapsed = _Column(self._column_path(ELAPSED), "q", self.rows)
+        try:
+            lo = bisect.bisect_left(elapsed, start_ms)
+            hi = bisect.bisect_right(elapsed, end_ms)
+        finally:
+            elapsed.close()
+
+        names = self._stored_columns()
+        summary = LogSummary(names)
+        for first in range(lo, hi, CHUNK_ROWS):
+            last = min(first + CHUNK_ROWS, hi)
+            batch = {}
+            for name in names:
+                column = _Column(self._column_path(name), self._typecode(name), self.rows)
+                batch[name] = column.read(first, last).tolist()
+                column.close()
+            summary.extend(batch)
+        return summary
+
+
+def main(argv):
+    if len(argv) >= 2 and argv[0] in ("update", "show"):
+        cache = AnalysisCache(argv[1])
+        summary = cache.update(verbose=True)
+        if argv[0] == "show":
+            if len(argv) == 4:
+                summary = cache.range_summary(log_index.parse_elapsed(argv[2]),
+                                              log_index.parse_elapsed(argv[3]))
+            for name, stats in summary.columns.items():
+                if stats.n:
+                    print(f"{name:14} n={stats.n:<9} mean={stats.mean:<14.6g} sd={stats.stdev:<12.6g} "
+                          f"min={stats.min:<12.6g} max={stats.max:.6g}")
+        return 0
+    print(__doc__.strip(), file=sys.stderr)
+    return 2
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv[1:]))
@@ -0,0 +1,143 @@
+#!/usr/bin/env python3
+"""
+Merge sensor logs from several Flipper units into one time-ordered CSV.
+
+Each log carries epoch_ms: wall-clock time the device derived from its
+tick, re-anchored to its RTC every 15 minutes. Between two anchors the
+tick's own drift accumulates, so epoch_ms jumps by a few milliseconds at
+each re-anchor. The merge removes those steps: the tick-to-RTC offset is
+interpolated linearly between consecutive anchors, which spreads each
+correction over the interval it accumulated in.
+
+Logs are streamed: each device only buffers the rows since its last anchor
+(~900 at 1 Hz), and heapq.merge interleaves the devices, so time and memory
+grow linearly with rows and devices.
+
+Usage:
+    merge_logs.py [-o merged.csv] [--offset NAME=MS ...] NAME=sensor_log.csv ...
+
+NAME labels the device in the output (defaults to the file's parent
+folder). --offset shifts one device's RTC by MS milliseconds, for units
+whose clocks were never synced.
+"""
+
+import argparse
+import csv
+import heapq
+import os
+import sys
+
+import log_index
+
+
+def _device_rows(name, path, offset_ms=0):
+    """
+    Yield (corrected_epoch_ms, name, row) for one log, in time order.
+
+    The offset between epoch_ms and the unwrapped elapsed timestamp_ms is
+    constant between anchors. When it changes, the rows buffered since the
+    previous anchor are emitted with the offset interpolated across them.
+    Rows after the last anchor continue at the drift measured before it.
+    """
+    with open(path, newline="") as f:
+        reader = csv.DictReader(f)
+        if reader.fieldnames is None or "epoch_ms" not in reader.fieldnames:
+            raise SystemExit(f"{path}: no epoch_ms column (log written before RTC anchoring)")
+
+        last_ms = None
+        anchor_ms = None      # Elapsed time of the current anchor
+        anchor_offset = None  # epoch_ms - elapsed at that anchor
+        pending = []          # (elapsed_ms, row) since the current anchor
+        drift = 0.0           # Offset change per elapsed ms, from the last two anchors
+
+        for row in reader:
+            try:
+                raw = int(row["timestamp_ms"])
+                epoch = int(row["epoch_ms"])
+            except (TypeError, ValueError):
+                continue  # Torn or malformed record
+
+            elapsed = raw if last_ms is None else log_index.unwrap_ms(last_ms, raw)
+            last_ms = elapsed
+            offset = epoch - elapsed
+
+            if anchor_offset is None:
+                anchor_ms, anchor_offset = elapsed, offset
+            elif offset != anchor_offset:
+                # New anchor: spread the step over the rows since the last one
+                drift = (offset - anchor_offset) / (elapsed - anchor_ms)
+                for t, pending_row in pending:
+                    corrected = t + anchor_offset + drift * (t - anchor_ms)
+                    yield round(corrected) + offset_ms, name, pending_row
+                pending = []
+                anchor_ms, anchor_offset = elapsed, offset
+
+            pending.append((elapsed, row))
+
+        # No later anchor to interpolate towards: extrapolate the last drift
+        for t, pending_row in pending:
+            corrected = t + anchor_offset + drift * (t - anchor_ms)
+            yield round(corrected) + offset_ms, name, pending_row
+
+
+def merge(sources, out, offsets=None):
+    """Merge [(name, path)] into a CSV writer on `out`. Returns the row count."""
+    offsets = offsets or {}
+    streams = [_device_rows(name, path, offsets.get(name, 0)) for name, path in sources]
+
+    writer = None
+    count = 0
+    for epoch_ms, name, row in heapq.merge(*streams, key=lambda item: item[0]):
+        if writer is None:
+            fields = ["epoch_ms", "device"] + [k for k in row.keys() if k != "epoch_ms"]
+            fields.append("epoch_ms_raw")
+            writer = csv.DictWriter(out, fieldnames=fields, lineterminator="\n")
+            writer.writeheader()
+        merged = dict(row)
+        merged["epoch_ms_raw"] = merged.pop("epoch_ms")
+        merged["epoch_ms"] = epoch_ms
+        merged["device"] = name
+        writer.writerow(merged)
+        count += 1
+    return count
+
+
+def _parse_source(text):
+    if "=" in text and not os.path.exists(text):
+        name, path = text.split("=", 1)
+    else:
+        path = text
+        name = os.path.basename(os.path.dirname(os.path.abspath(path))) or path
+    return name, path
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Merge Reality Clock logs from several devices")
+    parser.add_argument("logs", nargs="+", help="NAME=sensor_log.csv (or just the path)")
+    parser.add_argument("-o", "--output", help="merged CSV (default: stdout)")
+    parser.add_argument("--offset", action="append", default=[], metavar="NAME=MS",
+                        help="shift a device's clock by MS milliseconds")
+    args = parser.parse_args()
+
+    sources = [_parse_source(text) for text in args.logs]
+    names = [name for name, _ in sources]
+    if len(set(names)) != len(names):
+        parser.error("device names must be unique; label logs as NAME=path")
+
+    offsets = {}
+    for text in args.offset:
+        name, ms = text.split("=", 1)
+        offsets[name] = int(ms)
+
+    out = open(args.output, "w", newline="") if args.output else sys.stdout
+    try:
+        count = merge(sources, out, offsets)
+    finally:
+        if args.output:
+            out.close()
+    print(f"Merged {count} rows from {len(sources)} devices", file=sys.stderr)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,255 @@
+#!/usr/bin/env python3
+"""
+Recover a Reality Clock block log (sensor_log.blk) into a plain CSV.
+
+The app writes its log as a sequence of blocks, each synced to the SD card
+on its own:
+
+    #blk <seq, 8 hex> <length, 4 hex> <CRC-32, 8 hex>\\n
+    <length bytes of whole CSV lines>
+
+Block 0 holds the CSV header. A crash or a dead battery can leave the last
+block torn, and a bad card can corrupt one in the middle; either fails its
+length or CRC check. Every intact block is copied to the output and the rest
+are skipped by searching for the next header, so a crash costs at most the
+block that was being written.
+
+The file is memory-mapped and blocks are checked with zlib.crc32 without
+splitting lines, so recovery runs at disk speed. The output only ever grows
+with the log, which keeps the analyzer's incremental cache valid across
+downloads.
+
+Recovery is incremental too. <output>.recover remembers the log offset and
+sequence number after the last intact block, how many CSV bytes that made,
+and a CRC of the head of the log. The next run checks only the blocks
+appended since and appends their payloads to the CSV. A changed head (the
+app truncates the log at start) or a CSV shorter than recorded means a full
+rebuild.
+
+Usage:
+    recover_log.py <sensor_log.blk> [-o sensor_log.csv] [--full]
+"""
+
+import argparse
+import json
+import mmap
+import os
+import re
+import sys
+import zlib
+
+MAGIC = b"#blk "
+HEADER_SIZE = 28
+IDENTITY_BYTES = 4096
+STATE_VERSION = 1
+HEADER = re.compile(rb"#blk ([0-9a-f]{8}) ([0-9a-f]{4}) ([0-9a-f]{8})\n")
+
+
+class Recovery:
+    """What recover() found in one log."""
+
+    TOTALS = ("blocks", "rows", "bytes", "corrupt", "skipped_bytes", "missing", "has_header",
+              "next_seq", "resume")
+
+    def __init__(self):
+        self.blocks = 0           # Intact blocks copied
+        self.rows = 0             # CSV lines in them (header included)
+        self.bytes = 0            # Payload bytes copied
+        self.corrupt = 0          # Blocks with a bad header, length or CRC
+        self.skipped_bytes = 0    # Bytes passed over while resynchronizing
+        self.torn_bytes = 0       # Incomplete block at the end of the file
+        self.missing = 0          # Sequence numbers never seen
+        self.has_header = False   # Block 0 was intact
+        self.next_seq = 0         # Sequence number expected next
+        self.resume = 0           # Log offset everything before which is final
+        self.new_blocks = 0       # Blocks copied by this run
+
+    def to_dict(self):
+        return {name: getattr(self, name) for name in self.TOTALS}
+
+    @classmethod
+    def from_dict(cls, values):
+        result = cls()
+        for name in cls.TOTALS:
+            setattr(result, name, values[name])
+        return result
+
+    def describe(self):
+        text = f"Recovered {self.blocks} blocks, {self.rows} lines ({self.bytes} bytes)"
+        losses = []
+        if self.corrupt:
+            losses.append(f"{self.corrupt} corrupt blocks ({self.skipped_bytes} bytes)")
+        if self.missing:
+            losses.append(f"{self.missing} blocks missing from the sequence")
+        if self.torn_bytes:
+            losses.append(f"torn last block ({self.torn_bytes} bytes)")
+        if not self.has_header:
+            losses.append("block 0 lost: output has no CSV header")
+        return text + ("; " + ", ".join(losses) if losses else "")
+
+
+def recover_blocks(data, out, result=None):
+    """
+    Copy every intact block payload in @p data (bytes-like) to @p out.
+
+    Starts at result.resume with result.next_seq expected, so a Recovery
+    from an earlier run picks up where it stopped. A torn block or an
+    unterminated line of garbage at the end is left for the next run.
+    """
+    result = result or Recovery()
+    result.new_blocks = 0
+    result.torn_bytes = 0
+    expected_seq = result.next_seq
+    pos = result.resume
+    end = len(data)
+
+    while pos < end:
+        if data[pos:pos + len(MAGIC)] != MAGIC:
+            # Resynchronize on the next header at the start of a line
+            found = data.find(b"\n" + MAGIC, pos)
+            if found < 0:
+                # The tail may be the start of a header still being written
+                tail = data.rfind(b"\n", pos, end) + 1 or pos
+                result.skipped_bytes += tail - pos
+                result.torn_bytes = end - tail
+                pos = tail
+                break
+            result.skipped_bytes += found + 1 - pos
+            pos = found + 1
+            continue
+
+        if pos + HEADER_SIZE > end:
+            result.torn_bytes = end - pos
+            break
+        match = HEADER.fullmatch(data[pos:pos + HEADER_SIZE])
+        if match is None:
+            result.corrupt += 1
+            result.skipped_bytes += 1
+            pos += 1
+            continue
+
+        seq = int(match.group(1), 16)
+        length = int(match.group(2), 16)
+        crc = int(match.group(3), 16)
+        start = pos + HEADER_SIZE
+        if start + length > end:
+            result.torn_bytes = end - pos
+            break
+
+        payload = data[start:start + length]
+        if zlib.crc32(payload) != crc:
+            result.corrupt += 1
+            result.skipped_bytes += 1
+            pos += 1
+            continue
+
+        if seq > expected_seq:
+            result.missing += seq - expected_seq
+        if seq == 0:
+            result.has_header = True
+        expected_seq = seq + 1
+
+        out.write(payload)
+        result.blocks += 1
+        result.new_blocks += 1
+        result.rows += payload.count(b"\n")
+        result.bytes += length
+        pos = start + length
+
+    result.next_seq = expected_seq
+    result.resume = pos
+    return result
+
+
+def state_path(csv_path):
+    return str(csv_path) + ".recover"
+
+
+def _head_crc(data, length):
+    return zlib.crc32(data[:length])
+
+
+def _load_state(csv_path, data):
+    """The Recovery to resume from, or None if the CSV must be rebuilt."""
+    try:
+        with open(state_path(csv_path)) as f:
+            state = json.load(f)
+        if state.get("version") != STATE_VERSION:
+            return None
+        result = Recovery.from_dict(state["totals"])
+        head_len, csv_bytes = state["head_len"], state["csv_bytes"]
+    except (OSError, ValueError, KeyError, TypeError):
+        return None
+    if (len(data) < result.resume or len(data) < head_len or
+            _head_crc(data, head_len) != state["head_crc"]):
+        return None  # New session or a different log
+    try:
+        if os.path.getsize(csv_path) < csv_bytes:
+            return None
+    except OSError:
+        return None
+    # The CSV is appended before the state is replaced; drop what a crash left
+    with open(csv_path, "r+b") as f:
+        f.truncate(csv_bytes)
+    return result
+
+
+def _save_state(csv_path, data, result):
+    head_len = min(len(data), IDENTITY_BYTES)
+    state = {
+        "version": STATE_VERSION,
+        "head_len": head_len,
+        "head_crc": _head_crc(data, head_len),
+        "csv_bytes": os.path.getsize(csv_path),
+        "totals": result.to_dict(),
+    }
+    tmp = state_path(csv_path) + ".tmp"
+    with open(tmp, "w") as f:
+        json.dump(state, f)
+    os.replace(tmp, state_path(csv_path))
+
+
+def recover(blk_path, csv_path, full=False):
+    """
+    Bring @p csv_path up to date with @p blk_path.
+
+    Appends only the blocks written since the last run; a full rebuild
+    (@p full, or a changed log head) replaces the CSV atomically.
+    """
+    with open(blk_path, "rb") as f:
+        if os.fstat(f.fileno()).st_size == 0:
+            data = b""
+        else:
+            data = mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ)
+        try:
+            result = None if full else _load_state(csv_path, data)
+            if result is not None:
+                with open(csv_path, "ab") as out:
+                    recover_blocks(data, out, result)
+            else:
+                tmp = str(csv_path) + ".tmp"
+                with open(tmp, "wb") as out:
+                    result = recover_blocks(data, out)
+                os.replace(tmp, csv_path)
+            _save_state(csv_path, data, result)
+        finally:
+            if isinstance(data, mmap.mmap):
+                data.close()
+    return result
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Recover a Reality Clock block log into CSV")
+    parser.add_argument("log", help="sensor_log.blk")
+    parser.add_argument("-o", "--output", help="CSV to write (default: the log with a .csv suffix)")
+    parser.add_argument("--full", action="store_true", help="Rebuild the CSV instead of appending")
+    args = parser.parse_args()
+
+    output = args.output or os.path.splitext(args.log)[0] + ".csv"
+    result = recover(args.log, output, args.full)
+    print(f"{result.describe()}, {result.new_blocks} new -> {output}", file=sys.stderr)
+    return 0 if result.blocks else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -3,6 +3,19 @@
 Retrieve sensor log from Flipper Zero and analyze RSSI data.
 This script connects to the Flipper via serial, downloads the log file,
 and performs statistical analysis to determine optimal constants.
+
+Run without arguments for the interactive download + analysis. To analyze
+part of a long log, give a time range (elapsed since session start, ms or
+[Nd]HH:MM[:SS]):
+
+    retrieve_and_analyze.py --log sensor_log.blk --from 3d03:10 --to 3d03:20
+
+The app writes sensor_log.blk, a block log that survives crashes; it is
+recovered into sensor_log.csv (recover_log.py) before analysis. Recovery
+appends only the blocks written since the last run.
+
+Analysis is incremental: parsed rows and running statistics are cached in
+<log>.cache/ (log_summary.py), so a re-run only parses what was appended.
 """
 
 import os
@@ -10,9 +23,15 @@ import sys
 import time
 import glob
 import csv
-import statistics
+import argparse
 from pathlib import Path
 
+import log_index
+import log_summary
+import recover_log as recover_log_module
+
+DEVICE_LOG_PATH = "/ext/apps_data/reality_clock/sensor_log.blk"
+
 # Find Flipper serial port
 def find_flipper_port():
     """Find the Flipper Zero's serial port."""
@@ -32,8 +51,8 @@ def find_flipper_port():
 
 def download_log_via_cli(output_path):
     """
-    Download the sensor log using Flipper CLI.
-    Note: This requires the app to be closed so the file is synced.
+    Download the block log using the Flipper CLI.
+    Note: Exit the app first so the last block is written.
     """
     import serial
 
@@ -49,7 +68,7 @@ def download_log_via_cli(output_path):
         time.sleep(0.5)
 
         # Send storage read command
-        cmd = b"storage read /ext/apps_data/reality_clock/sensor_log.csv\r\n"
+        cmd = f"storage read {DEVICE_LOG_PATH}\r\n".encode()
         ser.write(cmd)
         ser.flush()
 
@@ -67,38 +86,38 @@ def download_log_via_cli(output_path):
 
         ser.close()
 
-        # Parse the response
-        text = data.decode('utf-8', errors='ignore')
-
-        # Find the CSV content (between "Size:" line and next prompt)
-        lines = text.split('\n')
-        csv_lines = []
-        in_csv = False
-
-        for line in lines:
-            if line.startswith('timestamp_ms'):
-                in_csv = True
-            if in_csv:
-                if line.strip().startswith('>') or 'storage' in line.lower():
-                    break
-                if line.strip():
-                    csv_lines.append(line.strip())
-
-        if csv_lines:
-            with open(output_path, 'w') as f:
-                f.write('\n'.join(csv_lines))
-            print(f"Downloaded {len(csv_lines)} lines to {output_path}")
-            return True
-        else:
-            print("No CSV data found in response")
+        # The CLI answers "Size: <n>\r\n" followed by exactly n raw bytes
+        size_at = data.find(b"Size: ")
+        if size_at < 0:
+            print("No log data found in response")
             return False
+        line_end = data.index(b"\n", size_at)
+        size = int(data[size_at + 6:line_end].strip())
+        body = data[line_end + 1:line_end + 1 + size]
+
+        with open(output_path, 'wb') as f:
+            f.write(body)
+        print(f"Downloaded {len(body)} of {size} bytes to {output_path}")
+        return True
 
     except Exception as e:
         print(f"Error: {e}")
         return False
 
-def analyze_log(csv_path):
-    """Analyze the sensor log and determine optimal constants."""
+def recover_log(blk_path):
+    """Recover the intact blocks of a .blk log into a CSV next to it; returns the CSV path."""
+    csv_path = os.path.splitext(str(blk_path))[0] + ".csv"
+    result = recover_log_module.recover(blk_path, csv_path)
+    print(f"{result.describe()}, {result.new_blocks} new")
+    return csv_path
+
+def analyze_log(csv_path, start_ms=None, end_ms=None, use_cache=True):
+    """
+    Analyze the sensor log (or a time range of it) and determine optimal constants.
+
+    Parsed rows and running statistics are kept in <log>.cache/ (see
+    log_summary.py), so only data appended since the last run is parsed.
+    """
 
     if not os.path.exists(csv_path):
         print(f"Log file not found: {csv_path}")
@@ -108,29 +127,53 @@ def analyze_log(csv_path):
     print("SENSOR DATA ANALYSIS")
     print(f"{'='*60}\n")
 
-    # Read CSV
-    data = {
-        'rssi_315': [],
-        'rssi_433': [],
-        'rssi_868': [],
-        'temperature': [],
-        'voltage': [],
-        'phi_current': [],
-        'match_pct': []
-    }
-
-    with open(csv_path, 'r') as f:
-        reader = csv.DictReader(f)
-        for row in reader:
-            try:
-                for key in data.keys():
-                    if key in row:
-                        data[key].append(float(row[key]))
-            except (ValueError, KeyError):
-                continue
+    if not use_cache:
+        with open(csv_path, 'r') as f:
+            return analyze_rows(csv.DictReader(f))
 
-    total_samples = len(data['rssi_315'])
-    duration_sec = total_samples  # 1 sample/sec
+    cache = log_summary.AnalysisCache(csv_path)
+    summary = cache.update(verbose=True)
+    print()
+    if start_ms is None and end_ms is None:
+        return report(summary)
+
+    # Time range: binary search in the cached elapsed_ms column
+    start_ms = start_ms or 0
+    end_ms = end_ms if end_ms is not None else float('inf')
+    print(f"Range: {log_index.format_elapsed(start_ms)} - "
+          f"{log_index.format_elapsed(end_ms) if end_ms != float('inf') else 'end'}\n")
+    return report(cache.range_summary(start_ms, end_ms))
+
+def analyze_rows(rows):
+    """Analyze an iterable of CSV row dicts without touching the cache."""
+    columns = ['rssi_315', 'rssi_433', 'rssi_868', 'temperature', 'voltage',
+               'phi_current', 'match_pct', 'heap_free', 'heap_min_free', 'stack_free']
+    data = {key: [] for key in [log_summary.ELAPSED] + columns}
+    last_ms = None
+
+    for row in rows:
+        try:
+            raw = int(row['timestamp_ms'])
+            values = {key: float(row[key]) for key in columns if key in row}
+        except (KeyError, ValueError, TypeError):
+            continue
+        last_ms = raw if last_ms is None else log_index.unwrap_ms(last_ms, raw)
+        data[log_summary.ELAPSED].append(last_ms)
+        for key, value in values.items():
+            data[key].append(value)
+
+    summary = log_summary.LogSummary([log_summary.ELAPSED] + columns)
+    summary.extend(data)
+    return report(summary)
+
+def report(summary):
+    """Print the analysis for a log_summary.LogSummary."""
+
+    rssi = summary.get('rssi_315')
+    total_samples = rssi.n if rssi else 0
+    # From the timestamps: the battery governor samples every 1 to 10 s
+    elapsed = summary.get(log_summary.ELAPSED)
+    duration_sec = round((elapsed.last - elapsed.first) / 1000) if elapsed else 0
 
     print(f"Total Samples: {total_samples}")
     print(f"Duration: {duration_sec} seconds ({duration_sec/60:.1f} minutes)")
@@ -148,45 +191,52 @@ def analyze_log(csv_path):
 
     band_stats = {}
     for name, key in bands:
-        if data[key]:
-            avg = statistics.mean(data[key])
-            std = statistics.stdev(data[key]) if len(data[key]) > 1 else 0
-            min_val = min(data[key])
-            max_val = max(data[key])
-            band_stats[key] = {'avg': avg, 'std': std, 'min': min_val, 'max': max_val}
-            print(f"{name:12} Avg: {avg:7.2f}  Std: {std:5.2f}  Range: [{min_val:.1f}, {max_val:.1f}]")
+        stats = summary.get(key)
+        if stats:
+            band_stats[key] = {'avg': stats.mean, 'std': stats.stdev, 'min': stats.min, 'max': stats.max}
+            print(f"{name:12} Avg: {stats.mean:7.2f}  Std: {stats.stdev:5.2f}  Range: [{stats.min:.1f}, {stats.max:.1f}]")
 
     print()
 
     # Temperature
-    if data['temperature']:
-        temp_avg = statistics.mean(data['temperature'])
-        temp_std = statistics.stdev(data['temperature']) if len(data['temperature']) > 1 else 0
-        print(f"Temperature: Avg: {temp_avg:.1f}°C  Std: {temp_std:.2f}°C")
+    temperature = summary.get('temperature')
+    if temperature:
+        print(f"Temperature: Avg: {temperature.mean:.1f}°C  Std: {temperature.stdev:.2f}°C")
 
     # Voltage
-    if data['voltage']:
-        volt_avg = statistics.mean(data['voltage'])
-        print(f"Battery:     Avg: {volt_avg:.3f}V")
+    voltage = summary.get('voltage')
+    if voltage:
+        print(f"Battery:     Avg: {voltage.mean:.3f}V")
 
     print()
 
     # PHI Analysis
-    if data['phi_current']:
-        phi_avg = statistics.mean(data['phi_current'])
-        phi_std = statistics.stdev(data['phi_current']) if len(data['phi_current']) > 1 else 0
-        phi_min = min(data['phi_current'])
-        phi_max = max(data['phi_current'])
+    phi = summary.get('phi_current')
+    if phi:
+        phi_avg, phi_std = phi.mean, phi.stdev
 
         print("PHI ANALYSIS:")
         print("-" * 50)
         print(f"PHI Average:  {phi_avg:.6f}")
         print(f"PHI Std Dev:  {phi_std:.6f}")
-        print(f"PHI Range:    [{phi_min:.6f}, {phi_max:.6f}]")
+        print(f"PHI Range:    [{phi.min:.6f}, {phi.max:.6f}]")
         print(f"Variation:    {(phi_std/phi_avg*100):.2f}%")
 
     print()
 
+    # Memory telemetry (absent from older logs)
+    heap = summary.get('heap_free')
+    if heap:
+        print("MEMORY:")
+        print("-" * 50)
+        print(f"Heap free:    first {heap.first:.0f}  last {heap.last:.0f}  lowest {heap.min:.0f} bytes")
+        print(f"Heap min:     {summary.get('heap_min_free').min:.0f} bytes (lowest since boot)")
+        print(f"Stack free:   {summary.get('stack_free').min:.0f} bytes never used by the app thread")
+        if heap.n > 1:
+            # Least-squares trend of free heap; a steady negative slope is a leak
+            print(f"Heap trend:   {summary.trend.per_hour:+.1f} bytes/hour")
+        print()
+
     # RECOMMENDATIONS
     print("RECOMMENDED CONSTANTS:")
     print("=" * 60)
@@ -203,7 +253,7 @@ def analyze_log(csv_path):
                 var = band_stats[key]['std'] * 2  # 2-sigma range
                 print(f"#define VAR_{key.upper().replace('RSSI_', '')}   {var:.1f}f  /* 2-sigma variation */")
 
-    if data['phi_current']:
+    if phi:
         print(f"\n/* PHI baseline (use this as the 'home' dimension baseline) */")
         print(f"#define PHI_BASELINE     {phi_avg:.6f}f")
         print(f"#define PHI_TOLERANCE    {phi_std * 2:.6f}f  /* 2-sigma for HOME threshold */")
@@ -225,14 +275,31 @@ def analyze_log(csv_path):
         'samples': total_samples,
         'duration_sec': duration_sec,
         'bands': band_stats,
-        'phi_avg': phi_avg if data['phi_current'] else None,
-        'phi_std': phi_std if data['phi_current'] else None
+        'phi_avg': phi.mean if phi else None,
+        'phi_std': phi.stdev if phi else None
     }
 
 def main():
     script_dir = Path(__file__).parent
     app_dir = script_dir.parent
-    log_path = app_dir / "sensor_log.csv"
+    log_path = app_dir / "sensor_log.blk"
+
+    if len(sys.argv) > 1:
+        parser = argparse.ArgumentParser(description="Analyze a Reality Clock sensor log")
+        parser.add_argument("--log", default=str(log_path),
+                            help="sensor_log.blk (recovered to .csv first) or a recovered sensor_log.csv")
+        parser.add_argument("--from", dest="start", help="range start, ms or [Nd]HH:MM[:SS]")
+        parser.add_argument("--to", dest="end", help="range end, ms or [Nd]HH:MM[:SS]")
+        parser.add_argument("--no-cache", action="store_true",
+                            help="parse the whole log without reading or writing <log>.cache/")
+        args = parser.parse_args()
+        start_ms = log_index.parse_elapsed(args.start) if args.start else None
+        end_ms = log_index.parse_elapsed(args.end) if args.end else None
+        if args.no_cache and (start_ms is not None or end_ms is not None):
+            parser.error("--from/--to need the cache")
+        csv_path = recover_log(args.log) if args.log.endswith(".blk") else args.log
+        analyze_log(csv_path, start_ms, end_ms, use_cache=not args.no_cache)
+        return
 
     print("Reality Clock Sensor Data Analyzer")
     print("=" * 60)
@@ -242,8 +309,8 @@ def main():
         print(f"Found existing log at: {log_path}")
         choice = input("Use existing file? (y/n): ").strip().lower()
         if choice != 'y':
-            print("\nPlease copy sensor_log.csv from your Flipper's SD card:")
-            print("  /ext/apps_data/reality_clock/sensor_log.csv")
+            print("\nPlease copy sensor_log.blk from your Flipper's SD card:")
+            print(f"  {DEVICE_LOG_PATH}")
             print(f"  to: {log_path}")
             return
     else:
@@ -253,7 +320,7 @@ def main():
         print("2. Let it collect data for at least 5-10 minutes")
         print("3. Exit the app (press BACK)")
         print("4. Copy the log file from Flipper SD card:")
-        print("   /ext/apps_data/reality_clock/sensor_log.csv")
+        print(f"   {DEVICE_LOG_PATH}")
         print(f"   to: {log_path}")
         print("\nTrying to download via CLI...")
 
@@ -264,8 +331,8 @@ def main():
             print("Please manually copy the file.")
             return
 
-    # Analyze the data
-    results = analyze_log(str(log_path))
+    # Salvage every intact block, then analyze
+    results = analyze_log(recover_log(log_path))
 
     if results and results['samples'] < 300:
         print(f"\nWARNING: Only {results['samples']} samples collected.")
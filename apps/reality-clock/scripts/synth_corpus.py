@@ -0,0 +1,257 @@
+#!/usr/bin/env python3
+"""
+Generate a labeled synthetic sensor log for benchmarking the stability engine.
+
+Real logs only show "normal" environments, so there is no ground truth to
+measure calculate_stability() / classify_status() against. This writes a
+log of any length in the app's CSV schema, built from known parts:
+
+  noise          per-band Gaussian around REAL_BASE_* with REAL_VAR_* as the
+                 2-sigma spread (read from reality_clock.c), quantized to the
+                 CC1101's 0.5 dB steps
+  thermal drift  a daily temperature cycle with a slow random walk on top;
+                 every band shifts by --temp-coeff dB per degree
+  transmitters   periodic bursts on one band (--tx), added in the power domain
+  events         steps and ramps on one band, placed at random with at least
+                 --min-gap between them so the baseline can settle
+
+Everything but the events is normal behavior the engine should ride out.
+The events are what it should flag. Each transmitter burst and event is
+written to <out>.labels.csv, in the order they end, with its kind, band,
+size and sample range.
+
+Rows follow the app's timing: CALIBRATION_SAMPLES at the calibration
+interval, then one per SAMPLE_INTERVAL_NORMAL_MS, and timestamp_ms wraps at
+2^32 like the tick. The engine columns (phi_*, stability, match_pct), the
+memory columns and io_near are zero: the first are what the engine under
+test produces, the rest describe the device.
+tools/host/detect_bench.c replays the corpus through the real engine and
+scores detection delay and false alarms against the labels.
+
+Runs are deterministic for a given --seed. A million rows take ~12 s.
+
+Usage:
+    synth_corpus.py -o corpus.csv [--days 30] [--seed 1] [--events-per-day 4]
+                    [--tx 433:300:2:-70 ...]
+"""
+
+import argparse
+import math
+import os
+import random
+import re
+import sys
+
+APP_SOURCE = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "reality_clock.c")
+
+BANDS = ("315", "433", "868")
+HEADER = ("timestamp_ms,sample_num,rssi_315,rssi_433,rssi_868,temperature,voltage,"
+          "phi_current,phi_baseline,phi_short,stability,match_pct,epoch_ms,"
+          "heap_free,heap_min_free,stack_free,io_near\n")
+LABEL_HEADER = "event,kind,band,start_sample,end_sample,start_ms,end_ms,magnitude_db,ramp_ms\n"
+
+DAY_MS = 86400 * 1000
+TICK_WRAP = 1 << 32
+
+
+def app_constants(path=APP_SOURCE):
+    """The #define'd numbers the corpus is modelled on, from the app source."""
+    with open(path) as f:
+        source = f.read()
+    names = ["REAL_BASE_" + b for b in BANDS] + ["REAL_VAR_" + b for b in BANDS] + [
+        "CALIBRATION_SAMPLES", "SAMPLE_INTERVAL_CALIB_MS", "SAMPLE_INTERVAL_NORMAL_MS"]
+    constants = {}
+    for name in names:
+        match = re.search(r"#define\s+%s\s+\(?(-?[0-9.]+)f?\)?" % name, source)
+        if match is None:
+            sys.exit(f"error: {name} not found in {path}")
+        constants[name] = float(match.group(1))
+    return constants
+
+
+def parse_range(text):
+    """'A:B' or 'A' -> (A, B) as floats."""
+    parts = [float(p) for p in text.split(":")]
+    return (parts[0], parts[-1])
+
+
+def parse_tx(text):
+    """BAND:PERIOD_S:ON_S:LEVEL_DBM"""
+    try:
+        band, period, on, level = text.split(":")
+        if band not in BANDS:
+            raise ValueError
+        return band, float(period) * 1000, float(on) * 1000, float(level)
+    except ValueError:
+        raise argparse.ArgumentTypeError(f"expected BAND:PERIOD_S:ON_S:LEVEL_DBM, got {text!r}")
+
+
+def add_power(a_dbm, b_dbm):
+    return 10.0 * math.log10(10.0 ** (a_dbm / 10.0) + 10.0 ** (b_dbm / 10.0))
+
+
+class Event:
+    """A labeled disturbance on one band between two sample numbers."""
+
+    __slots__ = ("kind", "band", "start_ms", "end_ms", "magnitude", "ramp_ms",
+                 "start_sample", "end_sample")
+
+    def __init__(self, kind, band, start_ms, end_ms, magnitude, ramp_ms=0):
+        self.kind, self.band = kind, band
+        self.start_ms, self.end_ms = start_ms, end_ms
+        self.magnitude, self.ramp_ms = magnitude, ramp_ms
+        self.start_sample = self.end_sample = None
+
+    def offset(self, ms):
+        """Offset (dB) this event adds at elapsed @p ms (inside the event)."""
+        if self.kind == "ramp" and ms - self.start_ms < self.ramp_ms:
+            return self.magnitude * (ms - self.start_ms) / self.ramp_ms
+        return self.magnitude
+
+
+def schedule_events(rng, args, duration_ms):
+    """Non-overlapping steps and ramps, Poisson arrivals separated by --min-gap."""
+    events = []
+    mean_gap_ms = DAY_MS / args.events_per_day if args.events_per_day > 0 else None
+    t = args.warmup * 1000
+    while mean_gap_ms is not None:
+        t += rng.expovariate(1.0 / mean_gap_ms)
+        length = rng.uniform(*args.event_s) * 1000
+        if t + length >= duration_ms:
+            break
+        kind = rng.choice(("step", "ramp"))
+        magnitude = rng.uniform(*args.step_db) * rng.choice((-1, 1))
+        ramp = min(rng.uniform(*args.ramp_s) * 1000, length) if kind == "ramp" else 0
+        events.append(Event(kind, rng.choice(BANDS), int(t), int(t + length), magnitude, int(ramp)))
+        t += length + args.min_gap * 1000
+    return events
+
+
+def generate(args, out, labels):
+    c = app_constants()
+    rng = random.Random(args.seed)
+    calib_ms = int(c["SAMPLE_INTERVAL_CALIB_MS"])
+    normal_ms = int(c["SAMPLE_INTERVAL_NORMAL_MS"])
+    calib_samples = int(c["CALIBRATION_SAMPLES"])
+
+    if args.samples:
+        duration_ms = calib_samples * calib_ms + (args.samples - calib_samples) * normal_ms
+    else:
+        duration_ms = int(args.days * DAY_MS)
+
+    base = [c["REAL_BASE_" + b] for b in BANDS]
+    sigma = [c["REAL_VAR_" + b] / 2.0 * args.noise_scale for b in BANDS]
+    tx = [(BANDS.index(band), period, on, level, rng.uniform(0, period))
+          for band, period, on, level in args.tx]
+    events = schedule_events(rng, args, duration_ms)
+    temp_walk = 0.0
+
+    out.write(HEADER)
+    ms = 0
+    sample = 0
+    event_i = 0
+    tx_open = [None] * len(tx)   # Burst being labeled, per transmitter
+    label_rows = []
+
+    while ms <= duration_ms and (not args.samples or sample < args.samples):
+        sample += 1
+
+        # Thermal drift: daily cycle peaking mid-afternoon plus a slow walk
+        temp_walk += rng.gauss(0.0, 0.002) - temp_walk * 1e-5
+        hour = (args.start_hour + ms / 3600000.0) % 24.0
+        temp_offset = args.temp_swing * math.sin(2 * math.pi * (hour - 9.0) / 24.0) + temp_walk
+        temperature = args.temp_mean + temp_offset + rng.gauss(0.0, 0.1)
+
+        rssi = [base[i] + rng.gauss(0.0, sigma[i]) + args.temp_coeff * temp_offset
+                for i in range(3)]
+
+        for n, (band, period, on, level, phase) in enumerate(tx):
+            bursting = (ms + phase) % period < on
+            if bursting:
+                rssi[band] = add_power(rssi[band], level + rng.gauss(0.0, 1.0))
+                if tx_open[n] is None:
+                    tx_open[n] = Event("tx", BANDS[band], ms, ms, level)
+                    tx_open[n].start_sample = sample
+                tx_open[n].end_ms, tx_open[n].end_sample = ms, sample
+            elif tx_open[n] is not None:
+                label_rows.append(tx_open[n])
+                tx_open[n] = None
+
+        while event_i < len(events) and events[event_i].end_ms < ms:
+            label_rows.append(events[event_i])
+            event_i += 1
+        if event_i < len(events) and events[event_i].start_ms <= ms:
+            event = events[event_i]
+            if event.start_sample is None:
+                event.start_sample = sample
+            event.end_sample = sample
+            rssi[BANDS.index(event.band)] += event.offset(ms)
+
+        if not args.continuous:
+            rssi = [round(v * 2.0) / 2.0 for v in rssi]
+
+        voltage = 4.15 - 0.5 * ms / duration_ms if duration_ms else 4.15
+        epoch_ms = args.epoch * 1000 + ms
+        out.write(f"{ms % TICK_WRAP},{sample},{rssi[0]:.2f},{rssi[1]:.2f},{rssi[2]:.2f},"
+                  f"{temperature:.2f},{voltage:.3f},0.000000,0.000000,0.000000,0.00,0.00,"
+                  f"{epoch_ms},0,0,0,0\n")
+
+        if len(label_rows) >= 1024:
+            write_labels(labels, label_rows)
+        ms += calib_ms if sample < calib_samples else normal_ms + rng.randint(0, args.jitter)
+
+    label_rows.extend(e for e in tx_open if e is not None)
+    label_rows.extend(e for e in events[event_i:] if e.start_sample is not None)
+    write_labels(labels, label_rows)
+    return sample, sum(1 for e in events if e.start_sample is not None)
+
+
+_label_count = 0
+
+
+def write_labels(labels, rows):
+    global _label_count
+    for e in rows:
+        _label_count += 1
+        labels.write(f"{_label_count},{e.kind},{e.band},{e.start_sample},{e.end_sample},"
+                     f"{e.start_ms},{e.end_ms},{e.magnitude:.2f},{e.ramp_ms}\n")
+    rows.clear()
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Generate a labeled synthetic Reality Clock log")
+    parser.add_argument("-o", "--output", required=True, help="CSV to write")
+    parser.add_argument("--labels", help="Label CSV (default: <output>.labels.csv)")
+    length = parser.add_mutually_exclusive_group()
+    length.add_argument("--days", type=float, default=7.0, help="Simulated duration (default 7)")
+    length.add_argument("--samples", type=int, help="Number of rows instead of --days")
+    parser.add_argument("--seed", type=int, default=1)
+    parser.add_argument("--epoch", type=int, default=1767225600, help="RTC time of the first row (Unix s)")
+    parser.add_argument("--start-hour", type=float, default=0.0, help="Time of day of the first row")
+    parser.add_argument("--noise-scale", type=float, default=1.0, help="Multiplies every band's sigma")
+    parser.add_argument("--continuous", action="store_true", help="Skip the 0.5 dB quantization")
+    parser.add_argument("--jitter", type=int, default=0, help="Extra 0..N ms per normal interval")
+    parser.add_argument("--temp-mean", type=float, default=25.0, help="Mean temperature (C)")
+    parser.add_argument("--temp-swing", type=float, default=3.0, help="Daily temperature amplitude (C)")
+    parser.add_argument("--temp-coeff", type=float, default=-0.05, help="RSSI drift per degree (dB/C)")
+    parser.add_argument("--tx", type=parse_tx, action="append", default=[],
+                        help="Periodic transmitter BAND:PERIOD_S:ON_S:LEVEL_DBM (repeatable)")
+    parser.add_argument("--events-per-day", type=float, default=4.0, help="Mean anomaly rate")
+    parser.add_argument("--step-db", type=parse_range, default=(3.0, 12.0), help="Event size range A:B (dB)")
+    parser.add_argument("--event-s", type=parse_range, default=(300.0, 3600.0), help="Event length range A:B (s)")
+    parser.add_argument("--ramp-s", type=parse_range, default=(60.0, 900.0), help="Ramp rise time range A:B (s)")
+    parser.add_argument("--min-gap", type=float, default=3600.0, help="Quiet time after each event (s)")
+    parser.add_argument("--warmup", type=float, default=3600.0, help="Quiet time before the first event (s)")
+    args = parser.parse_args()
+
+    labels_path = args.labels or args.output + ".labels.csv"
+    with open(args.output, "w", newline="") as out, open(labels_path, "w", newline="") as labels:
+        labels.write(LABEL_HEADER)
+        rows, events = generate(args, out, labels)
+    print(f"{rows} rows, {events} events, {_label_count} labels -> {args.output}, {labels_path}",
+          file=sys.stderr)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,436 @@
+#!/usr/bin/env python3
+"""
+Generate the apps' bitmap headers from editable sources.
+
+Bitmaps used to live in the app sources as hand-typed hex. They are now
+drawn in apps/<app>/assets/ and compiled into apps/<app>/<app>_assets.h,
+already in the layout the app's draw path wants, so nothing is converted
+on the device:
+
+  glyphs  one PBM per glyph (P1 or P4, any image editor writes them), or a
+          PNG when Pillow is installed. Emitted as XBM rows (LSB = leftmost
+          pixel) shifted right by `shift` bits, so a glyph drawn at an x
+          with that remainder mod 8 is ORed into an XBM frame byte by byte.
+  qr      a text file holding the payload. Encoded here (byte mode,
+          versions 1-5, the mask with the lowest penalty) and emitted as
+          one XBM pre-scaled by `scale`, drawn with one canvas_draw_xbm().
+
+The generated headers are committed, so ufbt builds need no Python. The
+table printed at the end (and kept in each header's comment) is the flash
+cost of every asset next to the plain 1-bpp size of its source.
+
+Usage:
+    gen_assets.py            regenerate every header and print the report
+    gen_assets.py --check    exit 1 if a committed header is out of date
+"""
+
+import argparse
+import os
+import sys
+
+ROOT = os.path.normpath(os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", ".."))
+GENERATOR = "tools/assets/gen_assets.py"
+
+
+class Glyphs:
+    """A set of equally sized glyphs, shifted for an XBM frame."""
+
+    def __init__(self, name, pattern, keys, shift=0):
+        self.name, self.pattern, self.keys, self.shift = name, pattern, list(keys), shift
+
+    def build(self, asset_dir):
+        glyphs = [read_bitmap(os.path.join(asset_dir, self.pattern % k)) for k in self.keys]
+        width, height = len(glyphs[0][0]), len(glyphs[0])
+        for k, rows in zip(self.keys, glyphs):
+            if (len(rows[0]), len(rows)) != (width, height):
+                sys.exit(f"error: {self.pattern % k} is {len(rows[0])}x{len(rows)}, "
+                         f"expected {width}x{height}")
+        stride = (width + self.shift + 7) // 8
+        tables = [xbm_rows(rows, self.shift, stride) for rows in glyphs]
+        prefix = self.name.upper()
+        defines = [(f"{prefix}_WIDTH", width), (f"{prefix}_HEIGHT", height),
+                   (f"{prefix}_SHIFT", self.shift), (f"{prefix}_BYTES_PER_ROW", stride)]
+        code = (f"static const uint8_t {self.name}[{len(self.keys)}][{height * stride}] = {{\n"
+                + "".join(f"    {{ /* {k} */\n{hex_rows(t, stride)}    }},\n"
+                          for k, t in zip(self.keys, tables))
+                + "};\n")
+        return Built(self, self.pattern.replace("%d", "*").replace("%s", "*"),
+                     f"{width}x{height} x{len(self.keys)}",
+                     f"XBM, shifted {self.shift}" if self.shift else "XBM",
+                     len(self.keys) * ((width + 7) // 8) * height,
+                     len(self.keys) * height * stride, defines, code)
+
+
+class Qr:
+    """A QR code encoded from a text payload, pre-scaled."""
+
+    def __init__(self, name, source, scale=1, ecc="L"):
+        self.name, self.source, self.scale, self.ecc = name, source, scale, ecc
+
+    def build(self, asset_dir):
+        with open(os.path.join(asset_dir, self.source), "rb") as f:
+            payload = f.read().rstrip(b"\r\n")
+        modules, version, mask = qr_encode(payload, self.ecc)
+        rows = [[bit for bit in row for _ in range(self.scale)]
+                for row in modules for _ in range(self.scale)]
+        size = len(rows)
+        stride = (size + 7) // 8
+        prefix = self.name.upper()
+        defines = [(f"{prefix}_WIDTH", size), (f"{prefix}_HEIGHT", size)]
+        code = (f"/* {payload.decode('utf-8', 'replace')} */\n"
+                f"static const uint8_t {self.name}[{size * stride}] = {{\n"
+                f"{hex_rows(xbm_rows(rows, 0, stride), stride, '')}}};\n")
+        return Built(self, self.source, f"{size}x{size}",
+                     f"XBM, v{version}-{self.ecc} mask {mask} x{self.scale}",
+                     len(modules) * ((len(modules) + 7) // 8), size * stride, defines, code)
+
+
+class Built:
+    """One generated asset: its report row and its C text."""
+
+    def __init__(self, asset, source, size, layout, packed, flash, defines, code):
+        self.name, self.source, self.size, self.layout = asset.name, source, size, layout
+        self.packed, self.flash, self.defines, self.code = packed, flash, defines, code
+
+
+#: Every app's assets, in the order they appear in its header
+ASSETS = {
+    "big-clock": [
+        # The four digits sit at CLOCK_START_X + 0/24/56/80 = 4 (mod 8)
+        Glyphs("digit_xbm", "digit_%d.pbm", range(10), shift=4),
+    ],
+    "reality-clock": [
+        Qr("qr_code_xbm", "qr_payload.txt", scale=2, ecc="L"),
+    ],
+}
+
+
+# ============================================================================
+# Bitmaps
+# ============================================================================
+
+def read_bitmap(path):
+    """Rows of 0/1 (1 = pixel on) from a PBM, or a PNG through Pillow."""
+    if path.endswith(".png"):
+        try:
+            from PIL import Image
+        except ImportError:
+            sys.exit(f"error: {path}: reading PNG needs Pillow (poetry install)")
+        image = Image.open(path).convert("1")
+        return [[0 if image.getpixel((x, y)) else 1 for x in range(image.width)]
+                for y in range(image.height)]
+
+    with open(path, "rb") as f:
+        data = f.read()
+    magic, rest = data[:2], data[2:]
+    tokens = []
+    pos = 0
+    # Header: width and height, '#' comments allowed between tokens
+    while len(tokens) < 2:
+        while rest[pos:pos + 1].isspace():
+            pos += 1
+        if rest[pos:pos + 1] == b"#":
+            pos = rest.index(b"\n", pos)
+            continue
+        start = pos
+        while pos < len(rest) and not rest[pos:pos + 1].isspace():
+            pos += 1
+        tokens.append(int(rest[start:pos]))
+    width, height = tokens
+    if magic == b"P1":
+        body = b"\n".join(line.split(b"#")[0] for line in rest[pos:].split(b"\n"))
+        bits = [c - 48 for c in body if c in b"01"]
+        if len(bits) < width * height:
+            sys.exit(f"error: {path}: {len(bits)} pixels, expected {width * height}")
+        return [bits[y * width:(y + 1) * width] for y in range(height)]
+    if magic == b"P4":
+        stride = (width + 7) // 8
+        raw = rest[pos + 1:]
+        return [[(raw[y * stride + x // 8] >> (7 - x % 8)) & 1 for x in range(width)]
+                for y in range(height)]
+    sys.exit(f"error: {path}: not a PBM (P1/P4) file")
+
+
+def xbm_rows(rows, shift, stride):
+    """Pack rows LSB first, @p shift blank pixels on the left, @p stride bytes each."""
+    out = []
+    for row in rows:
+        packed = bytearray(stride)
+        for x, bit in enumerate(row):
+            if bit:
+                packed[(x + shift) // 8] |= 1 << ((x + shift) % 8)
+        out.append(packed)
+    return out
+
+
+def hex_rows(rows, stride, indent="    "):
+    per_line = max(1, 16 // stride)
+    lines = []
+    for i in range(0, len(rows), per_line):
+        chunk = b"".join(rows[i:i + per_line])
+        lines.append(f"{indent}    " + " ".join(f"0x{b:02X}," for b in chunk) + "\n")
+    return "".join(lines)
+
+
+# ============================================================================
+# QR encoding (ISO/IEC 18004, byte mode, versions 1-5)
+# ============================================================================
+
+#: (version, level) -> (EC codewords per block, data codewords of each block)
+QR_BLOCKS = {
+    (1, "L"): (7, [19]), (1, "M"): (10, [16]), (1, "Q"): (13, [13]), (1, "H"): (17, [9]),
+    (2, "L"): (10, [34]), (2, "M"): (16, [28]), (2, "Q"): (22, [22]), (2, "H"): (28, [16]),
+    (3, "L"): (15, [55]), (3, "M"): (26, [44]), (3, "Q"): (18, [17] * 2), (3, "H"): (22, [13] * 2),
+    (4, "L"): (20, [80]), (4, "M"): (18, [32] * 2), (4, "Q"): (26, [24] * 2), (4, "H"): (16, [9] * 4),
+    (5, "L"): (26, [108]), (5, "M"): (24, [43] * 2), (5, "Q"): (18, [15, 15, 16, 16]),
+    (5, "H"): (22, [11, 11, 12, 12]),
+}
+QR_ALIGNMENT = {1: [], 2: [6, 18], 3: [6, 22], 4: [6, 26], 5: [6, 30]}
+QR_LEVEL_BITS = {"L": 1, "M": 0, "Q": 3, "H": 2}
+QR_MASKS = [
+    lambda r, c: (r + c) % 2 == 0,
+    lambda r, c: r % 2 == 0,
+    lambda r, c: c % 3 == 0,
+    lambda r, c: (r + c) % 3 == 0,
+    lambda r, c: (r // 2 + c // 3) % 2 == 0,
+    lambda r, c: (r * c) % 2 + (r * c) % 3 == 0,
+    lambda r, c: ((r * c) % 2 + (r * c) % 3) % 2 == 0,
+    lambda r, c: ((r + c) % 2 + (r * c) % 3) % 2 == 0,
+]
+
+
+def gf_mul(a, b):
+    result = 0
+    while b:
+        if b & 1:
+            result ^= a
+        a = (a << 1) ^ (0x11D if a & 0x80 else 0)
+        b >>= 1
+    return result
+
+
+def rs_remainder(data, degree):
+    """Reed-Solomon EC codewords for @p data over GF(256)."""
+    generator = [1]
+    root = 1
+    for _ in range(degree):
+        generator = [a ^ gf_mul(b, root) for a, b in zip(generator + [0], [0] + generator)]
+        root = gf_mul(root, 2)
+    remainder = [0] * degree
+    for byte in data:
+        factor = byte ^ remainder.pop(0)
+        remainder.append(0)
+        for i in range(degree):
+            remainder[i] ^= gf_mul(generator[i + 1], factor)
+    return remainder
+
+
+def qr_codewords(payload, version, level):
+    ec_len, blocks = QR_BLOCKS[(version, level)]
+    capacity = sum(blocks)
+    bits = [0, 1, 0, 0] + [(len(payload) >> i) & 1 for i in range(7, -1, -1)]
+    for byte in payload:
+        bits += [(byte >> i) & 1 for i in range(7, -1, -1)]
+    bits += [0] * min(4, capacity * 8 - len(bits))
+    bits += [0] * (-len(bits) % 8)
+    data = [int("".join(map(str, bits[i:i + 8])), 2) for i in range(0, len(bits), 8)]
+    data += [0xEC, 0x11] * ((capacity - len(data)) // 2 + 1)
+    data = data[:capacity]
+
+    split, pos = [], 0
+    for length in blocks:
+        split.append(data[pos:pos + length])
+        pos += length
+    ec = [rs_remainder(block, ec_len) for block in split]
+    out = [b[i] for i in range(max(blocks)) for b in split if i < len(b)]
+    return out + [e[i] for i in range(ec_len) for e in ec]
+
+
+def qr_function_modules(version):
+    """Matrix with the fixed patterns drawn, and which modules they occupy."""
+    size = 17 + 4 * version
+    grid = [[0] * size for _ in range(size)]
+    fixed = [[False] * size for _ in range(size)]
+
+    def put(r, c, bit):
+        grid[r][c], fixed[r][c] = bit, True
+
+    for r0, c0 in ((0, 0), (0, size - 7), (size - 7, 0)):
+        for dr in range(-1, 8):
+            for dc in range(-1, 8):
+                r, c = r0 + dr, c0 + dc
+                if 0 <= r < size and 0 <= c < size:
+                    ring = max(abs(dr - 3), abs(dc - 3))
+                    put(r, c, 1 if ring != 2 and ring != 4 else 0)
+    for i in range(8, size - 8):
+        put(6, i, 1 - i % 2)
+        put(i, 6, 1 - i % 2)
+    centers = QR_ALIGNMENT[version]
+    for r0 in centers:
+        for c0 in centers:
+            if fixed[r0][c0]:
+                continue
+            for dr in range(-2, 3):
+                for dc in range(-2, 3):
+                    put(r0 + dr, c0 + dc, 1 if max(abs(dr), abs(dc)) != 1 else 0)
+    # Reserve the format areas; qr_format() fills them in
+    for i in range(9):
+        fixed[8][i] = fixed[i][8] = True
+    for i in range(8):
+        fixed[8][size - 1 - i] = fixed[size - 1 - i][8] = True
+    put(size - 8, 8, 1)
+    return grid, fixed
+
+
+def qr_format(grid, level, mask):
+    size = len(grid)
+    data = QR_LEVEL_BITS[level] << 3 | mask
+    rem = data
+    for _ in range(10):
+        rem = (rem << 1) ^ ((rem >> 9) * 0x537)
+    bits = (data << 10 | rem) ^ 0x5412
+    bit = [(bits >> i) & 1 for i in range(15)]
+    for i in range(6):
+        grid[i][8] = bit[i]
+    grid[7][8], grid[8][8], grid[8][7] = bit[6], bit[7], bit[8]
+    for i in range(9, 15):
+        grid[8][14 - i] = bit[i]
+    for i in range(8):
+        grid[8][size - 1 - i] = bit[i]
+    for i in range(8, 15):
+        grid[size - 15 + i][8] = bit[i]
+
+
+def qr_penalty(grid):
+    size = len(grid)
+    score = 0
+    lines = grid + [list(col) for col in zip(*grid)]
+    for line in lines:
+        run, prev = 0, None
+        for bit in line:
+            run = run + 1 if bit == prev else 1
+            prev = bit
+            if run == 5:
+                score += 3
+            elif run > 5:
+                score += 1
+        text = "".join(map(str, line))
+        score += 40 * (text.count("10111010000") + text.count("00001011101"))
+    for r in range(size - 1):
+        for c in range(size - 1):
+            if grid[r][c] == grid[r][c + 1] == grid[r + 1][c] == grid[r + 1][c + 1]:
+                score += 3
+    dark = sum(map(sum, grid))
+    score += 10 * (abs(dark * 100 // (size * size) - 50) // 5)
+    return score
+
+
+def qr_encode(payload, level):
+    """Smallest matrix holding @p payload: (rows of 0/1, version, mask)."""
+    for version in range(1, 6):
+        if len(payload) + 2 <= sum(QR_BLOCKS[(version, level)][1]):
+            break
+    else:
+        sys.exit(f"error: {len(payload)}-byte QR payload needs a version above 5")
+
+    base, fixed = qr_function_modules(version)
+    size = len(base)
+    bits = [(byte >> i) & 1 for byte in qr_codewords(payload, version, level)
+            for i in range(7, -1, -1)]
+    positions = []
+    upward = True
+    right = size - 1
+    while right >= 1:
+        if right == 6:
+            right = 5  # Skip the vertical timing pattern
+        for step in range(size):
+            r = size - 1 - step if upward else step
+            for c in (right, right - 1):
+                if not fixed[r][c]:
+                    positions.append((r, c))
+        upward = not upward
+        right -= 2
+
+    best = None
+    for candidate in range(8):
+        grid = [row[:] for row in base]
+        for i, (r, c) in enumerate(positions):
+            bit = bits[i] if i < len(bits) else 0
+            grid[r][c] = bit ^ (1 if QR_MASKS[candidate](r, c) else 0)
+        qr_format(grid, level, candidate)
+        score = qr_penalty(grid)
+        if best is None or score < best[0]:
+            best = (score, grid, candidate)
+    return best[1], version, best[2]
+
+
+# ============================================================================
+# Headers
+# ============================================================================
+
+def report_rows(built):
+    rows = [("Asset", "Source", "Size", "Layout", "1-bpp", "Flash")]
+    rows += [(b.name, b.source, b.size, b.layout, str(b.packed), str(b.flash)) for b in built]
+    rows.append(("Total", "", "", "", str(sum(b.packed for b in built)),
+                 str(sum(b.flash for b in built))))
+    widths = [max(len(r[i]) for r in rows) for i in range(6)]
+    return ["  ".join(cell.rjust(w) if i >= 4 else cell.ljust(w)
+                      for i, (cell, w) in enumerate(zip(r, widths))).rstrip() for r in rows]
+
+
+def render_header(app, built):
+    stem = app.replace("-", "_")
+    lines = [
+        "/**",
+        f" * @file {stem}_assets.h",
+        f" * @brief Bitmaps for {app}, generated from apps/{app}/assets/",
+        " *",
+        f" * Generated by {GENERATOR} - edit the sources and rerun it",
+        " * (just assets) rather than editing this file. Sizes are in bytes:",
+        " *",
+    ]
+    lines += [f" *   {row}".rstrip() for row in report_rows(built)]
+    lines += [" *", " * SPDX-License-Identifier: MIT", " */", "", "#pragma once", "",
+              "#include <stdint.h>", ""]
+    for b in built:
+        for name, value in b.defines:
+            lines.append(f"#define {name} {value}")
+        lines.append("")
+        lines.append(b.code)
+    return "\n".join(lines).rstrip("\n") + "\n"
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Generate the apps' bitmap headers")
+    parser.add_argument("--check", action="store_true",
+                        help="Only check that every generated header is up to date")
+    args = parser.parse_args()
+
+    stale = []
+    report = []
+    for app, assets in ASSETS.items():
+        asset_dir = os.path.join(ROOT, "apps", app, "assets")
+        built = [asset.build(asset_dir) for asset in assets]
+        path = os.path.join(ROOT, "apps", app, app.replace("-", "_") + "_assets.h")
+        text = render_header(app, built)
+        current = open(path).read() if os.path.exists(path) else None
+        if current != text:
+            stale.append(os.path.relpath(path, ROOT))
+            if not args.check:
+                with open(path, "w") as f:
+                    f.write(text)
+        report.append(f"{app}:")
+        report += [f"  {row}" for row in report_rows(built)]
+
+    if args.check:
+        for path in stale:
+            print(f"{path} is out of date: run {GENERATOR}", file=sys.stderr)
+        return 1 if stale else 0
+    print("\n".join(report))
+    for path in stale:
+        print(f"wrote {path}", file=sys.stderr)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,425 @@
+#!/usr/bin/env python3
+"""
+Host benchmark runner and results store.
+
+Builds the host harnesses, runs every available benchmark and records the
+numbers in tools/host/bench_results.json, keyed by git commit:
+
+  - soak throughput: simulated samples (Reality Clock) or frames (Big Clock)
+    per second of host run time, over several repetitions
+  - render cost: frames, draw calls and pixels for every session in
+    tools/host/sessions/ (deterministic, one run each)
+  - memory footprint: peak heap, and mallocs once the main loop is running
+
+`compare` checks one commit's results against a baseline. Deterministic
+counters regress on any change in the wrong direction. Timed metrics regress
+only when a one-sided Mann-Whitney U test is significant AND the median moved
+by more than --threshold, so ordinary run-to-run noise is not reported.
+
+Usage:
+    bench.py run [--reps N] [--no-save] [--baseline REF]
+    bench.py compare [--baseline REF] [--commit REF]
+    bench.py baseline [REF]
+    bench.py list
+"""
+
+import argparse
+import datetime
+import glob
+import json
+import math
+import os
+import platform
+import re
+import statistics
+import subprocess
+import sys
+
+ROOT = os.path.abspath(os.path.join(os.path.dirname(__file__), "..", ".."))
+RESULTS_PATH = os.path.join(ROOT, "tools", "host", "bench_results.json")
+BUILD_DIR = os.path.join(ROOT, "build", "host")
+SCHEMA_VERSION = 1
+
+CFLAGS = ["-std=gnu11", "-O2", "-Wall", "-Itools/host/include"]
+
+DEFAULT_REPS = 7
+DEFAULT_ALPHA = 0.01
+DEFAULT_THRESHOLD = 0.03
+
+# Soak benchmarks: app, simulated days, (metric, unit) for the timed throughput
+SOAKS = [
+    ("reality-clock", 10, ("samples_per_s", "samples/s")),
+    ("big-clock", 10, ("frames_per_s", "frames/s")),
+]
+
+# Deterministic counters from a replay session: metric -> unit (lower is better)
+REPLAY_METRICS = {
+    "frames": "frames",
+    "draw_primitives": "calls",
+    "draw_pixels": "pixels",
+    "notifications": "messages",
+    "queue_put_failures": "events",
+    "heap_peak_bytes": "bytes",
+    "storage_writes": "writes",
+}
+
+
+# ==== Git ====
+
+
+def _git(*args):
+    result = subprocess.run(["git", *args], cwd=ROOT, capture_output=True, text=True)
+    if result.returncode != 0:
+        raise SystemExit(f"git {' '.join(args)}: {result.stderr.strip()}")
+    return result.stdout.strip()
+
+
+def resolve_commit(ref):
+    """Full hash for a git ref; results keys may also carry a '+dirty' suffix."""
+    suffix = ""
+    if ref.endswith("+dirty"):
+        ref, suffix = ref[: -len("+dirty")], "+dirty"
+    return _git("rev-parse", "--verify", ref + "^{commit}") + suffix
+
+
+#: What the benchmarks build from; the results file itself is not an input
+BENCH_INPUTS = ["apps", "tools/host", ":!tools/host/bench_results.json"]
+
+
+def tree_is_dirty():
+    """Uncommitted changes to anything the benchmarks build from."""
+    return bool(_git("status", "--porcelain", "--", *BENCH_INPUTS))
+
+
+def last_input_commit(commit):
+    """Newest commit up to @p commit that changed a benchmark input."""
+    return _git("log", "-1", "--format=%H", commit, "--", *BENCH_INPUTS) or commit
+
+
+# ==== Build and Run ====
+
+
+def _compile(output, sources, defines=()):
+    os.makedirs(BUILD_DIR, exist_ok=True)
+    cmd = ["cc", *CFLAGS, *defines, "tools/host/host_stub.c", *sources, "-lm", "-o", output]
+    subprocess.run(cmd, cwd=ROOT, check=True)
+    return output
+
+
+def build_soak(app):
+    harness = f"tools/host/soak_{app.replace('-', '_')}.c"
+    return _compile(os.path.join(BUILD_DIR, f"bench_soak_{app}"), [harness])
+
+
+def build_replay(app):
+    fam = open(os.path.join(ROOT, "apps", app, "application.fam")).read()
+    entry = re.search(r'entry_point\s*=\s*"([^"]+)"', fam).group(1)
+    source = sorted(glob.glob(os.path.join(ROOT, "apps", app, "*.c")))[0]
+    defines = [f'-DAPP_SOURCE="{source}"', f"-DAPP_ENTRY={entry}"]
+    return _compile(os.path.join(BUILD_DIR, f"bench_replay_{app}"), ["tools/host/replay.c"], defines)
+
+
+def _run_json(cmd):
+    result = subprocess.run(cmd, cwd=ROOT, capture_output=True, text=True)
+    if result.returncode != 0:
+        sys.stderr.write(result.stderr)
+        raise SystemExit(f"{' '.join(cmd)} failed (exit {result.returncode})")
+    return json.loads(result.stdout.strip().splitlines()[-1])
+
+
+def session_app(session):
+    """App folder for a session file, from its name prefix (big_clock_* -> big-clock)."""
+    name = os.path.basename(session)
+    for app in sorted(os.listdir(os.path.join(ROOT, "apps")), key=len, reverse=True):
+        if name.startswith(app.replace("-", "_") + "_"):
+            return app
+    return None
+
+
+def _metric(unit, better, values):
+    return {"unit": unit, "better": better, "values": values}
+
+
+def run_benchmarks(reps):
+    metrics = {}
+
+    for app, days, (name, unit) in SOAKS:
+        binary = build_soak(app)
+        samples = []
+        for _ in range(reps):
+            summary = _run_json([binary, "--days", str(days), "--json"])
+            samples.append(summary[name])
+        print(f"  {app} soak: median {statistics.median(samples):.0f} {unit} over {reps} runs")
+        metrics[f"{app}/soak/{name}"] = _metric(unit, "higher", samples)
+        metrics[f"{app}/soak/heap_peak_bytes"] = _metric("bytes", "lower", [summary["heap_peak_bytes"]])
+        metrics[f"{app}/soak/mallocs_after_start"] = _metric(
+            "calls", "lower", [summary["mallocs_after_start"]])
+        if "arena_bytes" in summary:
+            metrics[f"{app}/soak/arena_bytes"] = _metric("bytes", "lower", [summary["arena_bytes"]])
+
+    replays = {}
+    for session in sorted(glob.glob(os.path.join(ROOT, "tools", "host", "sessions", "*.txt"))):
+        app = session_app(session)
+        if app is None:
+            print(f"  skipping {os.path.basename(session)}: no matching app", file=sys.stderr)
+            continue
+        if app not in replays:
+            replays[app] = build_replay(app)
+        summary = _run_json([replays[app], "--json", os.path.relpath(session, ROOT)])
+        label = os.path.splitext(os.path.basename(session))[0]
+        for name, unit in REPLAY_METRICS.items():
+            metrics[f"{app}/replay/{label}/{name}"] = _metric(unit, "lower", [summary[name]])
+        print(f"  {label}: {summary['frames']} frames, {summary['draw_primitives']} draw calls")
+
+    return metrics
+
+
+# ==== Results Store ====
+
+
+def load_results():
+    if not os.path.exists(RESULTS_PATH):
+        return {"schema": SCHEMA_VERSION, "baseline": None, "results": {}}
+    with open(RESULTS_PATH) as f:
+        store = json.load(f)
+    if store.get("schema") != SCHEMA_VERSION:
+        raise SystemExit(f"{RESULTS_PATH}: schema {store.get('schema')}, expected {SCHEMA_VERSION}")
+    return store
+
+
+def save_results(store):
+    tmp = RESULTS_PATH + ".tmp"
+    with open(tmp, "w") as f:
+        json.dump(store, f, indent=1, sort_keys=True)
+        f.write("\n")
+    os.replace(tmp, RESULTS_PATH)
+
+
+def _compiler():
+    result = subprocess.run(["cc", "--version"], capture_output=True, text=True)
+    return result.stdout.splitlines()[0] if result.returncode == 0 else "unknown"
+
+
+# ==== Statistics ====
+
+
+def mann_whitney_p(worse, better):
+    """
+    One-sided p-value that `worse` tends to be larger than `better`.
+
+    Normal approximation with tie correction; adequate from about 5 samples
+    per side, which is why timed metrics default to 7 repetitions.
+    """
+    n1, n2 = len(worse), len(better)
+    ranked = sorted([(v, 0) for v in worse] + [(v, 1) for v in better])
+    ranks = [0.0] * len(ranked)
+    tie_term = 0.0
+    i = 0
+    while i < len(ranked):
+        j = i
+        while j + 1 < len(ranked) and ranked[j + 1][0] == ranked[i][0]:
+            j += 1
+        for k in range(i, j + 1):
+            ranks[k] = (i + j) / 2.0 + 1.0
+        ties = j - i + 1
+        tie_term += ties ** 3 - ties
+        i = j + 1
+
+    rank_sum = sum(r for r, (_, side) in zip(ranks, ranked) if side == 0)
+    u = rank_sum - n1 * (n1 + 1) / 2.0
+    n = n1 + n2
+    mean = n1 * n2 / 2.0
+    variance = n1 * n2 / 12.0 * ((n + 1) - tie_term / (n * (n - 1)))
+    if variance <= 0:
+        return 1.0
+    z = (u - mean - 0.5) / math.sqrt(variance)  # Continuity correction
+    return 0.5 * math.erfc(z / math.sqrt(2.0))
+
+
+def compare_metric(base, current, alpha, threshold):
+    """Return (status, relative_change, p) for one metric."""
+    b, c = base["values"], current["values"]
+    higher_better = current["better"] == "higher"
+    b_mid, c_mid = statistics.median(b), statistics.median(c)
+    change = (c_mid - b_mid) / b_mid if b_mid else (0.0 if c_mid == b_mid else math.inf)
+    worse = change < 0 if higher_better else change > 0
+
+    if len(b) == 1 and len(c) == 1:
+        # Deterministic counter: any move is real
+        if c_mid == b_mid:
+            return "same", change, None
+        return ("REGRESSION" if worse else "improved"), change, None
+
+    if higher_better:
+        p_worse, p_better = mann_whitney_p(b, c), mann_whitney_p(c, b)
+    else:
+        p_worse, p_better = mann_whitney_p(c, b), mann_whitney_p(b, c)
+    if abs(change) > threshold:
+        if worse and p_worse < alpha:
+            return "REGRESSION", change, p_worse
+        if not worse and p_better < alpha:
+            return "improved", change, p_better
+    return "same", change, min(p_worse, p_better)
+
+
+def compare(store, base_key, current_key, alpha, threshold):
+    """Print a comparison table; return the number of regressions."""
+    base = store["results"][base_key]
+    current = store["results"][current_key]
+    print(f"Baseline {base_key[:12]}  {base.get('subject', '')}")
+    print(f"Current  {current_key[:12]}  {current.get('subject', '')}")
+    for field in ("machine", "compiler"):
+        if base.get(field) != current.get(field):
+            print(f"  warning: {field} differs ({base.get(field)} vs {current.get(field)}); "
+                  "timings are not comparable")
+
+    regressions = 0
+    print()
+    print(f"  {'metric':<58} {'baseline':>12} {'current':>12} {'change':>8}  {'p':>7}  status")
+    for name in sorted(current["metrics"]):
+        if name not in base["metrics"]:
+            print(f"  {name:<58} {'-':>12} {statistics.median(current['metrics'][name]['values']):>12.6g}"
+                  f" {'':>8}  {'':>7}  new")
+            continue
+        status, change, p = compare_metric(base["metrics"][name], current["metrics"][name], alpha, threshold)
+        regressions += status == "REGRESSION"
+        p_text = f"{p:.4f}" if p is not None else "-"
+        print(f"  {name:<58} {statistics.median(base['metrics'][name]['values']):>12.6g} "
+              f"{statistics.median(current['metrics'][name]['values']):>12.6g} {change:>+7.1%}  {p_text:>7}  {status}")
+    for name in sorted(set(base["metrics"]) - set(current["metrics"])):
+        print(f"  {name:<58} {'':>12} {'-':>12} {'':>8}  {'':>7}  removed")
+
+    print()
+    print(f"{regressions} regression{'s' if regressions != 1 else ''}")
+    return regressions
+
+
+def _default_baseline(store, current_key):
+    if store.get("baseline") and store["baseline"] != current_key:
+        return store["baseline"]
+    others = [k for k in store["results"] if k != current_key]
+    if not others:
+        return None
+    return max(others, key=lambda k: store["results"][k].get("date", ""))
+
+
+# ==== Commands ====
+
+
+def cmd_run(args):
+    commit = resolve_commit("HEAD")
+    key = commit + ("+dirty" if tree_is_dirty() else "")
+    print(f"Benchmarking {key[:12]}{' (uncommitted changes)' if key.endswith('+dirty') else ''}, "
+          f"{args.reps} reps")
+
+    entry = {
+        "commit": commit,
+        "dirty": key.endswith("+dirty"),
+        "subject": _git("log", "-1", "--format=%s", commit),
+        "date": datetime.datetime.now(datetime.timezone.utc).isoformat(timespec="seconds"),
+        "machine": f"{platform.system()} {platform.machine()}",
+        "compiler": _compiler(),
+        "reps": args.reps,
+        "metrics": run_benchmarks(args.reps),
+    }
+
+    store = load_results()
+    store["results"][key] = entry
+    if not args.no_save:
+        save_results(store)
+        print(f"Saved to {os.path.relpath(RESULTS_PATH, ROOT)} as {key[:12]}")
+
+    base_key = _lookup(store, args.baseline) if args.baseline else _default_baseline(store, key)
+    if base_key is None:
+        print("No baseline yet; compare against this run later with `just bench-compare`")
+        return 0
+    print()
+    return 1 if compare(store, base_key, key, args.alpha, args.threshold) else 0
+
+
+def cmd_compare(args):
+    store = load_results()
+    current_key = _lookup(store, args.commit)
+    base_key = _lookup(store, args.baseline) if args.baseline else _default_baseline(store, current_key)
+    if base_key is None:
+        raise SystemExit("no baseline: store results for another commit first")
+    return 1 if compare(store, base_key, current_key, args.alpha, args.threshold) else 0
+
+
+def _lookup(store, ref):
+    """Stored key for a ref, preferring clean results over '+dirty' ones.
+
+    A commit that changed no benchmark input (such as the one committing
+    the results) falls back to the clean results of the commit it inherits
+    its inputs from.
+    """
+    if ref is None:
+        commit = resolve_commit("HEAD")
+        candidates = [commit + "+dirty", commit] if tree_is_dirty() else [commit, commit + "+dirty"]
+    else:
+        key = resolve_commit(ref)
+        commit = key[: -len("+dirty")] if key.endswith("+dirty") else key
+        candidates = [key] if key.endswith("+dirty") else [key, key + "+dirty"]
+    if not candidates[0].endswith("+dirty"):
+        candidates.append(last_input_commit(commit))
+    for key in candidates:
+        if key in store["results"]:
+            return key
+    raise SystemExit(f"no stored results for {ref or 'HEAD'} (run `just bench` first)")
+
+
+def cmd_baseline(args):
+    store = load_results()
+    key = _lookup(store, args.ref)
+    store["baseline"] = key
+    save_results(store)
+    print(f"Baseline set to {key[:12]}  {store['results'][key].get('subject', '')}")
+    return 0
+
+
+def cmd_list(args):
+    store = load_results()
+    for key, entry in sorted(store["results"].items(), key=lambda item: item[1].get("date", "")):
+        mark = "*" if key == store.get("baseline") else " "
+        print(f"{mark} {key[:12]:<18} {entry.get('date', ''):<26} {entry.get('subject', '')}")
+    return 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Run and compare host benchmarks")
+    sub = parser.add_subparsers(dest="command", required=True)
+
+    def add_stats(p):
+        p.add_argument("--alpha", type=float, default=DEFAULT_ALPHA,
+                       help=f"significance level for timed metrics (default {DEFAULT_ALPHA})")
+        p.add_argument("--threshold", type=float, default=DEFAULT_THRESHOLD,
+                       help=f"smallest relative change worth reporting (default {DEFAULT_THRESHOLD})")
+
+    p = sub.add_parser("run", help="build, run and store the benchmarks for HEAD")
+    p.add_argument("--reps", type=int, default=DEFAULT_REPS, help="repetitions of each timed benchmark")
+    p.add_argument("--no-save", action="store_true", help="do not write the results file")
+    p.add_argument("--baseline", help="commit to compare against (default: stored baseline)")
+    add_stats(p)
+    p.set_defaults(func=cmd_run)
+
+    p = sub.add_parser("compare", help="compare stored results against a baseline")
+    p.add_argument("--baseline", help="baseline commit (default: stored baseline, else newest other)")
+    p.add_argument("--commit", help="commit to check (default: HEAD)")
+    add_stats(p)
+    p.set_defaults(func=cmd_compare)
+
+    p = sub.add_parser("baseline", help="make a commit's stored results the baseline")
+    p.add_argument("ref", nargs="?", help="commit (default: HEAD)")
+    p.set_defaults(func=cmd_baseline)
+
+    p = sub.add_parser("list", help="list stored results")
+    p.set_defaults(func=cmd_list)
+
+    args = parser.parse_args()
+    if getattr(args, "reps", DEFAULT_REPS) < 1:
+        parser.error("--reps must be at least 1")
+    return args.func(args)
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,339 @@
+/**
+ * @file detect_bench.c
+ * @brief Detection benchmark for Reality Clock's stability engine
+ *
+ * Replays a labeled corpus from scripts/synth_corpus.py through the app's
+ * real update_readings() - rolling buffers, PHI, adaptive baseline,
+ * calculate_stability() and classify_status() - one row per sample. The app
+ * is built with DEBUG_SHADOW_ENGINES, so every engine in shadow_engines[]
+ * sees the same samples; each one's status timeline is scored against the
+ * labels:
+ *
+ *   - an alarm is any calibrated sample classified Unstable or Foreign
+ *   - a step or ramp event is detected by the first alarm between its start
+ *     and GRACE after its end; the delay is measured from its start
+ *   - an alarm that starts outside every event window is a false alarm;
+ *     those within GRACE of a transmitter burst are counted separately
+ *
+ * Engine 0 replays production; the report flags any sample where it
+ * disagrees with the app's own status. The corpus bypasses the decimators:
+ * its rows are already at the sample rate, as the app logs them.
+ *
+ *   detect_bench [--grace-s N] [--json] <corpus.csv> [labels.csv]
+ *
+ * Labels default to <corpus.csv>.labels.csv.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "host_stub.h"
+
+#include <math.h>
+
+#define DEBUG_SHADOW_ENGINES 1
+#include "../../apps/reality-clock/reality_clock.c"
+
+#define DEFAULT_GRACE_S 600
+#define CORPUS_LINE_MAX 512
+#define MAX_DELAYS      65536
+
+typedef struct {
+    uint64_t start_ms;
+    uint64_t end_ms;   /**< Window end, grace included */
+    uint8_t detected;  /**< Bit per engine */
+} LabelWindow;
+
+typedef struct {
+    LabelWindow* items;
+    size_t count;
+    size_t capacity;
+} LabelList;
+
+static void label_list_add(LabelList* list, uint64_t start_ms, uint64_t end_ms) {
+    if(list->count == list->capacity) {
+        list->capacity = list->capacity ? list->capacity * 2 : 64;
+        list->items = realloc(list->items, list->capacity * sizeof(LabelWindow));
+        furi_check(list->items != NULL);
+    }
+    list->items[list->count++] = (LabelWindow){start_ms, end_ms, 0};
+}
+
+static int label_window_cmp(const void* a, const void* b) {
+    const LabelWindow* x = a;
+    const LabelWindow* y = b;
+    return (x->start_ms > y->start_ms) - (x->start_ms < y->start_ms);
+}
+
+/** One engine's result against the labels */
+typedef struct {
+    bool alarm;
+    uint64_t alarm_samples;
+    uint64_t alarm_samples_outside;
+    uint64_t false_alarms;
+    uint64_t false_alarms_near_tx;
+    size_t detected;
+    double* delays;
+    size_t delay_count;
+    double delay_mean;
+    double delay_median;
+    double delay_max;
+} EngineScore;
+
+_Static_assert(SHADOW_MAX_ENGINES <= 8, "LabelWindow.detected holds one bit per engine");
+
+static int double_cmp(const void* a, const void* b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Load step/ramp events and transmitter bursts, each sorted by start
+ * @return false if the file cannot be read
+ */
+static bool labels_load(const char* path, uint64_t grace_ms, LabelList* events, LabelList* bursts) {
+    FILE* f = fopen(path, "r");
+    if(f == NULL) {
+        fprintf(stderr, "error: cannot open %s\n", path);
+        return false;
+    }
+    char line[CORPUS_LINE_MAX];
+    char kind[16];
+    unsigned long long start_ms, end_ms;
+    while(fgets(line, sizeof(line), f)) {
+        /* event,kind,band,start_sample,end_sample,start_ms,end_ms,magnitude_db,ramp_ms */
+        if(sscanf(line, "%*u,%15[^,],%*[^,],%*u,%*u,%llu,%llu", kind, &start_ms, &end_ms) != 3) {
+            continue;  /* Header */
+        }
+        LabelList* list = strcmp(kind, "tx") == 0 ? bursts : events;
+        label_list_add(list, start_ms, end_ms + grace_ms);
+    }
+    fclose(f);
+    qsort(events->items, events->count, sizeof(LabelWindow), label_window_cmp);
+    qsort(bursts->items, bursts->count, sizeof(LabelWindow), label_window_cmp);
+    return true;
+}
+
+/** @brief Index of @p name in a CSV header line, or -1 */
+static int csv_column(const char* header, const char* name) {
+    size_t len = strlen(name);
+    int index = 0;
+    for(const char* p = header; *p; index++) {
+        if(strncmp(p, name, len) == 0 && (p[len] == ',' || p[len] == '\n' || p[len] == '\r' || !p[len])) {
+            return index;
+        }
+        p = strchr(p, ',');
+        if(p == NULL) break;
+        p++;
+    }
+    return -1;
+}
+
+int main(int argc, char** argv) {
+    bool json = false;
+    uint64_t grace_ms = DEFAULT_GRACE_S * 1000ULL;
+    const char* corpus = NULL;
+    const char* labels = NULL;
+
+    for(int i = 1; i < argc; i++) {
+        if(strcmp(argv[i], "--json") == 0) {
+            json = true;
+        } else if(strcmp(argv[i], "--grace-s") == 0 && i + 1 < argc) {
+            grace_ms = strtoull(argv[++i], NULL, 10) * 1000ULL;
+        } else if(corpus == NULL) {
+            corpus = argv[i];
+        } else if(labels == NULL) {
+            labels = argv[i];
+        } else {
+            corpus = NULL;
+            break;
+        }
+    }
+    if(corpus == NULL) {
+        fprintf(stderr, "usage: %s [--grace-s N] [--json] <corpus.csv> [labels.csv]\n", argv[0]);
+        return 2;
+    }
+
+    char labels_default[1024];
+    if(labels == NULL) {
+        snprintf(labels_default, sizeof(labels_default), "%s.labels.csv", corpus);
+        labels = labels_default;
+    }
+    LabelList events = {0}, bursts = {0};
+    if(!labels_load(labels, grace_ms, &events, &bursts)) return 2;
+
+    FILE* f = fopen(corpus, "r");
+    if(f == NULL) {
+        fprintf(stderr, "error: cannot open %s\n", corpus);
+        return 2;
+    }
+    char line[CORPUS_LINE_MAX];
+    if(!fgets(line, sizeof(line), f)) {
+        fprintf(stderr, "error: %s is empty\n", corpus);
+        return 2;
+    }
+    int col_ts = csv_column(line, "timestamp_ms");
+    int col_rssi[3] = {
+        csv_column(line, "rssi_315"), csv_column(line, "rssi_433"), csv_column(line, "rssi_868")};
+    int col_temp = csv_column(line, "temperature");
+    int col_epoch = csv_column(line, "epoch_ms");
+    if(col_ts < 0 || col_rssi[0] < 0 || col_rssi[1] < 0 || col_rssi[2] < 0 || col_temp < 0) {
+        fprintf(stderr, "error: %s is not a Reality Clock log\n", corpus);
+        return 2;
+    }
+
+    RealityClockState* state = state_alloc();
+
+    EngineScore scores[SHADOW_ENGINE_COUNT] = {0};
+    for(size_t e = 0; e < SHADOW_ENGINE_COUNT; e++) {
+        scores[e].delays = malloc(MAX_DELAYS * sizeof(double));
+        furi_check(scores[e].delays != NULL);
+    }
+    uint64_t samples = 0, replica_mismatches = 0;
+    uint64_t elapsed_ms = 0;
+    uint32_t last_ts = 0;
+    size_t next_event = 0, next_burst = 0;
+    uint64_t burst_reach_ms = 0;
+
+    uint64_t wall_start_us = host_wall_us();
+    while(fgets(line, sizeof(line), f)) {
+        double values[32];
+        int n = 0;
+        for(char* p = line; n < 32;) {
+            values[n++] = strtod(p, &p);
+            if(*p != ',') break;
+            p++;
+        }
+        if(n <= col_temp || n <= col_rssi[2]) continue;  /* Torn or malformed row */
+
+        /* Unwrap the 32-bit tick the log carries */
+        uint32_t ts = (uint32_t)values[col_ts];
+        if(samples > 0) elapsed_ms += (uint32_t)(ts - last_ts);
+        last_ts = ts;
+        host_clock_set_us(elapsed_ms * 1000ULL);
+
+        /* The time-of-day profile reads the RTC: start it at the corpus's wall time */
+        if(samples == 0 && col_epoch >= 0 && col_epoch < n) {
+            host_rtc_set_epoch((uint32_t)(values[col_epoch] / 1000.0));
+        }
+
+        state->rssi_315 = state->lf_raw = (float)values[col_rssi[0]];
+        state->rssi_433 = state->hf_raw = (float)values[col_rssi[1]];
+        state->rssi_868 = state->uhf_raw = (float)values[col_rssi[2]];
+        state->temperature = (float)values[col_temp];
+        update_readings(state);
+        samples++;
+        if(state->is_calibrated && state->shadow[0].status != DimStatusCalibrating &&
+           state->shadow[0].status != state->status) {
+            replica_mismatches++;
+        }
+
+        while(next_event < events.count && events.items[next_event].end_ms < elapsed_ms) {
+            next_event++;
+        }
+        LabelWindow* event = NULL;
+        if(next_event < events.count && events.items[next_event].start_ms <= elapsed_ms) {
+            event = &events.items[next_event];
+        }
+        while(next_burst < bursts.count && bursts.items[next_burst].start_ms <= elapsed_ms) {
+            if(bursts.items[next_burst].end_ms > burst_reach_ms) {
+                burst_reach_ms = bursts.items[next_burst].end_ms;
+            }
+            next_burst++;
+        }
+
+        for(size_t e = 0; e < SHADOW_ENGINE_COUNT; e++) {
+            EngineScore* score = &scores[e];
+            bool was_alarm = score->alarm;
+            score->alarm = shadow_is_alarm(state->shadow[e].status);
+            if(!score->alarm) continue;
+
+            score->alarm_samples++;
+            if(event != NULL) {
+                if(!(event->detected & (1u << e))) {
+                    event->detected |= (uint8_t)(1u << e);
+                    if(score->delay_count < MAX_DELAYS) {
+                        score->delays[score->delay_count++] =
+                            (double)(elapsed_ms - event->start_ms) / 1000.0;
+                    }
+                }
+            } else {
+                score->alarm_samples_outside++;
+                if(!was_alarm) {
+                    score->false_alarms++;
+                    if(elapsed_ms <= burst_reach_ms) score->false_alarms_near_tx++;
+                }
+            }
+        }
+    }
+    double wall_s = (double)(host_wall_us() - wall_start_us) / 1e6;
+    fclose(f);
+
+    double days = (double)elapsed_ms / 86400000.0;
+    double rate = wall_s > 0.0 ? (double)samples / wall_s : 0.0;
+
+    for(size_t e = 0; e < SHADOW_ENGINE_COUNT; e++) {
+        EngineScore* score = &scores[e];
+        for(size_t i = 0; i < events.count; i++) {
+            score->detected += (events.items[i].detected >> e) & 1u;
+        }
+        qsort(score->delays, score->delay_count, sizeof(double), double_cmp);
+        for(size_t i = 0; i < score->delay_count; i++) {
+            score->delay_mean += score->delays[i] / (double)score->delay_count;
+        }
+        if(score->delay_count) {
+            score->delay_median = score->delays[score->delay_count / 2];
+            score->delay_max = score->delays[score->delay_count - 1];
+        }
+    }
+
+    if(json) {
+        printf("{\"corpus\": \"%s\", \"samples\": %llu, \"days\": %.3f, \"events\": %zu, "
+               "\"replica_mismatches\": %llu, \"samples_per_s\": %.0f, \"engines\": [",
+            corpus, (unsigned long long)samples, days, events.count,
+            (unsigned long long)replica_mismatches, rate);
+        for(size_t e = 0; e < SHADOW_ENGINE_COUNT; e++) {
+            const EngineScore* score = &scores[e];
+            const ShadowEngine* engine = &state->shadow[e];
+            printf("%s{\"name\": \"%s\", \"detected\": %zu, \"delay_mean_s\": %.1f, "
+                   "\"delay_median_s\": %.1f, \"delay_max_s\": %.1f, \"false_alarms\": %llu, "
+                   "\"false_alarms_near_tx\": %llu, \"false_alarms_per_day\": %.3f, "
+                   "\"alarm_samples_outside\": %llu, \"agree\": %.4f, \"skipped\": %lu}",
+                e ? ", " : "", shadow_engines[e].name, score->detected, score->delay_mean,
+                score->delay_median, score->delay_max, (unsigned long long)score->false_alarms,
+                (unsigned long long)score->false_alarms_near_tx,
+                days > 0.0 ? (double)score->false_alarms / days : 0.0,
+                (unsigned long long)score->alarm_samples_outside,
+                engine->samples ? (double)engine->agree / engine->samples : 0.0,
+                (unsigned long)engine->skipped);
+        }
+        printf("]}\n");
+    } else {
+        printf("Corpus:             %s\n", corpus);
+        printf("Samples:            %llu (%.2f days)\n", (unsigned long long)samples, days);
+        printf("Events:             %zu (grace %llu s)\n",
+            events.count, (unsigned long long)(grace_ms / 1000));
+        printf("Production replica: %s\n",
+            replica_mismatches ? "MISMATCH" : "matches production on every sample");
+        printf("Host rate:          %.0f samples/s\n\n", rate);
+
+        printf("%-8s %9s %21s %14s %7s %7s %8s\n", "Engine", "Detected", "Delay mean/med/max s",
+            "False/day", "Near tx", "Agree", "ns/upd");
+        for(size_t e = 0; e < SHADOW_ENGINE_COUNT; e++) {
+            const EngineScore* score = &scores[e];
+            const ShadowEngine* engine = &state->shadow[e];
+            printf("%-8s %4zu/%-4zu %7.0f/%6.0f/%6.0f %14.2f %7llu %6.1f%% %8.0f\n",
+                shadow_engines[e].name, score->detected, events.count, score->delay_mean,
+                score->delay_median, score->delay_max,
+                days > 0.0 ? (double)score->false_alarms / days : 0.0,
+                (unsigned long long)score->false_alarms_near_tx,
+                engine->samples ? 100.0 * engine->agree / engine->samples : 0.0,
+                engine->samples ? (double)engine->cycles * 1000.0 / SHADOW_CPU_MHZ / engine->samples : 0.0);
+        }
+    }
+
+    for(size_t e = 0; e < SHADOW_ENGINE_COUNT; e++) free(scores[e].delays);
+    free(events.items);
+    free(bursts.items);
+    state_free(state);
+    return replica_mismatches ? 1 : 0;
+}
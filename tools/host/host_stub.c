@@ -0,0 +1,1130 @@
+/**
+ * @file host_stub.c
+ * @brief Host implementation of the Furi SDK subset used by the apps
+ *
+ * Single-threaded model of the firmware: the app's entry point runs on the
+ * caller's thread, the "GUI thread" draws whenever the app blocks, and input
+ * events scheduled by the harness are delivered through the app's own input
+ * callback, exactly as the input service would.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#define _DEFAULT_SOURCE
+
+#include "host_stub.h"
+
+#include <notification/notification_messages.h>
+#include <storage/storage.h>
+#include <flipper_format/flipper_format.h>
+
+#include <errno.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <time.h>
+#include <unistd.h>
+
+/* The stub's own bookkeeping uses the real allocator and is never counted */
+#undef malloc
+#undef realloc
+#undef free
+
+HostCounters host_counters;
+
+void host_counters_reset(void) {
+    int64_t live = host_counters.heap_live_bytes;
+    memset(&host_counters, 0, sizeof(host_counters));
+    host_counters.heap_live_bytes = live;
+    host_counters.heap_peak_bytes = live;
+}
+
+void host_check_failed(const char* expr, const char* file, int line) {
+    fprintf(stderr, "furi_check failed: %s (%s:%d)\n", expr, file, line);
+    abort();
+}
+
+/* ============================================================================
+ * HEAP
+ * ============================================================================
+ * Every block carries a 16-byte header with its size so live/peak bytes can
+ * be tracked without a side table.
+ */
+
+#define HEAP_HEADER 16
+
+void* host_malloc(size_t size) {
+    uint8_t* block = malloc(size + HEAP_HEADER);
+    if(block == NULL) return NULL;
+    *(size_t*)block = size;
+
+    host_counters.malloc_calls++;
+    host_counters.heap_live_bytes += (int64_t)size;
+    if(host_counters.heap_live_bytes > host_counters.heap_peak_bytes) {
+        host_counters.heap_peak_bytes = host_counters.heap_live_bytes;
+    }
+    return block + HEAP_HEADER;
+}
+
+void host_free(void* ptr) {
+    if(ptr == NULL) return;
+    uint8_t* block = (uint8_t*)ptr - HEAP_HEADER;
+    host_counters.free_calls++;
+    host_counters.heap_live_bytes -= (int64_t)*(size_t*)block;
+    free(block);
+}
+
+void* host_realloc(void* ptr, size_t size) {
+    void* fresh = host_malloc(size);
+    if(fresh && ptr) {
+        size_t old = *(size_t*)((uint8_t*)ptr - HEAP_HEADER);
+        memcpy(fresh, ptr, old < size ? old : size);
+        host_free(ptr);
+    }
+    return fresh;
+}
+
+/*
+ * memmgr view of the same heap: the firmware's share is a fixed slice, the
+ * app's share is whatever host_malloc() has live. Stack depth is not modeled;
+ * furi_thread_get_stack_space() returns what the harness set.
+ */
+
+#define HOST_HEAP_TOTAL  (192 * 1024)
+#define HOST_HEAP_SYSTEM (112 * 1024) /* Firmware services, GUI and loader */
+
+static uint32_t stack_space = 1024;
+
+size_t memmgr_get_total_heap(void) {
+    return HOST_HEAP_TOTAL;
+}
+
+size_t memmgr_get_free_heap(void) {
+    return (size_t)(HOST_HEAP_TOTAL - HOST_HEAP_SYSTEM - host_counters.heap_live_bytes);
+}
+
+size_t memmgr_get_minimum_free_heap(void) {
+    return (size_t)(HOST_HEAP_TOTAL - HOST_HEAP_SYSTEM - host_counters.heap_peak_bytes);
+}
+
+FuriThreadId furi_thread_get_current_id(void) {
+    return &stack_space;
+}
+
+uint32_t furi_thread_get_stack_space(FuriThreadId thread_id) {
+    UNUSED(thread_id);
+    return stack_space;
+}
+
+void host_set_stack_space(uint32_t bytes) {
+    stack_space = bytes;
+}
+
+/* ============================================================================
+ * VIRTUAL CLOCK
+ * ============================================================================ */
+
+static uint64_t clock_us;
+static uint32_t rtc_epoch = 1767225600; /* 2026-01-01 00:00:00 UTC */
+static double rtc_drift_ppm;
+
+uint64_t host_clock_us(void) {
+    return clock_us;
+}
+
+void host_clock_set_us(uint64_t us) {
+    clock_us = us;
+}
+
+/* Virtual time of the last SD write, sync or backlight update */
+static uint64_t host_io_last_us = UINT64_MAX;
+static uint32_t storage_sync_us;
+
+void host_set_storage_sync_us(uint32_t us) {
+    storage_sync_us = us;
+}
+
+static void host_io_mark(void) {
+    host_io_last_us = clock_us;
+}
+
+uint64_t host_wall_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000;
+}
+
+void host_rtc_set_epoch(uint32_t unix_seconds) {
+    rtc_epoch = unix_seconds;
+}
+
+void host_rtc_set_drift_ppm(double ppm) {
+    rtc_drift_ppm = ppm;
+}
+
+uint32_t furi_get_tick(void) {
+    /* Wraps exactly like the 32-bit firmware tick */
+    return (uint32_t)(clock_us / 1000);
+}
+
+uint32_t furi_kernel_get_tick_frequency(void) {
+    return 1000;
+}
+
+void furi_delay_us(uint32_t us) {
+    clock_us += us;
+}
+
+void furi_delay_ms(uint32_t ms) {
+    clock_us += (uint64_t)ms * 1000;
+}
+
+uint32_t furi_hal_rtc_get_timestamp(void) {
+    double rtc_us = (double)clock_us * (1.0 + rtc_drift_ppm * 1e-6);
+    return rtc_epoch + (uint32_t)(rtc_us / 1e6);
+}
+
+void furi_hal_rtc_get_datetime(DateTime* datetime) {
+    uint32_t ts = furi_hal_rtc_get_timestamp();
+    uint32_t secs = ts % 86400;
+    int64_t days = ts / 86400;
+
+    datetime->hour = secs / 3600;
+    datetime->minute = (secs / 60) % 60;
+    datetime->second = secs % 60;
+    datetime->weekday = (uint8_t)(((days + 3) % 7) + 1); /* 1970-01-01 was a Thursday */
+
+    /* Civil-from-days (Howard Hinnant) */
+    days += 719468;
+    int64_t era = days / 146097;
+    int64_t doe = days - era * 146097;
+    int64_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    int64_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    int64_t mp = (5 * doy + 2) / 153;
+    int64_t d = doy - (153 * mp + 2) / 5 + 1;
+    int64_t m = mp < 10 ? mp + 3 : mp - 9;
+    datetime->year = (uint16_t)(yoe + era * 400 + (m <= 2));
+    datetime->month = (uint8_t)m;
+    datetime->day = (uint8_t)d;
+}
+
+/* ============================================================================
+ * GUI: CANVAS, VIEW PORT
+ * ============================================================================ */
+
+struct Canvas {
+    uint8_t fb[HOST_SCREEN_HEIGHT][HOST_SCREEN_WIDTH];
+    Color color;
+};
+
+struct ViewPort {
+    ViewPortDrawCallback draw_callback;
+    void* draw_context;
+    ViewPortInputCallback input_callback;
+    void* input_context;
+    bool dirty;
+};
+
+struct Gui {
+    ViewPort* view_port;
+};
+
+static Canvas canvas;
+static Gui gui;
+
+static void canvas_pixel(Canvas* c, int32_t x, int32_t y) {
+    if(x < 0 || y < 0 || x >= HOST_SCREEN_WIDTH || y >= HOST_SCREEN_HEIGHT) return;
+    host_counters.draw_pixels++;
+    switch(c->color) {
+    case ColorBlack:
+        c->fb[y][x] = 1;
+        break;
+    case ColorWhite:
+        c->fb[y][x] = 0;
+        break;
+    default:
+        c->fb[y][x] ^= 1;
+        break;
+    }
+}
+
+void canvas_clear(Canvas* c) {
+    memset(c->fb, 0, sizeof(c->fb));
+    c->color = ColorBlack;
+}
+
+void canvas_set_color(Canvas* c, Color color) {
+    c->color = color;
+}
+
+void canvas_set_font(Canvas* c, Font font) {
+    UNUSED(c);
+    UNUSED(font);
+}
+
+void canvas_draw_dot(Canvas* c, int32_t x, int32_t y) {
+    host_counters.draw_primitives++;
+    canvas_pixel(c, x, y);
+}
+
+void canvas_draw_box(Canvas* c, int32_t x, int32_t y, size_t width, size_t height) {
+    host_counters.draw_primitives++;
+    for(size_t row = 0; row < height; row++) {
+        for(size_t col = 0; col < width; col++) {
+            canvas_pixel(c, x + (int32_t)col, y + (int32_t)row);
+        }
+    }
+}
+
+void canvas_draw_frame(Canvas* c, int32_t x, int32_t y, size_t width, size_t height) {
+    host_counters.draw_primitives++;
+    if(width == 0 || height == 0) return;
+    for(size_t col = 0; col < width; col++) {
+        canvas_pixel(c, x + (int32_t)col, y);
+        canvas_pixel(c, x + (int32_t)col, y + (int32_t)height - 1);
+    }
+    for(size_t row = 1; row + 1 < height; row++) {
+        canvas_pixel(c, x, y + (int32_t)row);
+        canvas_pixel(c, x + (int32_t)width - 1, y + (int32_t)row);
+    }
+}
+
+void canvas_draw_line(Canvas* c, int32_t x1, int32_t y1, int32_t x2, int32_t y2) {
+    host_counters.draw_primitives++;
+    int32_t dx = abs(x2 - x1), sx = x1 < x2 ? 1 : -1;
+    int32_t dy = -abs(y2 - y1), sy = y1 < y2 ? 1 : -1;
+    int32_t err = dx + dy;
+    for(;;) {
+        canvas_pixel(c, x1, y1);
+        if(x1 == x2 && y1 == y2) break;
+        int32_t e2 = 2 * err;
+        if(e2 >= dy) {
+            err += dy;
+            x1 += sx;
+        }
+        if(e2 <= dx) {
+            err += dx;
+            y1 += sy;
+        }
+    }
+}
+
+void canvas_draw_xbm(
+    Canvas* c,
+    int32_t x,
+    int32_t y,
+    size_t width,
+    size_t height,
+    const uint8_t* bitmap) {
+    host_counters.draw_primitives++;
+    size_t stride = (width + 7) / 8;
+    for(size_t row = 0; row < height; row++) {
+        for(size_t col = 0; col < width; col++) {
+            if(bitmap[row * stride + col / 8] & (1 << (col % 8))) {
+                canvas_pixel(c, x + (int32_t)col, y + (int32_t)row);
+            }
+        }
+    }
+}
+
+void canvas_draw_str(Canvas* c, int32_t x, int32_t y, const char* str) {
+    UNUSED(c);
+    UNUSED(x);
+    UNUSED(y);
+    UNUSED(str);
+    host_counters.draw_primitives++;
+}
+
+void canvas_draw_str_aligned(
+    Canvas* c,
+    int32_t x,
+    int32_t y,
+    Align horizontal,
+    Align vertical,
+    const char* str) {
+    UNUSED(horizontal);
+    UNUSED(vertical);
+    canvas_draw_str(c, x, y, str);
+}
+
+
+ViewPort* view_port_alloc(void) {
+    ViewPort* view_port = host_malloc(sizeof(ViewPort));
+    memset(view_port, 0, sizeof(ViewPort));
+    return view_port;
+}
+
+void view_port_free(ViewPort* view_port) {
+    if(gui.view_port == view_port) gui.view_port = NULL;
+    host_free(view_port);
+}
+
+void view_port_draw_callback_set(ViewPort* view_port, ViewPortDrawCallback callback, void* context) {
+    view_port->draw_callback = callback;
+    view_port->draw_context = context;
+}
+
+void view_port_input_callback_set(
+    ViewPort* view_port,
+    ViewPortInputCallback callback,
+    void* context) {
+    view_port->input_callback = callback;
+    view_port->input_context = context;
+}
+
+void view_port_update(ViewPort* view_port) {
+    host_counters.view_port_updates++;
+    view_port->dirty = true;
+}
+
+void gui_add_view_port(Gui* g, ViewPort* view_port, GuiLayer layer) {
+    UNUSED(layer);
+    g->view_port = view_port;
+    view_port->dirty = true;
+}
+
+void gui_remove_view_port(Gui* g, ViewPort* view_port) {
+    if(g->view_port == view_port) g->view_port = NULL;
+}
+
+void* host_draw_context(void) {
+    return gui.view_port ? gui.view_port->draw_context : NULL;
+}
+
+const uint8_t* host_framebuffer(void) {
+    return &canvas.fb[0][0];
+}
+
+void host_render_now(void) {
+    ViewPort* view_port = gui.view_port;
+    if(view_port == NULL || view_port->draw_callback == NULL) return;
+    view_port->dirty = false;
+    host_counters.frames++;
+    canvas.color = ColorBlack;
+    view_port->draw_callback(&canvas, view_port->draw_context);
+}
+
+static void render_if_dirty(void) {
+    if(gui.view_port && gui.view_port->dirty) host_render_now();
+}
+
+/* ============================================================================
+ * INPUT SCHEDULE
+ * ============================================================================ */
+
+typedef struct {
+    uint64_t at_us;
+    InputEvent event;
+    uint32_t stall_ms;  /**< Non-zero: not an event, the app thread is busy this long */
+} ScheduledInput;
+
+static ScheduledInput* schedule;
+static size_t schedule_count;
+static size_t schedule_capacity;
+static uint32_t input_sequence;
+
+static bool schedule_insert(uint64_t at_us, InputEvent event, uint32_t stall_ms) {
+    if(schedule_count == schedule_capacity) {
+        size_t capacity = schedule_capacity ? schedule_capacity * 2 : 64;
+        ScheduledInput* grown = realloc(schedule, capacity * sizeof(ScheduledInput));
+        if(grown == NULL) return false;
+        schedule = grown;
+        schedule_capacity = capacity;
+    }
+
+    /* Keep sorted by time; events at the same instant keep insertion order */
+    size_t pos = schedule_count;
+    while(pos > 0 && schedule[pos - 1].at_us > at_us) {
+        schedule[pos] = schedule[pos - 1];
+        pos--;
+    }
+    schedule[pos].at_us = at_us;
+    schedule[pos].event = event;
+    schedule[pos].stall_ms = stall_ms;
+    schedule_count++;
+    return true;
+}
+
+bool host_input_schedule(uint64_t at_us, InputKey key, InputType type) {
+    InputEvent event = {.sequence = ++input_sequence, .key = key, .type = type};
+    return schedule_insert(at_us, event, 0);
+}
+
+bool host_stall_schedule(uint64_t at_us, uint32_t ms) {
+    InputEvent none = {0};
+    return ms > 0 && schedule_insert(at_us, none, ms);
+}
+
+void host_input_schedule_tap(uint64_t at_us, InputKey key) {
+    host_input_schedule(at_us, key, InputTypePress);
+    host_input_schedule(at_us + 80000, key, InputTypeShort);
+    host_input_schedule(at_us + 80000, key, InputTypeRelease);
+}
+
+static void deliver_next(void) {
+    ScheduledInput next = schedule[0];
+    schedule_count--;
+    memmove(schedule, schedule + 1, schedule_count * sizeof(ScheduledInput));
+
+    if(next.stall_ms) {
+        /* The app thread is busy; the input thread keeps running meanwhile */
+        clock_us += (uint64_t)next.stall_ms * 1000;
+        host_counters.stalls++;
+        return;
+    }
+
+    host_counters.input_events++;
+    if(gui.view_port && gui.view_port->input_callback) {
+        gui.view_port->input_callback(&next.event, gui.view_port->input_context);
+    }
+}
+
+/** Deliver everything that came due while the app thread was not waiting */
+static void deliver_due(void) {
+    while(schedule_count > 0 && schedule[0].at_us <= clock_us) deliver_next();
+}
+
+/* ============================================================================
+ * MESSAGE QUEUE
+ * ============================================================================ */
+
+struct FuriMessageQueue {
+    uint8_t* storage;
+    uint32_t msg_size;
+    uint32_t capacity;
+    uint32_t head;
+    uint32_t count;
+};
+
+static HostIdleHook idle_hook;
+static void* idle_hook_context;
+
+void host_set_idle_hook(HostIdleHook hook, void* context) {
+    idle_hook = hook;
+    idle_hook_context = context;
+}
+
+FuriMessageQueue* furi_message_queue_alloc(uint32_t msg_count, uint32_t msg_size) {
+    FuriMessageQueue* queue = host_malloc(sizeof(FuriMessageQueue));
+    queue->storage = host_malloc((size_t)msg_count * msg_size);
+    queue->msg_size = msg_size;
+    queue->capacity = msg_count;
+    queue->head = 0;
+    queue->count = 0;
+    return queue;
+}
+
+void furi_message_queue_free(FuriMessageQueue* queue) {
+    host_free(queue->storage);
+    host_free(queue);
+}
+
+uint32_t furi_message_queue_get_count(FuriMessageQueue* queue) {
+    return queue->count;
+}
+
+uint32_t furi_message_queue_get_space(FuriMessageQueue* queue) {
+    return queue->capacity - queue->count;
+}
+
+FuriStatus furi_message_queue_put(FuriMessageQueue* queue, const void* msg, uint32_t timeout) {
+    if(queue->count == queue->capacity) {
+        /* Nobody else can drain the queue in a single-threaded model: on the
+         * device this is the input thread stalling until the app catches up */
+        furi_check(timeout != FuriWaitForever);
+        host_counters.queue_put_failures++;
+        return timeout ? FuriStatusErrorTimeout : FuriStatusErrorResource;
+    }
+    uint32_t tail = (queue->head + queue->count) % queue->capacity;
+    memcpy(queue->storage + (size_t)tail * queue->msg_size, msg, queue->msg_size);
+    queue->count++;
+    if(queue->count > host_counters.queue_peak_depth) host_counters.queue_peak_depth = queue->count;
+    return FuriStatusOk;
+}
+
+static void queue_pop(FuriMessageQueue* queue, void* msg) {
+    memcpy(msg, queue->storage + (size_t)queue->head * queue->msg_size, queue->msg_size);
+    queue->head = (queue->head + 1) % queue->capacity;
+    queue->count--;
+}
+
+FuriStatus furi_message_queue_get(FuriMessageQueue* queue, void* msg, uint32_t timeout) {
+    deliver_due();
+    if(queue->count > 0) {
+        queue_pop(queue, msg);
+        return FuriStatusOk;
+    }
+    if(timeout == 0) return FuriStatusErrorTimeout;
+
+    /* The app thread blocks here: the GUI thread gets to draw */
+    host_counters.queue_waits++;
+    render_if_dirty();
+    if(idle_hook) idle_hook(idle_hook_context);
+
+    bool forever = (timeout == FuriWaitForever);
+    uint64_t deadline = clock_us + (uint64_t)timeout * 1000;
+
+    while(schedule_count > 0 && (forever || schedule[0].at_us <= deadline)) {
+        if(schedule[0].at_us > clock_us) clock_us = schedule[0].at_us;
+        deliver_next();
+        deliver_due();
+        if(queue->count > 0) {
+            queue_pop(queue, msg);
+            return FuriStatusOk;
+        }
+    }
+
+    /* Waiting forever with nothing scheduled would hang the harness */
+    furi_check(!forever);
+    if(clock_us < deadline) clock_us = deadline;
+    return FuriStatusErrorTimeout;
+}
+
+/* ============================================================================
+ * RECORDS AND NOTIFICATIONS
+ * ============================================================================
+ * The notification record mirrors the firmware NotificationApp layout that
+ * the apps reach into for display_brightness.
+ */
+
+typedef struct {
+    uint8_t value_last[2];
+    uint8_t value[2];
+    uint8_t index;
+    uint8_t light;
+} HostLedLayer;
+
+typedef struct {
+    uint8_t version;
+    float display_brightness;
+    float led_brightness;
+    float speaker_volume;
+    uint32_t display_off_delay_ms;
+    int8_t contrast;
+    bool vibro_on;
+} HostNotificationSettings;
+
+typedef struct {
+    void* queue;
+    void* event_record;
+    void* display_timer;
+    HostLedLayer display;
+    HostLedLayer led[3];
+    uint8_t display_led_lock;
+    HostNotificationSettings settings;
+} HostNotificationApp;
+
+struct Storage {
+    int unused;
+};
+
+static HostNotificationApp notification_app = {
+    .settings = {.display_brightness = 1.0f, .led_brightness = 1.0f},
+};
+static Storage storage_record;
+
+void* furi_record_open(const char* name) {
+    if(strcmp(name, RECORD_GUI) == 0) return &gui;
+    if(strcmp(name, RECORD_NOTIFICATION) == 0) return &notification_app;
+    if(strcmp(name, RECORD_STORAGE) == 0) return &storage_record;
+    return NULL;
+}
+
+void furi_record_close(const char* name) {
+    UNUSED(name);
+}
+
+static const NotificationMessage message_backlight = {"backlight"};
+
+const NotificationSequence sequence_display_backlight_on = {&message_backlight, NULL};
+const NotificationSequence sequence_display_backlight_off = {&message_backlight, NULL};
+const NotificationSequence sequence_display_backlight_enforce_on = {&message_backlight, NULL};
+const NotificationSequence sequence_display_backlight_enforce_auto = {&message_backlight, NULL};
+static const NotificationMessage message_alert = {"alert"};
+const NotificationSequence sequence_audiovisual_alert = {&message_alert, NULL};
+
+void notification_message(NotificationApp* app, const NotificationSequence* sequence) {
+    UNUSED(app);
+    UNUSED(sequence);
+    host_counters.notifications++;
+    host_io_mark();
+}
+
+/* ============================================================================
+ * HAL: POWER, SUBGHZ, ADC, RANDOM
+ * ============================================================================ */
+
+static float battery_voltage = 4.0f;
+static float battery_current_ma = -20.0f;
+static uint8_t battery_percent = 100;
+static uint32_t battery_remaining_mah = 2100;
+static float die_temperature = 30.0f;
+
+static HostRssiSource rssi_source;
+static void* rssi_source_context;
+static uint32_t subghz_frequency;
+
+void host_set_battery(float voltage, float current_ma) {
+    battery_voltage = voltage;
+    battery_current_ma = current_ma;
+}
+
+void host_set_battery_charge(uint8_t percent, uint32_t remaining_mah) {
+    battery_percent = percent;
+    battery_remaining_mah = remaining_mah;
+}
+
+void host_set_temperature(float celsius) {
+    die_temperature = celsius;
+}
+
+void host_set_rssi_source(HostRssiSource source, void* context) {
+    rssi_source = source;
+    rssi_source_context = context;
+}
+
+float furi_hal_power_get_battery_voltage(FuriHalPowerIC ic) {
+    UNUSED(ic);
+    return battery_voltage;
+}
+
+float furi_hal_power_get_battery_current(FuriHalPowerIC ic) {
+    UNUSED(ic);
+    return battery_current_ma;
+}
+
+uint8_t furi_hal_power_get_pct(void) {
+    return battery_percent;
+}
+
+uint32_t furi_hal_power_get_battery_remaining_capacity(void) {
+    return battery_remaining_mah;
+}
+
+void furi_hal_subghz_reset(void) {
+}
+
+void furi_hal_subghz_idle(void) {
+}
+
+void furi_hal_subghz_sleep(void) {
+}
+
+void furi_hal_subghz_rx(void) {
+    host_counters.radio_dwells++;
+    if(host_io_last_us != UINT64_MAX && host_clock_us() - host_io_last_us < HOST_IO_NEAR_US) {
+        host_counters.io_near_dwells++;
+    }
+}
+
+uint32_t furi_hal_subghz_set_frequency_and_path(uint32_t value) {
+    subghz_frequency = value;
+    return value;
+}
+
+float furi_hal_subghz_get_rssi(void) {
+    if(rssi_source) return rssi_source(subghz_frequency, rssi_source_context);
+    return -100.0f;
+}
+
+struct FuriHalAdcHandle {
+    int unused;
+};
+
+static FuriHalAdcHandle adc_handle;
+
+FuriHalAdcHandle* furi_hal_adc_acquire(void) {
+    return &adc_handle;
+}
+
+void furi_hal_adc_release(FuriHalAdcHandle* handle) {
+    UNUSED(handle);
+}
+
+void furi_hal_adc_configure_ex(
+    FuriHalAdcHandle* handle,
+    FuriHalAdcScale scale,
+    FuriHalAdcClock clock,
+    FuriHalAdcOversample oversample,
+    FuriHalAdcSamplingTime sampling_time) {
+    UNUSED(handle);
+    UNUSED(scale);
+    UNUSED(clock);
+    UNUSED(oversample);
+    UNUSED(sampling_time);
+}
+
+uint16_t furi_hal_adc_read(FuriHalAdcHandle* handle, FuriHalAdcChannel channel) {
+    UNUSED(handle);
+    UNUSED(channel);
+    return 0;
+}
+
+float furi_hal_adc_convert_temp(FuriHalAdcHandle* handle, uint16_t value) {
+    UNUSED(handle);
+    UNUSED(value);
+    return die_temperature;
+}
+
+static uint32_t random_state = 0x12345678;
+
+void furi_hal_random_fill_buf(uint8_t* buf, uint32_t len) {
+    for(uint32_t i = 0; i < len; i++) {
+        random_state ^= random_state << 13;
+        random_state ^= random_state >> 17;
+        random_state ^= random_state << 5;
+        buf[i] = (uint8_t)random_state;
+    }
+}
+
+HostDwt* host_dwt(void) {
+    static HostDwt dwt;
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    uint64_t ns = (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+    dwt.CYCCNT = (uint32_t)(ns * 64 / 1000);
+    return &dwt;
+}
+
+/* ============================================================================
+ * STORAGE
+ * ============================================================================ */
+
+struct File {
+    FILE* fp;
+};
+
+static void storage_host_path(const char* path, char* out, size_t out_size) {
+    const char* root = getenv("HOST_SD_ROOT");
+    if(root == NULL) root = "host_sd";
+    if(strncmp(path, "/ext", 4) == 0) path += 4;
+    snprintf(out, out_size, "%s%s", root, path);
+}
+
+static void mkdir_parents(char* path) {
+    for(char* p = path + 1; *p; p++) {
+        if(*p == '/') {
+            *p = '\0';
+            mkdir(path, 0755);
+            *p = '/';
+        }
+    }
+}
+
+File* storage_file_alloc(Storage* storage) {
+    UNUSED(storage);
+    File* file = host_malloc(sizeof(File));
+    file->fp = NULL;
+    return file;
+}
+
+void storage_file_free(File* file) {
+    if(file->fp) fclose(file->fp);
+    host_free(file);
+}
+
+bool storage_file_open(File* file, const char* path, FS_AccessMode access_mode, FS_OpenMode open_mode) {
+    char host_path[512];
+    storage_host_path(path, host_path, sizeof(host_path));
+
+    bool exists = access(host_path, F_OK) == 0;
+    bool writable = (access_mode & FSAM_WRITE) != 0;
+
+    switch(open_mode) {
+    case FSOM_OPEN_EXISTING:
+        if(!exists) return false;
+        file->fp = fopen(host_path, writable ? "r+b" : "rb");
+        break;
+    case FSOM_CREATE_NEW:
+        if(exists) return false;
+        file->fp = fopen(host_path, "w+b");
+        break;
+    case FSOM_CREATE_ALWAYS:
+        file->fp = fopen(host_path, "w+b");
+        break;
+    case FSOM_OPEN_ALWAYS:
+    case FSOM_OPEN_APPEND:
+    default:
+        if(!exists) {
+            FILE* created = fopen(host_path, "wb");
+            if(created) fclose(created);
+        }
+        file->fp = fopen(host_path, writable ? "r+b" : "rb");
+        if(file->fp && open_mode == FSOM_OPEN_APPEND) fseek(file->fp, 0, SEEK_END);
+        break;
+    }
+    return file->fp != NULL;
+}
+
+bool storage_file_close(File* file) {
+    if(file->fp == NULL) return false;
+    fclose(file->fp);
+    file->fp = NULL;
+    return true;
+}
+
+bool storage_file_is_open(File* file) {
+    return file->fp != NULL;
+}
+
+size_t storage_file_read(File* file, void* buff, size_t bytes_to_read) {
+    if(file->fp == NULL) return 0;
+    host_counters.storage_reads++;
+    host_counters.storage_read_bytes += bytes_to_read;
+    return fread(buff, 1, bytes_to_read, file->fp);
+}
+
+size_t storage_file_write(File* file, const void* buff, size_t bytes_to_write) {
+    if(file->fp == NULL) return 0;
+    host_counters.storage_writes++;
+    host_counters.storage_write_bytes += bytes_to_write;
+    host_io_mark();
+    return fwrite(buff, 1, bytes_to_write, file->fp);
+}
+
+bool storage_file_seek(File* file, uint32_t offset, bool from_start) {
+    if(file->fp == NULL) return false;
+    return fseek(file->fp, (long)offset, from_start ? SEEK_SET : SEEK_CUR) == 0;
+}
+
+uint64_t storage_file_tell(File* file) {
+    return file->fp ? (uint64_t)ftell(file->fp) : 0;
+}
+
+uint64_t storage_file_size(File* file) {
+    if(file->fp == NULL) return 0;
+    long pos = ftell(file->fp);
+    fseek(file->fp, 0, SEEK_END);
+    long size = ftell(file->fp);
+    fseek(file->fp, pos, SEEK_SET);
+    return (uint64_t)size;
+}
+
+bool storage_file_truncate(File* file) {
+    if(file->fp == NULL) return false;
+    fflush(file->fp);
+    return ftruncate(fileno(file->fp), ftell(file->fp)) == 0;
+}
+
+bool storage_file_sync(File* file) {
+    if(file->fp == NULL) return false;
+    host_counters.storage_syncs++;
+    clock_us += storage_sync_us;
+    host_io_mark();
+    return fflush(file->fp) == 0;
+}
+
+bool storage_file_eof(File* file) {
+    if(file->fp == NULL) return true;
+    return storage_file_tell(file) >= storage_file_size(file);
+}
+
+bool storage_file_exists(Storage* storage, const char* path) {
+    UNUSED(storage);
+    char host_path[512];
+    storage_host_path(path, host_path, sizeof(host_path));
+    return access(host_path, F_OK) == 0;
+}
+
+FS_Error storage_common_mkdir(Storage* storage, const char* path) {
+    UNUSED(storage);
+    char host_path[512];
+    storage_host_path(path, host_path, sizeof(host_path));
+    mkdir_parents(host_path);
+    if(mkdir(host_path, 0755) == 0) return FSE_OK;
+    return errno == EEXIST ? FSE_EXIST : FSE_INTERNAL;
+}
+
+FS_Error storage_common_remove(Storage* storage, const char* path) {
+    UNUSED(storage);
+    char host_path[512];
+    storage_host_path(path, host_path, sizeof(host_path));
+    return remove(host_path) == 0 ? FSE_OK : FSE_NOT_EXIST;
+}
+
+FS_Error storage_common_rename(Storage* storage, const char* old_path, const char* new_path) {
+    UNUSED(storage);
+    char host_old[512], host_new[512];
+    storage_host_path(old_path, host_old, sizeof(host_old));
+    storage_host_path(new_path, host_new, sizeof(host_new));
+    return rename(host_old, host_new) == 0 ? FSE_OK : FSE_INTERNAL;
+}
+
+/* ============================================================================
+ * FLIPPER FORMAT
+ * ============================================================================ */
+
+struct FuriString {
+    char* text;
+};
+
+FuriString* furi_string_alloc(void) {
+    FuriString* string = host_malloc(sizeof(FuriString));
+    string->text = NULL;
+    furi_string_set_str(string, "");
+    return string;
+}
+
+void furi_string_free(FuriString* string) {
+    host_free(string->text);
+    host_free(string);
+}
+
+void furi_string_set_str(FuriString* string, const char* text) {
+    size_t len = strlen(text);
+    char* copy = host_malloc(len + 1);
+    memcpy(copy, text, len + 1);
+    if(string->text) host_free(string->text);
+    string->text = copy;
+}
+
+const char* furi_string_get_cstr(const FuriString* string) {
+    return string->text;
+}
+
+bool furi_string_equal_str(const FuriString* string, const char* text) {
+    return strcmp(string->text, text) == 0;
+}
+
+/** Longest "Key: value value ..." line, enough for a 96-value float array */
+#define FLIPPER_FORMAT_LINE_MAX 4096
+
+struct FlipperFormat {
+    File* file;
+};
+
+FlipperFormat* flipper_format_file_alloc(Storage* storage) {
+    FlipperFormat* flipper_format = host_malloc(sizeof(FlipperFormat));
+    flipper_format->file = storage_file_alloc(storage);
+    return flipper_format;
+}
+
+void flipper_format_free(FlipperFormat* flipper_format) {
+    storage_file_free(flipper_format->file);
+    host_free(flipper_format);
+}
+
+bool flipper_format_file_open_existing(FlipperFormat* flipper_format, const char* path) {
+    return storage_file_open(flipper_format->file, path, FSAM_READ_WRITE, FSOM_OPEN_EXISTING);
+}
+
+bool flipper_format_file_open_always(FlipperFormat* flipper_format, const char* path) {
+    return storage_file_open(flipper_format->file, path, FSAM_READ_WRITE, FSOM_CREATE_ALWAYS);
+}
+
+bool flipper_format_file_close(FlipperFormat* flipper_format) {
+    return storage_file_close(flipper_format->file);
+}
+
+bool flipper_format_rewind(FlipperFormat* flipper_format) {
+    return storage_file_seek(flipper_format->file, 0, true);
+}
+
+/** Find "<key>: " from the current position; returns the value text or NULL */
+static const char* flipper_format_seek_key(FlipperFormat* flipper_format, const char* key, char* line, size_t size) {
+    FILE* fp = flipper_format->file->fp;
+    size_t key_len = strlen(key);
+    if(fp == NULL) return NULL;
+
+    while(fgets(line, (int)size, fp)) {
+        if(strncmp(line, key, key_len) == 0 && line[key_len] == ':') {
+            line[strcspn(line, "\r\n")] = '\0';
+            const char* value = line + key_len + 1;
+            while(*value == ' ') value++;
+            return value;
+        }
+    }
+    return NULL;
+}
+
+static bool flipper_format_write_line(FlipperFormat* flipper_format, const char* line) {
+    size_t len = strlen(line);
+    return storage_file_write(flipper_format->file, line, len) == len;
+}
+
+/* Like the firmware, counting leaves the read position where it was */
+bool flipper_format_get_value_count(FlipperFormat* flipper_format, const char* key, uint32_t* count) {
+    char line[FLIPPER_FORMAT_LINE_MAX];
+    FILE* fp = flipper_format->file->fp;
+    long pos = fp ? ftell(fp) : 0;
+    const char* value = flipper_format_seek_key(flipper_format, key, line, sizeof(line));
+    if(fp) fseek(fp, pos, SEEK_SET);
+    if(value == NULL) return false;
+
+    *count = 0;
+    while(*value) {
+        value += strspn(value, " ");
+        if(*value == '\0') break;
+        (*count)++;
+        value += strcspn(value, " ");
+    }
+    return true;
+}
+
+bool flipper_format_read_header(FlipperFormat* flipper_format, FuriString* filetype, uint32_t* version) {
+    char line[256];
+    const char* value = flipper_format_seek_key(flipper_format, "Filetype", line, sizeof(line));
+    if(value == NULL) return false;
+    furi_string_set_str(filetype, value);
+    return flipper_format_read_uint32(flipper_format, "Version", version, 1);
+}
+
+bool flipper_format_write_header_cstr(FlipperFormat* flipper_format, const char* filetype, uint32_t version) {
+    char line[256];
+    snprintf(line, sizeof(line), "Filetype: %s\n", filetype);
+    return flipper_format_write_line(flipper_format, line) &&
+           flipper_format_write_uint32(flipper_format, "Version", &version, 1);
+}
+
+bool flipper_format_read_uint32(FlipperFormat* flipper_format, const char* key, uint32_t* data, uint16_t data_size) {
+    char line[FLIPPER_FORMAT_LINE_MAX];
+    const char* value = flipper_format_seek_key(flipper_format, key, line, sizeof(line));
+    if(value == NULL) return false;
+
+    for(uint16_t i = 0; i < data_size; i++) {
+        char* end;
+        unsigned long parsed = strtoul(value, &end, 10);
+        if(end == value) return false;
+        data[i] = (uint32_t)parsed;
+        value = end;
+    }
+    return true;
+}
+
+bool flipper_format_write_uint32(FlipperFormat* flipper_format, const char* key, const uint32_t* data, uint16_t data_size) {
+    char line[FLIPPER_FORMAT_LINE_MAX];
+    int len = snprintf(line, sizeof(line), "%s:", key);
+    for(uint16_t i = 0; i < data_size && len < (int)sizeof(line); i++) {
+        len += snprintf(line + len, sizeof(line) - (size_t)len, " %lu", (unsigned long)data[i]);
+    }
+    if(len >= (int)sizeof(line) - 1) return false;
+    line[len++] = '\n';
+    line[len] = '\0';
+    return flipper_format_write_line(flipper_format, line);
+}
+
+bool flipper_format_read_float(FlipperFormat* flipper_format, const char* key, float* data, uint16_t data_size) {
+    char line[FLIPPER_FORMAT_LINE_MAX];
+    const char* value = flipper_format_seek_key(flipper_format, key, line, sizeof(line));
+    if(value == NULL) return false;
+
+    for(uint16_t i = 0; i < data_size; i++) {
+        char* end;
+        float parsed = strtof(value, &end);
+        if(end == value) return false;
+        data[i] = parsed;
+        value = end;
+    }
+    return true;
+}
+
+bool flipper_format_write_float(FlipperFormat* flipper_format, const char* key, const float* data, uint16_t data_size) {
+    char line[FLIPPER_FORMAT_LINE_MAX];
+    int len = snprintf(line, sizeof(line), "%s:", key);
+    for(uint16_t i = 0; i < data_size && len < (int)sizeof(line); i++) {
+        len += snprintf(line + len, sizeof(line) - (size_t)len, " %f", (double)data[i]);
+    }
+    if(len >= (int)sizeof(line) - 1) return false;
+    line[len++] = '\n';
+    line[len] = '\0';
+    return flipper_format_write_line(flipper_format, line);
+}
@@ -0,0 +1,115 @@
+/**
+ * @file host_stub.h
+ * @brief Harness-side control of the host Furi stub
+ *
+ * The stub runs an app's real entry point on a virtual clock. The app thread
+ * only ever "sleeps" inside furi_message_queue_get() and furi_delay_*(), so
+ * the clock jumps straight to the next timeout or scheduled input event and
+ * months of runtime pass in seconds.
+ *
+ * Frames are drawn the way the GUI thread would draw them: view_port_update()
+ * only marks the view port dirty, and the pending frame is rendered the next
+ * time the app thread blocks.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <furi.h>
+#include <furi_hal.h>
+#include <gui/gui.h>
+#include <input/input.h>
+
+#define HOST_SCREEN_WIDTH  128
+#define HOST_SCREEN_HEIGHT 64
+
+/** Counters accumulated by the stub, reset with host_counters_reset() */
+typedef struct {
+    uint64_t malloc_calls;
+    uint64_t free_calls;
+    int64_t heap_live_bytes;
+    int64_t heap_peak_bytes;
+
+    uint64_t view_port_updates;  /**< view_port_update() calls */
+    uint64_t frames;             /**< Draw callback invocations */
+    uint64_t draw_primitives;    /**< Canvas calls other than clear/set_* */
+    uint64_t draw_pixels;        /**< Pixels touched by those primitives */
+
+    uint64_t notifications;      /**< notification_message() calls */
+    uint64_t queue_waits;        /**< Blocking furi_message_queue_get() calls */
+    uint64_t input_events;       /**< Events delivered to the input callback */
+    uint64_t queue_put_failures; /**< furi_message_queue_put() into a full queue */
+    uint64_t queue_peak_depth;   /**< Most messages ever waiting in one queue */
+    uint64_t stalls;             /**< Scheduled app-thread stalls (host_stall_schedule) */
+
+    uint64_t radio_dwells;       /**< furi_hal_subghz_rx() calls */
+    uint64_t storage_reads;
+    uint64_t storage_read_bytes;
+    uint64_t storage_writes;
+    uint64_t storage_write_bytes;
+    uint64_t storage_syncs;
+    uint64_t io_near_dwells;     /**< Dwells starting within HOST_IO_NEAR_US of SD or backlight I/O */
+} HostCounters;
+
+/** How long SD I/O or a backlight update may disturb a radio dwell after it */
+#define HOST_IO_NEAR_US 10000
+
+extern HostCounters host_counters;
+
+void host_counters_reset(void);
+
+/** Virtual clock in microseconds since boot (furi_get_tick() is this / 1000) */
+uint64_t host_clock_us(void);
+void host_clock_set_us(uint64_t us);
+
+/** Real monotonic time in microseconds, for timing a harness run */
+uint64_t host_wall_us(void);
+
+/** Wall-clock time the virtual RTC reports at virtual time zero */
+void host_rtc_set_epoch(uint32_t unix_seconds);
+
+/** RTC crystal error against the tick: positive runs the RTC fast */
+void host_rtc_set_drift_ppm(double ppm);
+
+/**
+ * Called every time the app thread blocks on its event queue, after any
+ * pending frame has been drawn and before time advances.
+ */
+typedef void (*HostIdleHook)(void* context);
+void host_set_idle_hook(HostIdleHook hook, void* context);
+
+/** Queue an input event for delivery at absolute virtual time at_us */
+bool host_input_schedule(uint64_t at_us, InputKey key, InputType type);
+
+/** Queue a Press/Short/Release triple starting at at_us */
+void host_input_schedule_tap(uint64_t at_us, InputKey key);
+
+/**
+ * Keep the app thread busy for ms milliseconds from at_us, as a long radio
+ * sweep or SD sync would. Input scheduled meanwhile piles up in the app's
+ * queue through its input callback and is drained once the stall ends.
+ */
+bool host_stall_schedule(uint64_t at_us, uint32_t ms);
+
+/** Context pointer the app registered with its draw callback */
+void* host_draw_context(void);
+
+/** Framebuffer of the last rendered frame, one byte per pixel (0/1) */
+const uint8_t* host_framebuffer(void);
+
+/** Render the app's view port now, regardless of the dirty flag */
+void host_render_now(void);
+
+/** Sensor models; defaults return fixed plausible values */
+typedef float (*HostRssiSource)(uint32_t frequency, void* context);
+void host_set_rssi_source(HostRssiSource source, void* context);
+void host_set_battery(float voltage, float current_ma);
+void host_set_battery_charge(uint8_t percent, uint32_t remaining_mah);
+void host_set_temperature(float celsius);
+
+/** Virtual time storage_file_sync() takes, as a card busy writing (default 0) */
+void host_set_storage_sync_us(uint32_t us);
+
+/** Bytes furi_thread_get_stack_space() reports (stack depth is not modeled) */
+void host_set_stack_space(uint32_t bytes);
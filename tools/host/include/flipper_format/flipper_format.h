@@ -0,0 +1,44 @@
+/**
+ * @file flipper_format.h
+ * @brief Host stub of the FlipperFormat key/value file API
+ *
+ * Files are the same "Key: value" text the firmware writes, stored through
+ * the storage stub, so a settings file saved on the host can be copied to
+ * the SD card and back. Reads search for the key from the current position
+ * as the firmware does; call flipper_format_rewind() to read out of order.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <furi.h>
+#include <storage/storage.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct FlipperFormat FlipperFormat;
+
+FlipperFormat* flipper_format_file_alloc(Storage* storage);
+void flipper_format_free(FlipperFormat* flipper_format);
+bool flipper_format_file_open_existing(FlipperFormat* flipper_format, const char* path);
+bool flipper_format_file_open_always(FlipperFormat* flipper_format, const char* path);
+bool flipper_format_file_close(FlipperFormat* flipper_format);
+bool flipper_format_rewind(FlipperFormat* flipper_format);
+
+bool flipper_format_get_value_count(FlipperFormat* flipper_format, const char* key, uint32_t* count);
+
+bool flipper_format_read_header(FlipperFormat* flipper_format, FuriString* filetype, uint32_t* version);
+bool flipper_format_write_header_cstr(FlipperFormat* flipper_format, const char* filetype, uint32_t version);
+
+bool flipper_format_read_uint32(FlipperFormat* flipper_format, const char* key, uint32_t* data, uint16_t data_size);
+bool flipper_format_write_uint32(FlipperFormat* flipper_format, const char* key, const uint32_t* data, uint16_t data_size);
+
+bool flipper_format_read_float(FlipperFormat* flipper_format, const char* key, float* data, uint16_t data_size);
+bool flipper_format_write_float(FlipperFormat* flipper_format, const char* key, const float* data, uint16_t data_size);
+
+#ifdef __cplusplus
+}
+#endif
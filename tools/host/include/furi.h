@@ -0,0 +1,115 @@
+/**
+ * @file furi.h
+ * @brief Host stub of the Furi core API
+ *
+ * Just enough of the Flipper Zero SDK surface for the apps in this repo to
+ * compile and run on a desktop machine. Time is virtual: furi_get_tick()
+ * and furi_delay_us() read and advance the harness clock in host_stub.c.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define UNUSED(x) (void)(x)
+
+#define FuriWaitForever 0xFFFFFFFFU
+
+typedef enum {
+    FuriStatusOk = 0,
+    FuriStatusError = -1,
+    FuriStatusErrorTimeout = -2,
+    FuriStatusErrorResource = -3,
+    FuriStatusErrorParameter = -4,
+} FuriStatus;
+
+/* Check / assert -------------------------------------------------------- */
+
+void host_check_failed(const char* expr, const char* file, int line);
+
+#define furi_check(x)                                              \
+    do {                                                           \
+        if(!(x)) host_check_failed(#x, __FILE__, __LINE__);        \
+    } while(0)
+#define furi_assert(x) furi_check(x)
+
+/* Tracked heap ---------------------------------------------------------- */
+
+void* host_malloc(size_t size);
+void* host_realloc(void* ptr, size_t size);
+void host_free(void* ptr);
+
+#define malloc(size)       host_malloc(size)
+#define realloc(ptr, size) host_realloc(ptr, size)
+#define free(ptr)          host_free(ptr)
+
+/* Kernel ---------------------------------------------------------------- */
+
+uint32_t furi_get_tick(void);
+uint32_t furi_kernel_get_tick_frequency(void);
+void furi_delay_us(uint32_t us);
+void furi_delay_ms(uint32_t ms);
+
+/* Memory manager and threads -------------------------------------------- */
+
+typedef void* FuriThreadId;
+
+size_t memmgr_get_free_heap(void);
+size_t memmgr_get_total_heap(void);
+size_t memmgr_get_minimum_free_heap(void);
+
+FuriThreadId furi_thread_get_current_id(void);
+uint32_t furi_thread_get_stack_space(FuriThreadId thread_id);
+
+/* Message queue --------------------------------------------------------- */
+
+typedef struct FuriMessageQueue FuriMessageQueue;
+
+FuriMessageQueue* furi_message_queue_alloc(uint32_t msg_count, uint32_t msg_size);
+void furi_message_queue_free(FuriMessageQueue* queue);
+FuriStatus furi_message_queue_put(FuriMessageQueue* queue, const void* msg, uint32_t timeout);
+FuriStatus furi_message_queue_get(FuriMessageQueue* queue, void* msg, uint32_t timeout);
+uint32_t furi_message_queue_get_count(FuriMessageQueue* queue);
+uint32_t furi_message_queue_get_space(FuriMessageQueue* queue);
+
+/* Records --------------------------------------------------------------- */
+
+void* furi_record_open(const char* name);
+void furi_record_close(const char* name);
+
+/* Strings (only what FlipperFormat headers need) ------------------------ */
+
+typedef struct FuriString FuriString;
+
+FuriString* furi_string_alloc(void);
+void furi_string_free(FuriString* string);
+void furi_string_set_str(FuriString* string, const char* text);
+const char* furi_string_get_cstr(const FuriString* string);
+bool furi_string_equal_str(const FuriString* string, const char* text);
+
+/* Opaque handles referenced by firmware-internal structs ---------------- */
+
+typedef struct FuriPubSub FuriPubSub;
+typedef struct FuriTimer FuriTimer;
+
+/* Logging --------------------------------------------------------------- */
+
+#define FURI_LOG_E(tag, ...) ((void)(tag))
+#define FURI_LOG_W(tag, ...) ((void)(tag))
+#define FURI_LOG_I(tag, ...) ((void)(tag))
+#define FURI_LOG_D(tag, ...) ((void)(tag))
+
+#ifdef __cplusplus
+}
+#endif
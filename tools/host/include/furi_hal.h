@@ -0,0 +1,92 @@
+/**
+ * @file furi_hal.h
+ * @brief Host stub of the Furi HAL (RTC, power, SubGHz, ADC, random, cycle counter)
+ *
+ * Hardware readings are routed to callbacks installed by the harness, see
+ * host_stub.h. The RTC follows the virtual clock.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <furi.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* RTC ------------------------------------------------------------------- */
+
+typedef struct {
+    uint8_t hour;
+    uint8_t minute;
+    uint8_t second;
+    uint8_t day;
+    uint8_t month;
+    uint16_t year;
+    uint8_t weekday;
+} DateTime;
+
+void furi_hal_rtc_get_datetime(DateTime* datetime);
+uint32_t furi_hal_rtc_get_timestamp(void);
+
+/* Power ----------------------------------------------------------------- */
+
+typedef enum {
+    FuriHalPowerICCharger,
+    FuriHalPowerICFuelGauge,
+} FuriHalPowerIC;
+
+float furi_hal_power_get_battery_voltage(FuriHalPowerIC ic);
+float furi_hal_power_get_battery_current(FuriHalPowerIC ic);
+uint8_t furi_hal_power_get_pct(void);
+uint32_t furi_hal_power_get_battery_remaining_capacity(void);
+
+/* SubGHz ---------------------------------------------------------------- */
+
+void furi_hal_subghz_reset(void);
+void furi_hal_subghz_idle(void);
+void furi_hal_subghz_rx(void);
+void furi_hal_subghz_sleep(void);
+uint32_t furi_hal_subghz_set_frequency_and_path(uint32_t value);
+float furi_hal_subghz_get_rssi(void);
+
+/* ADC ------------------------------------------------------------------- */
+
+typedef struct FuriHalAdcHandle FuriHalAdcHandle;
+
+typedef enum { FuriHalAdcScale2048, FuriHalAdcScale2500 } FuriHalAdcScale;
+typedef enum { FuriHalAdcClockSync16, FuriHalAdcClockSync32, FuriHalAdcClockSync64 } FuriHalAdcClock;
+typedef enum { FuriHalAdcOversampleNone, FuriHalAdcOversample64 } FuriHalAdcOversample;
+typedef enum { FuriHalAdcSamplingtime2_5, FuriHalAdcSamplingtime247_5 } FuriHalAdcSamplingTime;
+typedef enum { FuriHalAdcChannelTEMPSENSOR, FuriHalAdcChannelVREFINT } FuriHalAdcChannel;
+
+FuriHalAdcHandle* furi_hal_adc_acquire(void);
+void furi_hal_adc_release(FuriHalAdcHandle* handle);
+void furi_hal_adc_configure_ex(
+    FuriHalAdcHandle* handle,
+    FuriHalAdcScale scale,
+    FuriHalAdcClock clock,
+    FuriHalAdcOversample oversample,
+    FuriHalAdcSamplingTime sampling_time);
+uint16_t furi_hal_adc_read(FuriHalAdcHandle* handle, FuriHalAdcChannel channel);
+float furi_hal_adc_convert_temp(FuriHalAdcHandle* handle, uint16_t value);
+
+/* Random ---------------------------------------------------------------- */
+
+void furi_hal_random_fill_buf(uint8_t* buf, uint32_t len);
+
+/* Cycle counter --------------------------------------------------------- */
+
+/** DWT->CYCCNT counts host wall time at the Flipper's 64 MHz */
+typedef struct {
+    uint32_t CYCCNT;
+} HostDwt;
+
+HostDwt* host_dwt(void);
+#define DWT (host_dwt())
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,3 @@
+#pragma once
+/* Host stub: everything lives in furi_hal.h */
+#include <furi_hal.h>
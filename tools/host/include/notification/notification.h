@@ -0,0 +1,34 @@
+/**
+ * @file notification.h
+ * @brief Host stub of the notification service
+ *
+ * furi_record_open(RECORD_NOTIFICATION) returns a block laid out like the
+ * firmware's NotificationApp, so the apps' NotificationAppInternal cast keeps
+ * working. Messages are counted, not played.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <furi.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define RECORD_NOTIFICATION "notification"
+
+typedef struct NotificationApp NotificationApp;
+
+typedef struct {
+    const char* name;
+} NotificationMessage;
+
+typedef const NotificationMessage* NotificationSequence[];
+
+void notification_message(NotificationApp* app, const NotificationSequence* sequence);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,24 @@
+/**
+ * @file notification_messages.h
+ * @brief Host stub of the predefined notification sequences
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <notification/notification.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern const NotificationSequence sequence_display_backlight_on;
+extern const NotificationSequence sequence_display_backlight_off;
+extern const NotificationSequence sequence_display_backlight_enforce_on;
+extern const NotificationSequence sequence_display_backlight_enforce_auto;
+extern const NotificationSequence sequence_audiovisual_alert;
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,188 @@
+/**
+ * @file replay.c
+ * @brief Scripted input replay benchmark
+ *
+ * Plays an input session script against an app's real entry point on the
+ * virtual clock and reports what the session cost: frames, draw calls,
+ * pixels touched, notification messages and SD writes. Sessions are
+ * deterministic, so the numbers are directly comparable between builds.
+ *
+ * Built once per app (see `just replay`):
+ *   -DAPP_SOURCE='"../../apps/<app>/<app>.c"' -DAPP_ENTRY=<entry_point>
+ *
+ * Session script format, one event per line ('#' starts a comment):
+ *
+ *   +<delay_ms> <key> <type> [xN]
+ *
+ *   key:  up | down | left | right | ok | back
+ *   type: press | release | short | long | repeat | tap
+ *
+ * `tap` expands to press/short/release 80 ms apart. `xN` repeats the line N
+ * times, each after the same delay. Delays are relative to the previous
+ * event. The recorder in each app (DEBUG_INPUT_RECORD) writes this format.
+ *
+ *   +<delay_ms> stall <ms>
+ *
+ * keeps the app thread busy for <ms>, as a long radio sweep or SD sync
+ * would; input scheduled meanwhile piles up in the app's queue.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "host_stub.h"
+
+#include <storage/storage.h>
+
+#include APP_SOURCE
+
+#define SESSION_START_US  (1000ULL * 1000ULL)
+#define SESSION_SETTLE_US (2000ULL * 1000ULL)
+
+static const char* const key_names[] = {"up", "down", "right", "left", "ok", "back"};
+static const char* const type_names[] = {"press", "release", "short", "long", "repeat"};
+
+static int lookup(const char* word, const char* const* names, int count) {
+    for(int i = 0; i < count; i++) {
+        if(strcmp(word, names[i]) == 0) return i;
+    }
+    return -1;
+}
+
+/**
+ * @brief Schedule every event in a session script
+ * @return Virtual time of the last event, or 0 on a parse error
+ */
+static uint64_t session_load(const char* path, uint64_t start_us) {
+    FILE* fp = fopen(path, "r");
+    if(fp == NULL) {
+        fprintf(stderr, "cannot open session %s\n", path);
+        return 0;
+    }
+
+    char line[128];
+    int line_no = 0;
+    uint64_t at_us = start_us;
+
+    while(fgets(line, sizeof(line), fp)) {
+        line_no++;
+        char* comment = strchr(line, '#');
+        if(comment) *comment = '\0';
+
+        unsigned long delay_ms;
+        char key_word[16], type_word[16], repeat_word[16] = "";
+        int fields = sscanf(line, " +%lu %15s %15s %15s", &delay_ms, key_word, type_word, repeat_word);
+        if(fields <= 0) continue;
+
+        if(fields == 3 && strcmp(key_word, "stall") == 0) {
+            unsigned long stall_ms;
+            if(sscanf(type_word, "%lu", &stall_ms) != 1 || stall_ms == 0) {
+                fprintf(stderr, "%s:%d: cannot parse '%s'\n", path, line_no, line);
+                fclose(fp);
+                return 0;
+            }
+            at_us += (uint64_t)delay_ms * 1000;
+            host_stall_schedule(at_us, (uint32_t)stall_ms);
+            continue;
+        }
+
+        int key = lookup(key_word, key_names, InputKeyMAX);
+        bool tap = strcmp(type_word, "tap") == 0;
+        int type = tap ? 0 : lookup(type_word, type_names, InputTypeMAX);
+        unsigned long count = 1;
+        if(fields == 4 && sscanf(repeat_word, "x%lu", &count) != 1) count = 0;
+
+        if(fields < 3 || key < 0 || type < 0 || count == 0) {
+            fprintf(stderr, "%s:%d: cannot parse '%s'\n", path, line_no, line);
+            fclose(fp);
+            return 0;
+        }
+
+        for(unsigned long i = 0; i < count; i++) {
+            at_us += (uint64_t)delay_ms * 1000;
+            if(tap) {
+                host_input_schedule_tap(at_us, (InputKey)key);
+            } else {
+                host_input_schedule(at_us, (InputKey)key, (InputType)type);
+            }
+        }
+    }
+
+    fclose(fp);
+    return at_us;
+}
+
+int main(int argc, char** argv) {
+    bool json = false;
+    const char* session = NULL;
+
+    for(int i = 1; i < argc; i++) {
+        if(strcmp(argv[i], "--json") == 0) {
+            json = true;
+        } else if(session == NULL) {
+            session = argv[i];
+        } else {
+            session = NULL;
+            break;
+        }
+    }
+    if(session == NULL) {
+        fprintf(stderr, "usage: %s [--json] <session.txt>\n", argv[0]);
+        return 2;
+    }
+
+    host_clock_set_us(SESSION_START_US);
+    uint64_t last_us = session_load(session, SESSION_START_US);
+    if(last_us == 0) return 2;
+
+    /* Let the app settle, then make sure it exits even if the script left it on a sub-screen */
+    for(int i = 0; i < 4; i++) {
+        host_input_schedule_tap(last_us + SESSION_SETTLE_US * (i + 1), InputKeyBack);
+    }
+
+    /* Start from default settings, not whatever an earlier run saved */
+#ifdef SETTINGS_PATH
+    storage_common_remove(NULL, SETTINGS_PATH);
+#endif
+#ifdef PROFILE_PATH
+    storage_common_remove(NULL, PROFILE_PATH);
+    storage_common_remove(NULL, PROFILE_TMP_PATH);
+#endif
+
+    uint64_t wall_start_us = host_wall_us();
+    APP_ENTRY(NULL);
+    double wall_ms = (double)(host_wall_us() - wall_start_us) / 1e3;
+
+    double seconds = (double)(host_clock_us() - SESSION_START_US) / 1e6;
+    const HostCounters* c = &host_counters;
+
+    if(json) {
+        printf("{\"session\": \"%s\", \"duration_s\": %.3f, \"input_events\": %lu, "
+               "\"view_port_updates\": %lu, \"frames\": %lu, \"draw_primitives\": %lu, "
+               "\"draw_pixels\": %lu, \"notifications\": %lu, \"queue_put_failures\": %lu, "
+               "\"queue_peak_depth\": %lu, \"heap_peak_bytes\": %ld, \"storage_writes\": %lu, "
+               "\"wall_ms\": %.3f}\n",
+            session, seconds, (unsigned long)c->input_events, (unsigned long)c->view_port_updates,
+            (unsigned long)c->frames, (unsigned long)c->draw_primitives,
+            (unsigned long)c->draw_pixels, (unsigned long)c->notifications,
+            (unsigned long)c->queue_put_failures, (unsigned long)c->queue_peak_depth,
+            (long)c->heap_peak_bytes, (unsigned long)c->storage_writes, wall_ms);
+    } else {
+        printf("Session:            %s\n", session);
+        printf("Virtual duration:   %.1f s\n", seconds);
+        printf("Input events:       %lu\n", (unsigned long)c->input_events);
+        printf("view_port_update(): %lu\n", (unsigned long)c->view_port_updates);
+        printf("Frames drawn:       %lu\n", (unsigned long)c->frames);
+        printf("Draw calls:         %lu (%.1f per frame)\n", (unsigned long)c->draw_primitives,
+            c->frames ? (double)c->draw_primitives / (double)c->frames : 0.0);
+        printf("Pixels touched:     %lu (%.0f per frame)\n", (unsigned long)c->draw_pixels,
+            c->frames ? (double)c->draw_pixels / (double)c->frames : 0.0);
+        printf("Notifications:      %lu\n", (unsigned long)c->notifications);
+        printf("Queue put failures: %lu (peak depth %lu)\n",
+            (unsigned long)c->queue_put_failures, (unsigned long)c->queue_peak_depth);
+        printf("Heap peak:          %ld bytes\n", (long)c->heap_peak_bytes);
+        printf("SD writes:          %lu (%lu bytes)\n",
+            (unsigned long)c->storage_writes, (unsigned long)c->storage_write_bytes);
+        printf("Host run time:      %.1f ms\n", wall_ms);
+    }
+    return 0;
+}
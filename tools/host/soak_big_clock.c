@@ -0,0 +1,212 @@
+/**
+ * @file soak_big_clock.c
+ * @brief Accelerated-time soak test for Big Clock
+ *
+ * Runs the real big_clock_app() main loop on the virtual clock and reports:
+ *   - frames that show the brightness indicator outside its startup window,
+ *     which is what a tick-wrap bug in the brightness_show_until check does
+ *   - redraw and backlight reapply cadence
+ *   - heap activity once the main loop is running
+ *   - alarms: every one fires at its rollover, within a second, and the
+ *     main loop still wakes at most once per minute, as with none set
+ *
+ * Exit status is non-zero if any check fails. With --json the report goes
+ * to stderr and stdout gets a one-line summary for tools/host/bench.py.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "host_stub.h"
+
+#include "../../apps/big-clock/big_clock.c"
+
+#define DAY_US (86400ULL * 1000000ULL)
+
+/** Top-left pixel of the brightness bar outline; the digits never reach it */
+#define INDICATOR_PROBE_X 14
+#define INDICATOR_PROBE_Y 56
+
+/** Alarms written to ALARMS_PATH, as HHMM: two overlap while ringing, one is just before midnight */
+static const uint32_t soak_alarms[] = {630, 700, 703, 2359};
+#define SOAK_ALARM_COUNT (sizeof(soak_alarms) / sizeof(soak_alarms[0]))
+
+/** RTC ahead of the tick, so the minute wakes fall mid-minute and an alarm has to move one */
+#define SOAK_RTC_OFFSET_S 30
+
+typedef struct {
+    double days;
+    double uptime_days;
+    bool json;
+    FILE* report;
+
+    uint64_t start_us;
+    bool loop_started;
+    uint64_t steady_malloc_calls;
+    int64_t steady_heap_bytes;
+
+    uint32_t last_tick;
+    uint32_t tick_wraps;
+
+    uint64_t indicator_frames;
+    uint64_t stray_indicator_frames;
+    uint64_t first_stray_us;
+
+    bool alarms;
+    uint64_t waits;
+    uint16_t last_minute;
+    uint64_t same_minute_wakes;  /**< Wakes that found the minute unchanged */
+    uint32_t alarms_fired;
+    uint32_t alarms_misplaced;   /**< Fired in a minute that is not theirs */
+    uint8_t max_fire_second;     /**< Latest RTC second an alarm was seen firing at */
+} Soak;
+
+static void soak_idle(void* context) {
+    Soak* soak = context;
+    const BigClockState* state = host_draw_context();
+    uint64_t now = host_clock_us();
+    uint16_t minute = (uint16_t)(state->hour * 60 + state->minute);
+    soak->waits++;
+
+    if(!soak->loop_started) {
+        soak->loop_started = true;
+        soak->steady_malloc_calls = host_counters.malloc_calls;
+        soak->steady_heap_bytes = host_counters.heap_live_bytes;
+        soak->last_tick = furi_get_tick();
+    } else if(minute == soak->last_minute) {
+        soak->same_minute_wakes++;
+    }
+    soak->last_minute = minute;
+
+    if(state->alarms_fired != soak->alarms_fired) {
+        soak->alarms_fired = state->alarms_fired;
+        if(state->alarm_ringing_at != minute) soak->alarms_misplaced++;
+        if(state->second > soak->max_fire_second) soak->max_fire_second = state->second;
+    }
+
+    uint32_t tick = furi_get_tick();
+    if(tick < soak->last_tick) {
+        soak->tick_wraps++;
+        fprintf(soak->report, "  tick wrap at %.2f days of runtime\n", (double)(now - soak->start_us) / DAY_US);
+    }
+    soak->last_tick = tick;
+
+    /* The frame drawn just before this wait is in the framebuffer */
+    const uint8_t* fb = host_framebuffer();
+    if(fb[INDICATOR_PROBE_Y * HOST_SCREEN_WIDTH + INDICATOR_PROBE_X]) {
+        soak->indicator_frames++;
+        /* Only the 2 s startup flash may show it; the soak presses no keys */
+        if(now - soak->start_us > 2000000ULL) {
+            if(soak->stray_indicator_frames == 0) soak->first_stray_us = now;
+            soak->stray_indicator_frames++;
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    Soak soak = {.days = 60.0, .uptime_days = 40.0, .alarms = true};
+
+    for(int i = 1; i < argc; i++) {
+        if(strcmp(argv[i], "--days") == 0 && i + 1 < argc) {
+            soak.days = atof(argv[++i]);
+        } else if(strcmp(argv[i], "--uptime-days") == 0 && i + 1 < argc) {
+            soak.uptime_days = atof(argv[++i]);
+        } else if(strcmp(argv[i], "--no-alarms") == 0) {
+            soak.alarms = false;
+        } else if(strcmp(argv[i], "--json") == 0) {
+            soak.json = true;
+        } else {
+            fprintf(stderr, "usage: %s [--days N] [--uptime-days N] [--no-alarms] [--json]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    soak.report = soak.json ? stderr : stdout;
+    soak.start_us = (uint64_t)(soak.uptime_days * DAY_US);
+    uint64_t run_us = (uint64_t)(soak.days * DAY_US);
+
+    host_clock_set_us(soak.start_us);
+    host_rtc_set_epoch(SOAK_RTC_OFFSET_S);
+    host_set_idle_hook(soak_idle, &soak);
+    host_input_schedule_tap(soak.start_us + run_us, InputKeyBack);
+
+    fprintf(soak.report, "Big Clock soak: %.1f days from %.1f days uptime\n", soak.days, soak.uptime_days);
+
+    /* Start from default settings, not whatever an earlier run saved */
+    storage_common_remove(NULL, SETTINGS_PATH);
+    storage_common_remove(NULL, ALARMS_PATH);
+    if(soak.alarms) {
+        FlipperFormat* file = flipper_format_file_alloc(NULL);
+        storage_common_mkdir(NULL, SETTINGS_DIR);
+        if(!flipper_format_file_open_always(file, ALARMS_PATH) ||
+           !flipper_format_write_header_cstr(file, ALARMS_FILETYPE, ALARMS_VERSION) ||
+           !flipper_format_write_uint32(file, "Alarms", soak_alarms, SOAK_ALARM_COUNT)) {
+            fprintf(stderr, "cannot write %s\n", ALARMS_PATH);
+            return 2;
+        }
+        flipper_format_free(file);
+    }
+
+    uint64_t wall_start_us = host_wall_us();
+    big_clock_app(NULL);
+    double wall_s = (double)(host_wall_us() - wall_start_us) / 1e6;
+
+    int failures = 0;
+    double minutes = soak.days * 1440.0;
+
+    fprintf(soak.report, "\nTiming\n");
+    fprintf(soak.report, "  tick wraps:           %lu\n", (unsigned long)soak.tick_wraps);
+    fprintf(soak.report, "  frames:               %lu (%.2f per minute)\n",
+        (unsigned long)host_counters.frames, (double)host_counters.frames / minutes);
+    fprintf(soak.report, "  backlight messages:   %lu (%.2f per minute)\n",
+        (unsigned long)host_counters.notifications, (double)host_counters.notifications / minutes);
+    fprintf(soak.report, "  indicator frames:     %lu (%lu outside the startup flash)\n",
+        (unsigned long)soak.indicator_frames, (unsigned long)soak.stray_indicator_frames);
+    if(soak.stray_indicator_frames) {
+        fprintf(soak.report, "  first stray frame at  %.2f days of runtime\n",
+            (double)(soak.first_stray_us - soak.start_us) / DAY_US);
+        failures++;
+    }
+
+    /* Every alarm minute after the one the app started in, up to the exit */
+    uint64_t run_minutes = run_us / 60000000ULL;
+    uint64_t start_minute = (soak.start_us / 1000000ULL + SOAK_RTC_OFFSET_S) / 60;
+    uint64_t end_minute = ((soak.start_us + run_us) / 1000000ULL + SOAK_RTC_OFFSET_S) / 60;
+    uint32_t expected = 0;
+    for(uint64_t m = start_minute + 1; soak.alarms && m <= end_minute; m++) {
+        uint32_t hhmm = (uint32_t)(m % MINUTES_PER_DAY / 60 * 100 + m % 60);
+        for(size_t i = 0; i < SOAK_ALARM_COUNT; i++) {
+            if(soak_alarms[i] == hhmm) expected++;
+        }
+    }
+    fprintf(soak.report, "\nAlarms\n");
+    fprintf(soak.report, "  fired:                %lu of %lu (%lu in the wrong minute, latest at :%02u)\n",
+        (unsigned long)soak.alarms_fired, (unsigned long)expected,
+        (unsigned long)soak.alarms_misplaced, soak.max_fire_second);
+    fprintf(soak.report, "  wakes:                %lu over %lu minutes (%lu without a new minute)\n",
+        (unsigned long)soak.waits, (unsigned long)run_minutes, (unsigned long)soak.same_minute_wakes);
+    if(soak.alarms_fired != expected || soak.alarms_misplaced || soak.max_fire_second > 1) failures++;
+    if(soak.same_minute_wakes || soak.waits > run_minutes + 1) failures++;
+
+    fprintf(soak.report, "\nMemory\n");
+    fprintf(soak.report, "  mallocs after start:  %lu\n",
+        (unsigned long)(host_counters.malloc_calls - soak.steady_malloc_calls));
+    fprintf(soak.report, "  heap at loop start:   %ld bytes (peak %ld)\n",
+        (long)soak.steady_heap_bytes, (long)host_counters.heap_peak_bytes);
+    fprintf(soak.report, "  heap after exit:      %ld bytes\n", (long)host_counters.heap_live_bytes);
+    if(host_counters.malloc_calls != soak.steady_malloc_calls) failures++;
+    if(host_counters.heap_live_bytes != 0) failures++;
+
+    fprintf(soak.report, "\n%s\n", failures ? "SOAK FAILED" : "SOAK PASSED");
+
+    if(soak.json) {
+        printf("{\"app\": \"big-clock\", \"days\": %.1f, \"wall_s\": %.4f, \"frames\": %lu, "
+               "\"frames_per_s\": %.1f, \"heap_peak_bytes\": %ld, \"mallocs_after_start\": %lu, "
+               "\"passed\": %s}\n",
+            soak.days, wall_s, (unsigned long)host_counters.frames,
+            wall_s > 0 ? (double)host_counters.frames / wall_s : 0.0,
+            (long)host_counters.heap_peak_bytes,
+            (unsigned long)(host_counters.malloc_calls - soak.steady_malloc_calls),
+            failures ? "false" : "true");
+    }
+    return failures ? 1 : 0;
+}
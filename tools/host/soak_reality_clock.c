@@ -0,0 +1,677 @@
+/**
+ * @file soak_reality_clock.c
+ * @brief Accelerated-time soak test for Reality Clock
+ *
+ * Runs the real reality_clock_app() main loop on the virtual clock for weeks
+ * of simulated time and reports:
+ *   - running-sum drift of the RollingBuffers against an exact recompute
+ *   - the time windows: running sums equal to a recompute from the bucket
+ *     ring, and exactly their duration covered once filled
+ *   - brightness reapply cadence across the 32-bit tick wrap (~49.7 days)
+ *   - total_samples growth: one step per sample, never a stall or a skip
+ *   - heap activity once the main loop is running: none at all, every
+ *     session buffer comes from the arena carved in state_alloc()
+ *   - the startup frequency survey: FREQ_BAND_* carry simulated ISM bursts,
+ *     so every path must move off them, within SURVEY_BUDGET_MS
+ *   - with --battery-mah, the battery governor: a battery drained by a
+ *     per-tier current must not run flat before --run-until
+ *   - a CALIBRATE halfway through: recalibrates in the background within
+ *     CALIBRATION_SAMPLES samples, without the status ever going back to
+ *     calibrating
+ *   - the paged windows: running sums equal to a recompute from a mirror of
+ *     every sample, and no more SD page reads than one per window per page,
+ *     all of them prefetched by the I/O job
+ *   - the screen registry: every entry consistent with its refresh policy,
+ *     and the on-timer policy redrawing at its rate across the tick wrap
+ *   - I/O scheduling: a radio dwell within HOST_IO_NEAR_US of an SD write or
+ *     backlight update must be in a sample the app tagged; with
+ *     --sd-sync-ms a sync takes that long, as on a busy card
+ *
+ * Exit status is non-zero if any check fails. With --json the report goes
+ * to stderr and stdout gets a one-line summary for tools/host/bench.py.
+ *
+ * Built with -DDEBUG_LOG_TO_SD it also writes sensor_log.blk under
+ * $HOST_SD_ROOT; --rtc-epoch and --rtc-drift-ppm then stand in for
+ * different devices when exercising the host log tools.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "host_stub.h"
+
+#include <math.h>
+
+#include "../../apps/reality-clock/reality_clock.c"
+
+#define DAY_US  (86400ULL * 1000000ULL)
+#define HOUR_US (3600ULL * 1000000ULL)
+
+/** Mean error of a buffer average (dB) above which drift is reported */
+#define DRIFT_LIMIT_DB 0.001
+
+/** Battery model: fixed draw plus the radio, which scales with the sample rate */
+#define BATTERY_BASE_MA   8.0
+#define BATTERY_RADIO_MA  22.0   /**< At SAMPLE_INTERVAL_NORMAL_MS */
+
+/** Rate of the ScreenRefreshOnTimer entry driven by screen_refresh_check() */
+#define TIMER_CHECK_HZ 4
+
+/** Simulated traffic on the default ISM channels: share of reads, and level above the floor */
+#define ISM_BUSY_PERCENT 10
+#define ISM_BURST_DB     20.0
+
+typedef struct {
+    double days;
+    double uptime_days;
+    bool continuous;
+    uint64_t seed;
+    bool json;
+    FILE* report;
+
+    uint64_t rng;
+    uint64_t start_us;
+    uint64_t next_drift_check_us;
+
+    bool loop_started;
+    uint64_t steady_malloc_calls;
+    uint64_t steady_free_calls;
+    int64_t steady_heap_bytes;
+    uint64_t loop_malloc_calls;  /**< Counters at the latest wait, before exit cleanup */
+    uint64_t loop_free_calls;
+    int64_t loop_heap_bytes;
+    size_t arena_size;
+    size_t arena_used;
+
+    uint32_t last_tick;
+    uint32_t tick_wraps;
+
+    uint64_t last_notifications;
+    uint64_t last_reapply_us;
+    uint64_t reapplies;
+    uint64_t early_reapplies;
+    uint64_t min_reapply_gap_us;
+
+    double max_sum_error[3];
+    uint64_t waits;
+    uint32_t total_samples;
+    uint64_t last_sample_us;
+    uint64_t sample_mismatches;
+
+    uint64_t window_checks;
+    uint64_t window_sum_errors;    /**< Running sums that differ from the ring */
+    uint64_t window_span_errors;   /**< Filled windows not covering their duration */
+
+    double battery_mah;      /**< Capacity; 0 leaves the stub's fixed battery */
+    double remaining_mah;
+    uint64_t battery_us;     /**< Virtual time the model last ran */
+    uint64_t empty_us;       /**< When the battery ran flat, 0 if never */
+    int run_until;           /**< Minutes after midnight, -1 for none */
+    uint8_t tier;            /**< Governor state at the latest wait */
+    uint8_t max_tier;
+    uint16_t tier_changes;
+    bool target_met;
+    uint8_t target_met_pct;
+    uint32_t last_interval_ms;
+
+    uint32_t band_freq[3];   /**< Survey result at loop start */
+    uint32_t survey_ms;
+    uint16_t survey_reads;
+
+    uint64_t recal_at_us;    /**< When to select CALIBRATE */
+    uint64_t recal_start_us; /**< 0 until it has been */
+    uint64_t recal_done_us;
+    uint64_t recal_blackouts;   /**< Waits after it with no status shown */
+
+    uint32_t io_deferred;    /**< I/O scheduler counters at the latest wait */
+    uint32_t io_delayed_reads;
+    uint32_t io_tagged_samples;
+    float io_dev_mean[2];
+
+    uint32_t long_mirrored;
+    uint64_t long_checks;
+    uint64_t long_sum_errors;    /**< Running sums that differ from the mirror */
+    LongWindows long_windows;    /**< Counters at the latest wait */
+
+#ifdef DEBUG_LOG_TO_SD
+    uint32_t anchor_polls;       /**< RTC anchor counters at the latest wait */
+    uint32_t anchor_full_polls;
+#endif
+
+    uint8_t settings_trips;      /**< settings.txt save/load round trips */
+    uint8_t settings_errors;     /**< Round trips that changed a value */
+
+    uint8_t registry_errors;     /**< Screens inconsistent with their refresh policy */
+    uint32_t timer_redraws;      /**< Over 10 s of a TIMER_CHECK_HZ screen */
+    uint32_t timer_gap_errors;   /**< Redraws not one period after the last */
+    uint32_t timer_late_redraws; /**< After the loop woke a second late */
+} Soak;
+
+static double gaussian(Soak* soak) {
+    /* Box-Muller on a xorshift64 stream, deterministic for a given seed */
+    double u[2];
+    for(int i = 0; i < 2; i++) {
+        soak->rng ^= soak->rng << 13;
+        soak->rng ^= soak->rng >> 7;
+        soak->rng ^= soak->rng << 17;
+        u[i] = ((soak->rng >> 11) + 1.0) / 9007199254740993.0;
+    }
+    return sqrt(-2.0 * log(u[0])) * cos(2.0 * M_PI * u[1]);
+}
+
+static float soak_rssi(uint32_t frequency, void* context) {
+    Soak* soak = context;
+    float base = REAL_BASE_433, var = REAL_VAR_433;
+    if(frequency < survey_path_range[1][0]) {
+        base = REAL_BASE_315;
+        var = REAL_VAR_315;
+    } else if(frequency > survey_path_range[1][1]) {
+        base = REAL_BASE_868;
+        var = REAL_VAR_868;
+    }
+
+    /* REAL_VAR_* are 2-sigma figures */
+    double rssi = base + gaussian(soak) * var / 2.0;
+
+    /* Everyone else's transmitters sit on the default channels */
+    if(frequency == FREQ_BAND_1 || frequency == FREQ_BAND_2 || frequency == FREQ_BAND_3) {
+        soak->rng ^= soak->rng << 13;
+        soak->rng ^= soak->rng >> 7;
+        soak->rng ^= soak->rng << 17;
+        if(soak->rng % 100 < ISM_BUSY_PERCENT) rssi += ISM_BURST_DB;
+    }
+
+    /* The CC1101 reports RSSI in 0.5 dB steps */
+    if(!soak->continuous) rssi = round(rssi * 2.0) / 2.0;
+    return (float)rssi;
+}
+
+static double buffer_sum_error(const RollingBuffer* buf) {
+    double exact = 0.0;
+    for(uint16_t i = 0; i < buf->count; i++) exact += buf->values[i];
+    return fabs((double)buf->sum - exact);
+}
+
+/** Running sums of window @p w against the ring, recomputed; 0 if equal */
+static int window_sum_error(const TimeWindows* tw, int w) {
+    const TimeWindowSum* sum = &tw->window[w];
+    uint16_t count = tw->closed < sum->buckets ? tw->closed : sum->buckets;
+    int64_t integral[3] = {0};
+    uint32_t ms = 0;
+    for(uint16_t i = 1; i <= count; i++) {
+        const TimeBucket* bucket = &tw->ring[(tw->head + TIMEWIN_BUCKETS - i) % TIMEWIN_BUCKETS];
+        for(int b = 0; b < 3; b++) integral[b] += bucket->integral[b];
+        ms += bucket->ms;
+    }
+    for(int b = 0; b < 3; b++) {
+        if(integral[b] != sum->integral[b]) return 1;
+    }
+    return ms != sum->ms;
+}
+
+/** Every sample as the paged windows store it; static so the heap checks only see the app */
+static int16_t long_mirror[LONGWIN_RING_SAMPLES * 3];
+
+/** Running sums of paged window @p w against the mirror, recomputed; 0 if equal */
+static int long_sum_error(const Soak* soak, const LongWindows* lw, int w) {
+    const LongWindowSum* sum = &lw->window[w];
+    uint32_t count = lw->head < sum->samples ? lw->head : sum->samples;
+    int64_t exact[3] = {0};
+    if(lw->head != soak->long_mirrored) return 1;
+    for(uint32_t i = 1; i <= count; i++) {
+        const int16_t* value = &long_mirror[(lw->head - i) % LONGWIN_RING_SAMPLES * 3];
+        for(int b = 0; b < 3; b++) exact[b] += value[b];
+    }
+    for(int b = 0; b < 3; b++) {
+        if(exact[b] != sum->sum[b]) return 1;
+    }
+    return 0;
+}
+
+/** Drain the battery by the current tier's draw since the last wait */
+static void battery_update(Soak* soak, const RealityClockState* state, uint64_t now) {
+    double interval = state->is_calibrated && !state->recalibrating ? gov_tiers[state->gov_tier].sample_interval_ms : SAMPLE_INTERVAL_CALIB_MS;
+    double current = BATTERY_BASE_MA + BATTERY_RADIO_MA * SAMPLE_INTERVAL_NORMAL_MS / interval;
+    soak->remaining_mah -= current * (double)(now - soak->battery_us) / 3.6e9;
+    soak->battery_us = now;
+    if(soak->remaining_mah <= 0.0) {
+        soak->remaining_mah = 0.0;
+        if(soak->empty_us == 0) soak->empty_us = now;
+    }
+    double charge = soak->remaining_mah / soak->battery_mah;
+    host_set_battery((float)(3.3 + 0.9 * charge), (float)-current);
+    host_set_battery_charge((uint8_t)ceil(charge * 100.0), (uint32_t)soak->remaining_mah);
+}
+
+static void soak_idle(void* context) {
+    Soak* soak = context;
+    RealityClockState* state = host_draw_context();
+    uint64_t now = host_clock_us();
+    soak->waits++;
+
+    if(!soak->loop_started) {
+        soak->loop_started = true;
+        soak->steady_malloc_calls = host_counters.malloc_calls;
+        soak->steady_free_calls = host_counters.free_calls;
+        soak->steady_heap_bytes = host_counters.heap_live_bytes;
+        soak->arena_size = state->arena.size;
+        soak->arena_used = state->arena.used;
+        soak->last_tick = furi_get_tick();
+        soak->last_notifications = host_counters.notifications;
+        soak->last_reapply_us = now;
+        soak->total_samples = state->total_samples;
+        soak->last_sample_us = now;
+        soak->long_mirrored = state->long_windows.head;
+        for(int i = 0; i < 3; i++) soak->band_freq[i] = state->band_freq[i];
+        soak->survey_ms = state->survey_ms;
+        soak->survey_reads = state->survey_reads;
+        soak->battery_us = now;
+        if(soak->run_until >= 0) {
+            /* As if loaded from settings.txt, so exit does not write it back */
+            state->run_until = state->saved_run_until = (uint16_t)soak->run_until;
+            governor_set_target(state);
+        }
+        return;
+    }
+
+    if(soak->battery_mah > 0.0) battery_update(soak, state, now);
+    soak->tier = state->gov_tier;
+    if(state->gov_tier > soak->max_tier) soak->max_tier = state->gov_tier;
+    soak->target_met = state->gov_target_met;
+    soak->target_met_pct = state->gov_target_met_pct;
+    soak->io_deferred = state->io_deferred;
+    soak->io_delayed_reads = state->io_delayed_reads;
+    soak->io_tagged_samples = state->io_tagged_samples;
+    soak->io_dev_mean[0] = state->io_dev_mean[0];
+    soak->io_dev_mean[1] = state->io_dev_mean[1];
+
+    soak->loop_malloc_calls = host_counters.malloc_calls;
+    soak->loop_free_calls = host_counters.free_calls;
+    soak->loop_heap_bytes = host_counters.heap_live_bytes;
+
+    /* At most one sample per wait, and never a full interval without one */
+    uint32_t delta = state->total_samples - soak->total_samples;
+    if(delta > 1) soak->sample_mismatches++;
+    /* The governor may have just shortened the interval the pending sample was scheduled with */
+    uint32_t interval = gov_tiers[state->gov_tier].sample_interval_ms;
+    if(soak->last_interval_ms > interval) interval = soak->last_interval_ms;
+    if(delta == 0 && now - soak->last_sample_us > (interval + 100) * 1000ULL) {
+        soak->sample_mismatches++;
+    }
+    if(delta == 1 && !state->long_windows.failed) {
+        int16_t* value = &long_mirror[soak->long_mirrored++ % LONGWIN_RING_SAMPLES * 3];
+        value[0] = longwin_quantize(state->lf_raw);
+        value[1] = longwin_quantize(state->hf_raw);
+        value[2] = longwin_quantize(state->uhf_raw);
+    }
+    soak->long_windows = state->long_windows;
+#ifdef DEBUG_LOG_TO_SD
+    soak->anchor_polls = state->anchor_polls;
+    soak->anchor_full_polls = state->anchor_full_polls;
+#endif
+    if(delta) {
+        soak->last_sample_us = now;
+        soak->last_interval_ms = gov_tiers[state->gov_tier].sample_interval_ms;
+    }
+    soak->total_samples = state->total_samples;
+
+    uint32_t tick = furi_get_tick();
+    if(tick < soak->last_tick) {
+        soak->tick_wraps++;
+        fprintf(soak->report, "  tick wrap at %.2f days of runtime\n", (double)(now - soak->start_us) / DAY_US);
+    }
+    soak->last_tick = tick;
+
+    /* Every notification after startup is a periodic brightness reapply,
+       or the governor applying a new tier's brightness cap */
+    if(host_counters.notifications != soak->last_notifications) {
+        uint64_t gap = now - soak->last_reapply_us;
+        if(state->gov_tier_changes == soak->tier_changes) {
+            soak->reapplies++;
+            if(gap < soak->min_reapply_gap_us || soak->min_reapply_gap_us == 0) {
+                soak->min_reapply_gap_us = gap;
+            }
+            if(gap < (uint64_t)(BRIGHTNESS_REFRESH_MS - SAMPLE_INTERVAL_NORMAL_MS) * 1000) {
+                soak->early_reapplies++;
+            }
+        }
+        soak->last_reapply_us = now;
+        soak->last_notifications = host_counters.notifications;
+    }
+    soak->tier_changes = state->gov_tier_changes;
+
+    /* Recalibrate halfway, as from the menu; the old baseline must keep serving */
+    if(!soak->recal_start_us && now >= soak->recal_at_us && state->is_calibrated) {
+        do_calibrate(state);
+        soak->recal_start_us = now;
+    }
+    if(soak->recal_start_us) {
+        if(!state->is_calibrated || state->status == DimStatusCalibrating) soak->recal_blackouts++;
+        if(!soak->recal_done_us && state->recalibrations) soak->recal_done_us = now;
+    }
+
+    if(now >= soak->next_drift_check_us && state->is_calibrated) {
+        const RollingBuffer* buffers[3] = {&state->lf_buffer, &state->hf_buffer, &state->uhf_buffer};
+        for(int i = 0; i < 3; i++) {
+            double error = buffer_sum_error(buffers[i]);
+            if(error > soak->max_sum_error[i]) soak->max_sum_error[i] = error;
+        }
+        for(int w = 0; w < TIMEWIN_COUNT; w++) {
+            float avg[3];
+            soak->window_checks++;
+            soak->window_sum_errors += window_sum_error(&state->windows, w);
+            /* Filled once the first (partial) bucket has slid out */
+            if(state->windows.closed > state->windows.window[w].buckets &&
+               timewin_average(&state->windows, w, furi_get_tick(), avg) != timewin_duration_ms[w]) {
+                soak->window_span_errors++;
+            }
+        }
+        for(int w = 0; w < LONGWIN_COUNT; w++) {
+            soak->long_checks++;
+            soak->long_sum_errors += long_sum_error(soak, &state->long_windows, w);
+        }
+        soak->next_drift_check_us = now + HOUR_US;
+    }
+}
+
+/**
+ * @brief Save custom settings, load them into fresh defaults, compare
+ *
+ * Once with Run Until off (the key is left out of the file) and once set.
+ */
+static void settings_round_trip(Soak* soak) {
+    static RealityClockState saved, loaded;
+    static const uint8_t tier_pct[GOV_TIER_COUNT] = {100, 70, 40, 20};
+    _Static_assert(GOV_TIER_COUNT == 4, "update tier_pct");
+    const uint16_t run_until[2] = {GOV_RUN_UNTIL_OFF, 23 * 60};
+
+    for(int trip = 0; trip < 2; trip++) {
+        memset(&saved, 0, sizeof(saved));
+        memset(&loaded, 0, sizeof(loaded));
+        saved.brightness = 40;
+        saved.saved_brightness = BRIGHTNESS_MAX;  /* Forces the write */
+        saved.run_until = run_until[trip];
+        memcpy(saved.gov_tier_pct, tier_pct, sizeof(tier_pct));
+        loaded.run_until = GOV_RUN_UNTIL_OFF;
+        for(int i = 0; i < GOV_TIER_COUNT; i++) loaded.gov_tier_pct[i] = gov_tiers[i].default_pct;
+
+        storage_common_remove(NULL, SETTINGS_PATH);
+        settings_save(&saved);
+        settings_load(&loaded);
+        soak->settings_trips++;
+        if(loaded.brightness != saved.brightness || loaded.run_until != saved.run_until ||
+           memcmp(loaded.gov_tier_pct, saved.gov_tier_pct, sizeof(tier_pct)) != 0) {
+            soak->settings_errors++;
+        }
+    }
+}
+
+/**
+ * @brief Check the screen registry and drive the on-timer refresh policy
+ *
+ * No screen redraws on a timer today, so a TIMER_CHECK_HZ entry is stepped
+ * through screen_timer_due() a millisecond at a time for 10 s across the
+ * tick wrap, then with the loop waking a second late.
+ */
+static void screen_refresh_check(Soak* soak) {
+    for(int i = 0; i < SCREEN_COUNT; i++) {
+        const ScreenDef* screen = &screens[i];
+        uint32_t next_redraw = 0;
+        if(screen->draw == NULL || screen->input == NULL ||
+           (screen->refresh == ScreenRefreshOnSample && screen->depends == 0) ||
+           (screen->refresh == ScreenRefreshOnTimer && screen->refresh_hz == 0) ||
+           (screen->refresh != ScreenRefreshOnTimer && screen_timer_due(screen, 1000, &next_redraw))) {
+            soak->registry_errors++;
+        }
+    }
+
+    const ScreenDef timed = {.refresh = ScreenRefreshOnTimer, .refresh_hz = TIMER_CHECK_HZ};
+    const uint32_t period = 1000 / TIMER_CHECK_HZ;
+    uint32_t now = UINT32_MAX - 4999;
+    uint32_t next_redraw = now;
+    uint32_t last = now - period;
+    for(int ms = 0; ms < 10000; ms++, now++) {
+        if(screen_timer_due(&timed, now, &next_redraw)) {
+            soak->timer_redraws++;
+            if(now - last != period) soak->timer_gap_errors++;
+            last = now;
+        }
+    }
+
+    /* A loop a second late draws once, not every frame it missed */
+    now = next_redraw + 1000;
+    for(uint32_t ms = 0; ms < period; ms++, now++) {
+        if(screen_timer_due(&timed, now, &next_redraw)) soak->timer_late_redraws++;
+    }
+}
+
+static void usage(const char* argv0) {
+    fprintf(stderr,
+        "usage: %s [--days N] [--uptime-days N] [--continuous] [--seed N]\n"
+        "          [--rtc-epoch S] [--rtc-drift-ppm P] [--battery-mah N [--run-until HH:MM]]\n"
+        "          [--sd-sync-ms N] [--json]\n"
+        "  --days N            simulated runtime (default 60)\n"
+        "  --uptime-days N     device uptime when the app starts (default 40)\n"
+        "  --continuous        unquantised RSSI instead of 0.5 dB steps\n"
+        "  --seed N            noise seed (default 1)\n"
+        "  --rtc-epoch S       RTC Unix time at virtual time zero\n"
+        "  --rtc-drift-ppm P   RTC error against the tick\n"
+        "  --battery-mah N     drain an N mAh battery by the governor tier's current\n"
+        "  --run-until HH:MM   runtime target; the battery must not run flat first\n"
+        "  --sd-sync-ms N      virtual time each SD sync takes (default 0)\n"
+        "  --json              report to stderr, JSON summary to stdout\n",
+        argv0);
+}
+
+int main(int argc, char** argv) {
+    Soak soak = {.days = 60.0, .uptime_days = 40.0, .seed = 1, .run_until = -1};
+
+    for(int i = 1; i < argc; i++) {
+        if(strcmp(argv[i], "--days") == 0 && i + 1 < argc) {
+            soak.days = atof(argv[++i]);
+        } else if(strcmp(argv[i], "--uptime-days") == 0 && i + 1 < argc) {
+            soak.uptime_days = atof(argv[++i]);
+        } else if(strcmp(argv[i], "--continuous") == 0) {
+            soak.continuous = true;
+        } else if(strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            soak.seed = strtoull(argv[++i], NULL, 0);
+        } else if(strcmp(argv[i], "--rtc-epoch") == 0 && i + 1 < argc) {
+            host_rtc_set_epoch((uint32_t)strtoul(argv[++i], NULL, 0));
+        } else if(strcmp(argv[i], "--rtc-drift-ppm") == 0 && i + 1 < argc) {
+            host_rtc_set_drift_ppm(atof(argv[++i]));
+        } else if(strcmp(argv[i], "--battery-mah") == 0 && i + 1 < argc) {
+            soak.battery_mah = soak.remaining_mah = atof(argv[++i]);
+        } else if(strcmp(argv[i], "--run-until") == 0 && i + 1 < argc) {
+            unsigned hour, minute;
+            if(sscanf(argv[++i], "%u:%u", &hour, &minute) != 2 || hour > 23 || minute > 59) {
+                usage(argv[0]);
+                return 2;
+            }
+            soak.run_until = (int)(hour * 60 + minute) / GOV_RUN_UNTIL_STEP * GOV_RUN_UNTIL_STEP;
+        } else if(strcmp(argv[i], "--sd-sync-ms") == 0 && i + 1 < argc) {
+            host_set_storage_sync_us((uint32_t)(atof(argv[++i]) * 1000.0));
+        } else if(strcmp(argv[i], "--json") == 0) {
+            soak.json = true;
+        } else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+
+    soak.report = soak.json ? stderr : stdout;
+    soak.rng = soak.seed * 0x9E3779B97F4A7C15ULL + 1;
+    soak.start_us = (uint64_t)(soak.uptime_days * DAY_US);
+    uint64_t run_us = (uint64_t)(soak.days * DAY_US);
+    soak.recal_at_us = soak.start_us + run_us / 2;
+
+    /* Before the clock moves, so its SD writes are days away from any radio read */
+    settings_round_trip(&soak);
+    screen_refresh_check(&soak);
+    host_clock_set_us(soak.start_us);
+    host_set_rssi_source(soak_rssi, &soak);
+    host_set_idle_hook(soak_idle, &soak);
+    host_input_schedule_tap(soak.start_us + run_us, InputKeyBack);
+
+    fprintf(soak.report, "Reality Clock soak: %.1f days from %.1f days uptime, %s RSSI\n",
+        soak.days, soak.uptime_days, soak.continuous ? "continuous" : "0.5 dB");
+
+    /* Start from default settings, not whatever an earlier run saved */
+    storage_common_remove(NULL, SETTINGS_PATH);
+    storage_common_remove(NULL, PROFILE_PATH);
+    storage_common_remove(NULL, PROFILE_TMP_PATH);
+
+    uint64_t wall_start_us = host_wall_us();
+    reality_clock_app(NULL);
+    double wall_s = (double)(host_wall_us() - wall_start_us) / 1e6;
+
+    int failures = 0;
+
+    fprintf(soak.report, "\nTiming\n");
+    fprintf(soak.report, "  tick wraps:           %lu\n", (unsigned long)soak.tick_wraps);
+    fprintf(soak.report, "  brightness reapplies: %lu (min gap %.1f s, %lu early)\n",
+        (unsigned long)soak.reapplies, (double)soak.min_reapply_gap_us / 1e6,
+        (unsigned long)soak.early_reapplies);
+    if(soak.early_reapplies) failures++;
+
+    double recal_limit_s = CALIBRATION_SAMPLES * (SAMPLE_INTERVAL_CALIB_MS + 100) / 1000.0;
+    fprintf(soak.report, "\nSettings\n");
+    fprintf(soak.report, "  save/load round trips: %u, %u changed a value\n",
+        (unsigned)soak.settings_trips, (unsigned)soak.settings_errors);
+    if(soak.settings_errors) failures++;
+
+    fprintf(soak.report, "\nScreen refresh\n");
+    fprintf(soak.report, "  registry:             %d screens, %u inconsistent\n",
+        SCREEN_COUNT, (unsigned)soak.registry_errors);
+    fprintf(soak.report, "  %d Hz timer:           %lu redraws in 10 s across the tick wrap, %lu off-period, "
+        "%lu after a 1 s late wake\n", TIMER_CHECK_HZ, (unsigned long)soak.timer_redraws,
+        (unsigned long)soak.timer_gap_errors, (unsigned long)soak.timer_late_redraws);
+    if(soak.registry_errors || soak.timer_gap_errors ||
+       soak.timer_redraws != 10 * TIMER_CHECK_HZ || soak.timer_late_redraws != 1) {
+        failures++;
+    }
+
+    fprintf(soak.report, "\nRecalibration\n");
+    if(soak.recal_done_us) {
+        fprintf(soak.report, "  in background:        done in %.1f s (limit %.1f), %lu waits without a status\n",
+            (double)(soak.recal_done_us - soak.recal_start_us) / 1e6, recal_limit_s,
+            (unsigned long)soak.recal_blackouts);
+        if((double)(soak.recal_done_us - soak.recal_start_us) / 1e6 > recal_limit_s) failures++;
+    } else {
+        fprintf(soak.report, "  in background:        %s\n", soak.recal_start_us ? "NEVER FINISHED" : "not reached");
+        if(soak.recal_start_us) failures++;
+    }
+    if(soak.recal_blackouts) failures++;
+
+    fprintf(soak.report, "\nFrequency survey\n");
+    fprintf(soak.report, "  chosen:               %.1f / %.1f / %.1f MHz\n",
+        soak.band_freq[0] / 1e6, soak.band_freq[1] / 1e6, soak.band_freq[2] / 1e6);
+    fprintf(soak.report, "  cost:                 %u reads in %lu ms (budget %d)\n",
+        soak.survey_reads, (unsigned long)soak.survey_ms, SURVEY_BUDGET_MS);
+    for(int i = 0; i < 3; i++) {
+        if(soak.band_freq[i] == survey_default_freq[i]) failures++;
+    }
+    if(soak.survey_ms > SURVEY_BUDGET_MS) failures++;
+
+    /* A near read puts all three bands' dwells in one tagged sample */
+    fprintf(soak.report, "\nI/O scheduling\n");
+    fprintf(soak.report, "  jobs waiting for a gap: %lu (%lu reads pushed back)\n",
+        (unsigned long)soak.io_deferred, (unsigned long)soak.io_delayed_reads);
+    fprintf(soak.report, "  dwells near I/O:      %lu, in %lu tagged samples\n",
+        (unsigned long)host_counters.io_near_dwells, (unsigned long)soak.io_tagged_samples);
+    if(soak.io_tagged_samples) {
+        fprintf(soak.report, "  spread:               %.2f dB tagged, %.2f dB clean\n",
+            (double)soak.io_dev_mean[1], (double)soak.io_dev_mean[0]);
+    }
+    if(host_counters.io_near_dwells > 3ULL * DECIM_FACTOR * soak.io_tagged_samples) failures++;
+
+    if(soak.battery_mah > 0.0) {
+        fprintf(soak.report, "\nBattery governor\n");
+        fprintf(soak.report, "  battery:              %.0f mAh, %.0f left", soak.battery_mah, soak.remaining_mah);
+        if(soak.empty_us) {
+            fprintf(soak.report, ", flat after %.1f h", (double)(soak.empty_us - soak.start_us) / HOUR_US);
+        }
+        fprintf(soak.report, "\n  tiers:                %u changes, lowest %s, ended %s\n",
+            soak.tier_changes, gov_tiers[soak.max_tier].name, gov_tiers[soak.tier].name);
+        if(soak.run_until >= 0) {
+            fprintf(soak.report, "  run until %02d:%02d:       %s", soak.run_until / 60, soak.run_until % 60,
+                soak.target_met ? "met" : "MISSED");
+            if(soak.target_met) fprintf(soak.report, " with %u%% left", soak.target_met_pct);
+            fprintf(soak.report, "\n");
+            if(!soak.target_met) failures++;
+        }
+    }
+
+    fprintf(soak.report, "\nAccumulation\n");
+    const char* names[3] = {"LF ", "HF ", "UHF"};
+    for(int i = 0; i < 3; i++) {
+        double mean_error = soak.max_sum_error[i] / BUFFER_SIZE;
+        fprintf(soak.report, "  %s running sum: max error %.6f (%.2e dB on the average)\n",
+            names[i], soak.max_sum_error[i], mean_error);
+        if(mean_error > DRIFT_LIMIT_DB) failures++;
+    }
+    fprintf(soak.report, "  time windows:         %lu checks, %lu sum mismatches, %lu wrong spans\n",
+        (unsigned long)soak.window_checks, (unsigned long)soak.window_sum_errors,
+        (unsigned long)soak.window_span_errors);
+    if(soak.window_sum_errors || soak.window_span_errors) failures++;
+    fprintf(soak.report, "  paged windows:        %lu checks, %lu sum mismatches\n",
+        (unsigned long)soak.long_checks, (unsigned long)soak.long_sum_errors);
+    if(soak.long_sum_errors || soak.long_windows.failed) failures++;
+    fprintf(soak.report, "  total_samples:        %lu over %lu loop iterations (%lu skips or stalls)\n",
+        (unsigned long)soak.total_samples, (unsigned long)soak.waits,
+        (unsigned long)soak.sample_mismatches);
+    fprintf(soak.report, "  total_samples wraps:  after %.0f years at 1 Hz\n",
+        (double)UINT32_MAX / (86400.0 * 365.0));
+    if(soak.sample_mismatches) failures++;
+
+    /* Each window moves into a new page once per LONGWIN_PAGE_SAMPLES */
+    const LongWindows* lw = &soak.long_windows;
+    uint32_t read_limit = LONGWIN_COUNT * (lw->head / LONGWIN_PAGE_SAMPLES + 1);
+    fprintf(soak.report, "\nPaged windows\n");
+    fprintf(soak.report, "  samples:              %lu, ring %d pages of %zu bytes, %d in RAM\n",
+        (unsigned long)lw->head, LONGWIN_RING_PAGES, sizeof(LongPage), LONGWIN_CACHE_PAGES);
+    fprintf(soak.report, "  page reads:           %lu (limit %lu), %lu waited for\n",
+        (unsigned long)lw->page_reads, (unsigned long)read_limit, (unsigned long)lw->sync_reads);
+    fprintf(soak.report, "  page writes:          %lu (%lu on eviction)\n",
+        (unsigned long)lw->page_writes, (unsigned long)lw->sync_writes);
+    if(lw->page_reads > read_limit || lw->sync_reads || lw->sync_writes) failures++;
+
+    uint64_t loop_mallocs = soak.loop_malloc_calls - soak.steady_malloc_calls;
+    uint64_t loop_frees = soak.loop_free_calls - soak.steady_free_calls;
+
+#ifdef DEBUG_LOG_TO_SD
+    /* The RTC ticks throughout, so a full-second poll means a late wake stalled the loop */
+    fprintf(soak.report, "\nRTC anchor\n");
+    fprintf(soak.report, "  polls:                %lu, %lu full-second\n",
+        (unsigned long)soak.anchor_polls, (unsigned long)soak.anchor_full_polls);
+    if(soak.anchor_full_polls) failures++;
+
+#endif
+    fprintf(soak.report, "\nMemory\n");
+    fprintf(soak.report, "  session arena:        %lu bytes in one block (%lu carved)\n",
+        (unsigned long)soak.arena_size, (unsigned long)soak.arena_used);
+    fprintf(soak.report, "  heap ops in loop:     %lu mallocs, %lu frees, %+ld bytes\n",
+        (unsigned long)loop_mallocs, (unsigned long)loop_frees,
+        (long)(soak.loop_heap_bytes - soak.steady_heap_bytes));
+    if(soak.arena_used != soak.arena_size) failures++;
+    if(loop_mallocs || loop_frees || soak.loop_heap_bytes != soak.steady_heap_bytes) failures++;
+    fprintf(soak.report, "  mallocs after start:  %lu\n",
+        (unsigned long)(host_counters.malloc_calls - soak.steady_malloc_calls));
+    fprintf(soak.report, "  heap at loop start:   %ld bytes (peak %ld)\n",
+        (long)soak.steady_heap_bytes, (long)host_counters.heap_peak_bytes);
+    fprintf(soak.report, "  heap after exit:      %ld bytes\n", (long)host_counters.heap_live_bytes);
+    if(host_counters.malloc_calls != soak.steady_malloc_calls) failures++;
+    if(host_counters.heap_live_bytes != 0) failures++;
+
+    fprintf(soak.report, "\n%s\n", failures ? "SOAK FAILED" : "SOAK PASSED");
+
+    if(soak.json) {
+        printf("{\"app\": \"reality-clock\", \"days\": %.1f, \"wall_s\": %.4f, \"samples\": %lu, "
+               "\"samples_per_s\": %.1f, \"radio_dwells\": %lu, \"heap_peak_bytes\": %ld, "
+               "\"mallocs_after_start\": %lu, \"arena_bytes\": %lu, \"passed\": %s}\n",
+            soak.days, wall_s, (unsigned long)soak.total_samples,
+            wall_s > 0 ? (double)soak.total_samples / wall_s : 0.0,
+            (unsigned long)host_counters.radio_dwells, (long)host_counters.heap_peak_bytes,
+            (unsigned long)(host_counters.malloc_calls - soak.steady_malloc_calls),
+            (unsigned long)soak.arena_size, failures ? "false" : "true");
+    }
+    return failures ? 1 : 0;
+}